@@ -0,0 +1,136 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Measures how the event handler copes with many sockets at once. Run it
+// with different --event-handler-threads values to compare the shards, and
+// with and without --use-io-uring to compare waiting on an io_uring, which
+// batches the epoll_ctl calls of a loop iteration, with epoll_wait:
+//
+//   dart --event-handler-threads=4 EventHandlerConnections.dart
+//   dart --use-io-uring EventHandlerConnections.dart
+//
+// A server isolate echoes everything it receives. Several client isolates
+// each keep many connections busy, so events for many descriptors arrive at
+// the same time from several isolates.
+//
+// EventHandlerConnect: connect, echo one message and close, per connection.
+// EventHandlerEcho: one message round trip on an already open connection.
+
+import "dart:async";
+import "dart:io";
+import "dart:isolate";
+import "dart:typed_data";
+
+const int clientIsolates = 4;
+const int connectionsPerIsolate = 128;
+const int connectRounds = 8;
+const int echoRounds = 64;
+const int messageSize = 256;
+
+Future<void> server(SendPort portReply) async {
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((Socket socket) {
+    socket.setOption(SocketOption.tcpNoDelay, true);
+    socket.listen(socket.add, onDone: socket.close);
+  });
+  final shutdown = new ReceivePort();
+  portReply.send(<Object>[server.port, shutdown.sendPort]);
+  await shutdown.first;
+  await server.close();
+}
+
+// Reads messageSize bytes echoed back on [socket] for each [send] call.
+class EchoClient {
+  final Socket socket;
+  final Uint8List message = new Uint8List(messageSize);
+  final StreamIterator<Uint8List> input;
+  int buffered = 0;
+
+  EchoClient(Socket socket)
+      : socket = socket,
+        input = new StreamIterator<Uint8List>(socket) {
+    socket.setOption(SocketOption.tcpNoDelay, true);
+  }
+
+  Future<void> roundTrip() async {
+    socket.add(message);
+    while (buffered < messageSize) {
+      if (!await input.moveNext()) {
+        throw "Connection closed before the echo arrived";
+      }
+      buffered += input.current.length;
+    }
+    buffered -= messageSize;
+  }
+
+  Future<void> close() async {
+    await socket.close();
+    await input.cancel();
+  }
+}
+
+Future<void> connectOnce(int port) async {
+  final client =
+      new EchoClient(await Socket.connect(InternetAddress.loopbackIPv4, port));
+  await client.roundTrip();
+  await client.close();
+}
+
+// Runs the benchmarks for one client isolate and replies with the time
+// spent on each of them in microseconds.
+Future<void> client(List<Object> args) async {
+  final int port = args[0];
+  final SendPort portReply = args[1];
+  final watch = new Stopwatch()..start();
+  for (int i = 0; i < connectRounds; i++) {
+    await Future.wait(new List<Future<void>>.generate(
+        connectionsPerIsolate, (_) => connectOnce(port)));
+  }
+  final int connectMicros = watch.elapsedMicroseconds;
+
+  final clients = <EchoClient>[];
+  for (int i = 0; i < connectionsPerIsolate; i++) {
+    clients.add(new EchoClient(
+        await Socket.connect(InternetAddress.loopbackIPv4, port)));
+  }
+  watch.reset();
+  await Future.wait(clients.map((EchoClient client) async {
+    for (int i = 0; i < echoRounds; i++) {
+      await client.roundTrip();
+    }
+  }));
+  final int echoMicros = watch.elapsedMicroseconds;
+  await Future.wait(clients.map((EchoClient client) => client.close()));
+  portReply.send(<int>[connectMicros, echoMicros]);
+}
+
+void report(String name, int micros, int operations) {
+  print("$name(RunTime): ${micros / operations} us.");
+}
+
+main() async {
+  final serverReply = new ReceivePort();
+  await Isolate.spawn(server, serverReply.sendPort);
+  final List<Object> serverInfo = await serverReply.first;
+  final int port = serverInfo[0];
+  final SendPort shutdown = serverInfo[1];
+
+  final clientReplies = new ReceivePort();
+  for (int i = 0; i < clientIsolates; i++) {
+    await Isolate.spawn(client, <Object>[port, clientReplies.sendPort]);
+  }
+  int connectMicros = 0;
+  int echoMicros = 0;
+  await for (List<int> times in clientReplies.take(clientIsolates)) {
+    connectMicros = times[0] > connectMicros ? times[0] : connectMicros;
+    echoMicros = times[1] > echoMicros ? times[1] : echoMicros;
+  }
+  shutdown.send(null);
+
+  // The isolates run at the same time, so each operation took the time of
+  // the slowest isolate divided by the operations of all of them.
+  const int connections = clientIsolates * connectionsPerIsolate;
+  report("EventHandlerConnect", connectMicros, connections * connectRounds);
+  report("EventHandlerEcho", echoMicros, connections * echoRounds);
+}
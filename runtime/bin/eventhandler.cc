@@ -55,6 +55,9 @@ void TimeoutQueue::UpdateTimeout(Dart_Port port, int64_t timeout) {
   }
 }
 
+intptr_t EventHandler::thread_count_ = 1;
+bool EventHandler::use_io_uring_ = false;
+
 static EventHandler* event_handler = NULL;
 static Monitor* shutdown_monitor = NULL;
 
@@ -643,10 +643,34 @@ class EventHandler {
 
   static void SendFromNative(intptr_t id, Dart_Port port, int64_t data);
 
+  /**
+   * The number of threads polling for events on platforms where the
+   * event-handler can use more than one. Must be set before Start().
+   */
+  static intptr_t thread_count() { return thread_count_; }
+  static void set_thread_count(intptr_t thread_count) {
+    thread_count_ = thread_count;
+  }
+
+  static const intptr_t kMaxThreadCount = 64;
+
+  /**
+   * Whether the event-handler should wait for events with io_uring on Linux.
+   * It falls back to epoll if the kernel does not support io_uring. Must be
+   * set before Start().
+   */
+  static bool use_io_uring() { return use_io_uring_; }
+  static void set_use_io_uring(bool use_io_uring) {
+    use_io_uring_ = use_io_uring;
+  }
+
  private:
   friend class EventHandlerImplementation;
   EventHandlerImplementation delegate_;
 
+  static intptr_t thread_count_;
+  static bool use_io_uring_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandler);
 };
 
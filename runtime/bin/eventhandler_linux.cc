@@ -10,6 +10,7 @@
 
 #include <errno.h>        // NOLINT
 #include <fcntl.h>        // NOLINT
+#include <poll.h>         // NOLINT
 #include <pthread.h>      // NOLINT
 #include <stdio.h>        // NOLINT
 #include <string.h>       // NOLINT
@@ -23,6 +24,7 @@
 #include "bin/lockers.h"
 #include "bin/socket.h"
 #include "bin/thread.h"
+#include "platform/atomic.h"
 #include "platform/syslog.h"
 #include "platform/utils.h"
 
@@ -48,12 +50,17 @@ static void RemoveFromEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
   VOID_NO_RETRY_EXPECTED(epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, di->fd(), NULL));
 }
 
-static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
-  struct epoll_event event;
-  event.events = EPOLLRDHUP | di->GetPollEvents();
+static uint32_t GetEpollEvents(DescriptorInfo* di) {
+  uint32_t events = EPOLLRDHUP | di->GetPollEvents();
   if (!di->IsListeningSocket()) {
-    event.events |= EPOLLET;
+    events |= EPOLLET;
   }
+  return events;
+}
+
+static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
+  struct epoll_event event;
+  event.events = GetEpollEvents(di);
   event.data.ptr = di;
   int status =
       NO_RETRY_EXPECTED(epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, di->fd(), &event));
@@ -68,8 +75,19 @@ static void AddToEpollInstance(intptr_t epoll_fd_, DescriptorInfo* di) {
   }
 }
 
-EventHandlerImplementation::EventHandlerImplementation()
-    : socket_map_(&SimpleHashMap::SamePointerValue, 16) {
+EventHandlerShard::EventHandlerShard(EventHandlerImplementation* owner,
+                                     intptr_t index)
+    : owner_(owner),
+      index_(index),
+      socket_map_(&SimpleHashMap::SamePointerValue, 16),
+      timer_fd_(-1),
+      ring_(NULL),
+      pending_updates_(NULL),
+      updates_in_flight_(0),
+      timeout_sequence_(0),
+      timeout_armed_(false),
+      epoll_ready_(false),
+      interrupt_ready_(false) {
   intptr_t result;
   result = NO_RETRY_EXPECTED(pipe(interrupt_fds_));
   if (result != 0) {
@@ -95,6 +113,15 @@ EventHandlerImplementation::EventHandlerImplementation()
   if (!FDUtils::SetCloseOnExec(epoll_fd_)) {
     FATAL("Failed to set epoll fd close on exec\n");
   }
+  if (EventHandler::use_io_uring()) {
+    // Falls back to epoll_wait if io_uring is not available.
+    ring_ = IOUring::New(kRingEntries);
+    if (ring_ != NULL) {
+      // The interrupt fd and the epoll instance are polled by the ring, and
+      // timers are ring timeouts.
+      return;
+    }
+  }
   // Register the interrupt_fd with the epoll instance.
   struct epoll_event event;
   event.events = EPOLLIN;
@@ -125,17 +152,26 @@ static void DeleteDescriptorInfo(void* info) {
   delete di;
 }
 
-EventHandlerImplementation::~EventHandlerImplementation() {
+EventHandlerShard::~EventHandlerShard() {
+  delete ring_;
   socket_map_.Clear(DeleteDescriptorInfo);
   close(epoll_fd_);
-  close(timer_fd_);
+  if (timer_fd_ != -1) {
+    close(timer_fd_);
+  }
   close(interrupt_fds_[0]);
   close(interrupt_fds_[1]);
 }
 
-void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
-                                                     DescriptorInfo* di) {
+void EventHandlerShard::UpdateEpollInstance(intptr_t old_mask,
+                                            DescriptorInfo* di) {
   intptr_t new_mask = di->Mask();
+  if (ring_ != NULL) {
+    if (old_mask != new_mask) {
+      QueueEpollUpdate(di);
+    }
+    return;
+  }
   if ((old_mask != 0) && (new_mask == 0)) {
     RemoveFromEpollInstance(epoll_fd_, di);
   } else if ((old_mask == 0) && (new_mask != 0)) {
@@ -147,9 +183,8 @@ void EventHandlerImplementation::UpdateEpollInstance(intptr_t old_mask,
   }
 }
 
-DescriptorInfo* EventHandlerImplementation::GetDescriptorInfo(
-    intptr_t fd,
-    bool is_listening) {
+DescriptorInfo* EventHandlerShard::GetDescriptorInfo(intptr_t fd,
+                                                     bool is_listening) {
   ASSERT(fd >= 0);
   SimpleHashMap::Entry* entry = socket_map_.Lookup(
       GetHashmapKeyFromFd(fd), GetHashmapHashFromFd(fd), true);
@@ -169,9 +204,9 @@ DescriptorInfo* EventHandlerImplementation::GetDescriptorInfo(
   return di;
 }
 
-void EventHandlerImplementation::WakeupHandler(intptr_t id,
-                                               Dart_Port dart_port,
-                                               int64_t data) {
+void EventHandlerShard::WakeupHandler(intptr_t id,
+                                      Dart_Port dart_port,
+                                      int64_t data) {
   InterruptMessage msg;
   msg.id = id;
   msg.dart_port = dart_port;
@@ -190,7 +225,7 @@ void EventHandlerImplementation::WakeupHandler(intptr_t id,
   }
 }
 
-void EventHandlerImplementation::HandleInterruptFd() {
+void EventHandlerShard::HandleInterruptFd() {
   const intptr_t MAX_MESSAGES = kInterruptMessageSize;
   InterruptMessage msg[MAX_MESSAGES];
   ssize_t bytes = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
@@ -242,17 +277,12 @@ void EventHandlerImplementation::HandleInterruptFd() {
 
           if (registry->CloseSafe(socket)) {
             ASSERT(new_mask == 0);
-            socket_map_.Remove(GetHashmapKeyFromFd(fd),
-                               GetHashmapHashFromFd(fd));
-            di->Close();
-            delete di;
+            RemoveDescriptorInfo(di);
             socket->SetClosedFd();
           }
         } else {
           ASSERT(new_mask == 0);
-          socket_map_.Remove(GetHashmapKeyFromFd(fd), GetHashmapHashFromFd(fd));
-          di->Close();
-          delete di;
+          RemoveDescriptorInfo(di);
           socket->SetClosedFd();
         }
         DartUtils::PostInt32(port, 1 << kDestroyedEvent);
@@ -276,7 +306,35 @@ void EventHandlerImplementation::HandleInterruptFd() {
   }
 }
 
-void EventHandlerImplementation::UpdateTimerFd() {
+void EventHandlerShard::RemoveDescriptorInfo(DescriptorInfo* di) {
+  const intptr_t fd = di->fd();
+  if (ring_ != NULL) {
+    // The file descriptor has to leave the epoll instance before it is closed
+    // and its number reused, so the update cannot wait for the next batch.
+    UnqueueEpollUpdate(di);
+    WaitForEpollUpdates();
+    if (di->is_registered()) {
+      RemoveFromEpollInstance(epoll_fd_, di);
+    }
+  }
+  socket_map_.Remove(GetHashmapKeyFromFd(fd), GetHashmapHashFromFd(fd));
+  di->Close();
+  delete di;
+}
+
+void EventHandlerShard::HandleTimeout() {
+  if (timeout_queue_.HasTimeout()) {
+    DartUtils::PostNull(timeout_queue_.CurrentPort());
+    timeout_queue_.RemoveCurrent();
+  }
+  UpdateTimerFd();
+}
+
+void EventHandlerShard::UpdateTimerFd() {
+  if (ring_ != NULL) {
+    UpdateRingTimeout();
+    return;
+  }
   struct itimerspec it;
   memset(&it, 0, sizeof(it));
   if (timeout_queue_.HasTimeout()) {
@@ -320,8 +378,8 @@ static void PrintEventMask(intptr_t fd, intptr_t events) {
 }
 #endif
 
-intptr_t EventHandlerImplementation::GetPollEvents(intptr_t events,
-                                                   DescriptorInfo* di) {
+intptr_t EventHandlerShard::GetPollEvents(intptr_t events,
+                                          DescriptorInfo* di) {
 #ifdef DEBUG_POLL
   PrintEventMask(di->fd(), events);
 #endif
@@ -342,8 +400,7 @@ intptr_t EventHandlerImplementation::GetPollEvents(intptr_t events,
   return event_mask;
 }
 
-void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
-                                              int size) {
+void EventHandlerShard::HandleEvents(struct epoll_event* events, int size) {
   bool interrupt_seen = false;
   for (int i = 0; i < size; i++) {
     if (events[i].data.ptr == NULL) {
@@ -352,11 +409,7 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
       int64_t val;
       VOID_TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
           read(timer_fd_, &val, sizeof(val)));
-      if (timeout_queue_.HasTimeout()) {
-        DartUtils::PostNull(timeout_queue_.CurrentPort());
-        timeout_queue_.RemoveCurrent();
-      }
-      UpdateTimerFd();
+      HandleTimeout();
     } else {
       DescriptorInfo* di =
           reinterpret_cast<DescriptorInfo*>(events[i].data.ptr);
@@ -380,55 +433,334 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
   }
 }
 
-void EventHandlerImplementation::Poll(uword args) {
+void EventHandlerShard::Poll(uword args) {
   ThreadSignalBlocker signal_blocker(SIGPROF);
-  static const intptr_t kMaxEvents = 16;
   struct epoll_event events[kMaxEvents];
-  EventHandler* handler = reinterpret_cast<EventHandler*>(args);
-  EventHandlerImplementation* handler_impl = &handler->delegate_;
-  ASSERT(handler_impl != NULL);
+  EventHandlerShard* shard = reinterpret_cast<EventHandlerShard*>(args);
+  ASSERT(shard != NULL);
 
-  while (!handler_impl->shutdown_) {
+  if (shard->ring_ != NULL) {
+    shard->PollWithRing(events);
+    shard->owner_->NotifyShardShutdownDone();
+    return;
+  }
+  while (!shard->shutdown_) {
     intptr_t result = TEMP_FAILURE_RETRY_NO_SIGNAL_BLOCKER(
-        epoll_wait(handler_impl->epoll_fd_, events, kMaxEvents, -1));
+        epoll_wait(shard->epoll_fd_, events, kMaxEvents, -1));
     ASSERT(EAGAIN == EWOULDBLOCK);
     if (result <= 0) {
       if (errno != EWOULDBLOCK) {
         perror("Poll failed");
       }
     } else {
-      handler_impl->HandleEvents(events, result);
+      shard->HandleEvents(events, result);
     }
   }
-  DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
-  handler->NotifyShutdownDone();
+  shard->owner_->NotifyShardShutdownDone();
 }
 
-void EventHandlerImplementation::Start(EventHandler* handler) {
-  int result =
-      Thread::Start("dart:io EventHandler", &EventHandlerImplementation::Poll,
-                    reinterpret_cast<uword>(handler));
+// The kind of operation a completion of the ring belongs to is stored in the
+// low bits of its user data.
+enum RingOperation {
+  kRingIgnored = 0,
+  kRingEpollReady = 1,
+  kRingInterrupt = 2,
+  kRingTimeout = 3,
+  kRingEpollUpdate = 4,
+};
+static const intptr_t kRingOperationBits = 3;
+static const uint64_t kRingOperationMask = (1 << kRingOperationBits) - 1;
+
+static uint64_t RingUserData(RingOperation operation, uint64_t payload) {
+  return (payload << kRingOperationBits) | operation;
+}
+
+// The epoll_ctl operation of an update is stored below its file descriptor.
+static const intptr_t kEpollOpBits = 2;
+COMPILE_ASSERT(EPOLL_CTL_MOD < (1 << kEpollOpBits));
+
+IOUring::SubmissionEntry* EventHandlerShard::NextSubmission() {
+  IOUring::SubmissionEntry* entry = ring_->NextSubmission();
+  if (entry == NULL) {
+    // Make room by passing the queued entries to the kernel.
+    if (!ring_->Submit(0)) {
+      FATAL1("Failed submitting to io_uring: %i", errno);
+    }
+    entry = ring_->NextSubmission();
+    if (entry == NULL) {
+      FATAL("io_uring submission queue is full");
+    }
+  }
+  return entry;
+}
+
+void EventHandlerShard::ArmPoll(int fd, uint64_t user_data) {
+  IOUring::SubmissionEntry* entry = NextSubmission();
+  entry->opcode = IOUring::kPollAdd;
+  entry->fd = fd;
+  entry->op_flags = POLLIN;
+  entry->user_data = user_data;
+}
+
+void EventHandlerShard::UpdateRingTimeout() {
+  if (timeout_armed_) {
+    IOUring::SubmissionEntry* entry = NextSubmission();
+    entry->opcode = IOUring::kTimeoutRemove;
+    entry->addr = RingUserData(kRingTimeout, timeout_sequence_);
+    entry->user_data = RingUserData(kRingIgnored, 0);
+    timeout_armed_ = false;
+  }
+  // Completions of earlier timeouts are ignored.
+  timeout_sequence_++;
+  if (!timeout_queue_.HasTimeout()) {
+    return;
+  }
+  int64_t millis = timeout_queue_.CurrentTimeout();
+  timeout_spec_.tv_sec = millis / 1000;
+  timeout_spec_.tv_nsec = (millis % 1000) * 1000000;
+  IOUring::SubmissionEntry* entry = NextSubmission();
+  entry->opcode = IOUring::kTimeout;
+  entry->addr = reinterpret_cast<uint64_t>(&timeout_spec_);
+  entry->len = 1;
+  entry->op_flags = IOUring::kTimeoutAbsolute;
+  entry->user_data = RingUserData(kRingTimeout, timeout_sequence_);
+  timeout_armed_ = true;
+}
+
+void EventHandlerShard::QueueEpollUpdate(DescriptorInfo* di) {
+  if (di->has_pending_update()) {
+    return;
+  }
+  di->set_has_pending_update(true);
+  di->set_next_pending_update(pending_updates_);
+  pending_updates_ = di;
+}
+
+void EventHandlerShard::UnqueueEpollUpdate(DescriptorInfo* di) {
+  if (!di->has_pending_update()) {
+    return;
+  }
+  if (pending_updates_ == di) {
+    pending_updates_ = di->next_pending_update();
+  } else {
+    DescriptorInfo* previous = pending_updates_;
+    while (previous->next_pending_update() != di) {
+      previous = previous->next_pending_update();
+    }
+    previous->set_next_pending_update(di->next_pending_update());
+  }
+  di->set_next_pending_update(NULL);
+  di->set_has_pending_update(false);
+}
+
+void EventHandlerShard::SubmitEpollUpdates() {
+  // Updates of a file descriptor must not overtake each other, and the
+  // events of the last batch must stay alive until it has been submitted.
+  ASSERT(updates_in_flight_ == 0);
+  intptr_t count = 0;
+  while ((pending_updates_ != NULL) && (count < kMaxEvents)) {
+    DescriptorInfo* di = pending_updates_;
+    pending_updates_ = di->next_pending_update();
+    di->set_next_pending_update(NULL);
+    di->set_has_pending_update(false);
+
+    // Several changes of the mask since the last batch result in a single
+    // update.
+    intptr_t op;
+    if (di->Mask() == 0) {
+      if (!di->is_registered()) {
+        continue;
+      }
+      op = EPOLL_CTL_DEL;
+      di->set_is_registered(false);
+    } else {
+      op = di->is_registered() ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+      di->set_is_registered(true);
+    }
+    struct epoll_event* event = &update_events_[count++];
+    event->events = GetEpollEvents(di);
+    event->data.ptr = di;
+    IOUring::SubmissionEntry* entry = NextSubmission();
+    entry->opcode = IOUring::kEpollCtl;
+    entry->fd = epoll_fd_;
+    entry->addr = reinterpret_cast<uint64_t>(event);
+    entry->len = op;
+    entry->off = di->fd();
+    entry->user_data =
+        RingUserData(kRingEpollUpdate, (di->fd() << kEpollOpBits) | op);
+    updates_in_flight_++;
+  }
+}
+
+void EventHandlerShard::WaitForEpollUpdates() {
+  while (updates_in_flight_ > 0) {
+    if (!ring_->Submit(1)) {
+      FATAL1("Failed waiting for io_uring: %i", errno);
+    }
+    ProcessCompletions();
+  }
+}
+
+void EventHandlerShard::HandleFailedEpollUpdate(intptr_t fd, intptr_t op) {
+  if (op != EPOLL_CTL_ADD) {
+    return;
+  }
+  SimpleHashMap::Entry* entry = socket_map_.Lookup(
+      GetHashmapKeyFromFd(fd), GetHashmapHashFromFd(fd), false);
+  if (entry == NULL) {
+    return;
+  }
+  // Same as a failure of AddToEpollInstance.
+  DescriptorInfo* di = reinterpret_cast<DescriptorInfo*>(entry->value);
+  di->set_is_registered(false);
+  di->NotifyAllDartPorts(1 << kCloseEvent);
+}
+
+void EventHandlerShard::ProcessCompletions() {
+  for (IOUring::CompletionEntry* completion = ring_->PeekCompletion();
+       completion != NULL; completion = ring_->PeekCompletion()) {
+    const uint64_t user_data = completion->user_data;
+    const int32_t result = completion->res;
+    ring_->ConsumeCompletion();
+    const uint64_t payload = user_data >> kRingOperationBits;
+    switch (user_data & kRingOperationMask) {
+      case kRingEpollReady:
+        epoll_ready_ = true;
+        break;
+      case kRingInterrupt:
+        interrupt_ready_ = true;
+        break;
+      case kRingTimeout:
+        if ((payload == timeout_sequence_) && (result == -ETIME)) {
+          timeout_armed_ = false;
+          HandleTimeout();
+        }
+        break;
+      case kRingEpollUpdate:
+        updates_in_flight_--;
+        if (result < 0) {
+          HandleFailedEpollUpdate(payload >> kEpollOpBits,
+                                  payload & ((1 << kEpollOpBits) - 1));
+        }
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+void EventHandlerShard::PollWithRing(struct epoll_event* events) {
+  ArmPoll(interrupt_fds_[0], RingUserData(kRingInterrupt, 0));
+  ArmPoll(epoll_fd_, RingUserData(kRingEpollReady, 0));
+  while (!shutdown_) {
+    if (pending_updates_ != NULL) {
+      WaitForEpollUpdates();
+      SubmitEpollUpdates();
+    }
+    // Submits the updates, timeouts and polls queued since the last
+    // iteration and waits for the next completion in one system call.
+    if (!ring_->Submit(1)) {
+      FATAL1("Failed waiting for io_uring: %i", errno);
+    }
+    ProcessCompletions();
+    if (epoll_ready_) {
+      epoll_ready_ = false;
+      intptr_t result =
+          NO_RETRY_EXPECTED(epoll_wait(epoll_fd_, events, kMaxEvents, 0));
+      if (result > 0) {
+        HandleEvents(events, result);
+      }
+      ArmPoll(epoll_fd_, RingUserData(kRingEpollReady, 0));
+    }
+    // Handle after socket events, so we avoid closing a socket before we
+    // handle the current events.
+    if (interrupt_ready_) {
+      interrupt_ready_ = false;
+      HandleInterruptFd();
+      ArmPoll(interrupt_fds_[0], RingUserData(kRingInterrupt, 0));
+    }
+  }
+}
+
+void EventHandlerShard::Start() {
+  int result = Thread::Start("dart:io EventHandler", &EventHandlerShard::Poll,
+                             reinterpret_cast<uword>(this));
   if (result != 0) {
     FATAL1("Failed to start event handler thread %d", result);
   }
 }
 
+EventHandlerImplementation::EventHandlerImplementation()
+    : handler_(NULL), shards_(NULL), num_shards_(0), running_shards_(0) {
+  num_shards_ = EventHandler::thread_count();
+  ASSERT(num_shards_ > 0);
+  shards_ = new EventHandlerShard*[num_shards_];
+  for (intptr_t i = 0; i < num_shards_; i++) {
+    shards_[i] = new EventHandlerShard(this, i);
+  }
+}
+
+EventHandlerImplementation::~EventHandlerImplementation() {
+  for (intptr_t i = 0; i < num_shards_; i++) {
+    delete shards_[i];
+  }
+  delete[] shards_;
+}
+
+EventHandlerShard* EventHandlerImplementation::ShardForFd(intptr_t fd) const {
+  // Messages for sockets that are already closed are dropped by any shard.
+  if (fd < 0) {
+    return shards_[0];
+  }
+  return shards_[fd % num_shards_];
+}
+
+EventHandlerShard* EventHandlerImplementation::ShardForPort(
+    Dart_Port port) const {
+  const uint32_t hash = dart::Utils::WordHash(static_cast<intptr_t>(port));
+  return shards_[hash % num_shards_];
+}
+
+void EventHandlerImplementation::NotifyShardShutdownDone() {
+  if (AtomicOperations::FetchAndDecrement(&running_shards_) == 1) {
+    DEBUG_ASSERT(ReferenceCounted<Socket>::instances() == 0);
+    handler_->NotifyShutdownDone();
+  }
+}
+
+void EventHandlerImplementation::Start(EventHandler* handler) {
+  handler_ = handler;
+  running_shards_ = num_shards_;
+  for (intptr_t i = 0; i < num_shards_; i++) {
+    shards_[i]->Start();
+  }
+}
+
 void EventHandlerImplementation::Shutdown() {
-  SendData(kShutdownId, 0, 0);
+  for (intptr_t i = 0; i < num_shards_; i++) {
+    shards_[i]->WakeupHandler(kShutdownId, 0, 0);
+  }
 }
 
 void EventHandlerImplementation::SendData(intptr_t id,
                                           Dart_Port dart_port,
                                           int64_t data) {
-  WakeupHandler(id, dart_port, data);
+  EventHandlerShard* shard;
+  if (id == kTimerId) {
+    shard = ShardForPort(dart_port);
+  } else {
+    ASSERT(id != kShutdownId);
+    shard = ShardForFd(reinterpret_cast<Socket*>(id)->fd());
+  }
+  shard->WakeupHandler(id, dart_port, data);
 }
 
-void* EventHandlerImplementation::GetHashmapKeyFromFd(intptr_t fd) {
+void* EventHandlerShard::GetHashmapKeyFromFd(intptr_t fd) {
   // The hashmap does not support keys with value 0.
   return reinterpret_cast<void*>(fd + 1);
 }
 
-uint32_t EventHandlerImplementation::GetHashmapHashFromFd(intptr_t fd) {
+uint32_t EventHandlerShard::GetHashmapHashFromFd(intptr_t fd) {
   // The hashmap does not support keys with value 0.
   return dart::Utils::WordHash(fd + 1);
 }
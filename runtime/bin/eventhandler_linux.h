@@ -14,6 +14,7 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include "bin/io_uring_linux.h"
 #include "platform/hashmap.h"
 #include "platform/signal_blocker.h"
 
@@ -22,7 +23,11 @@ namespace bin {
 
 class DescriptorInfo : public DescriptorInfoBase {
  public:
-  explicit DescriptorInfo(intptr_t fd) : DescriptorInfoBase(fd) {}
+  explicit DescriptorInfo(intptr_t fd)
+      : DescriptorInfoBase(fd),
+        is_registered_(false),
+        has_pending_update_(false),
+        next_pending_update_(NULL) {}
 
   virtual ~DescriptorInfo() {}
 
@@ -33,7 +38,25 @@ class DescriptorInfo : public DescriptorInfoBase {
     fd_ = -1;
   }
 
+  // The state of the epoll registration when it is updated through io_uring.
+  // Updates are queued on a list and submitted in batches, see
+  // EventHandlerShard::QueueEpollUpdate.
+  bool is_registered() const { return is_registered_; }
+  void set_is_registered(bool value) { is_registered_ = value; }
+  bool has_pending_update() const { return has_pending_update_; }
+  void set_has_pending_update(bool value) { has_pending_update_ = value; }
+  DescriptorInfo* next_pending_update() const {
+    return next_pending_update_;
+  }
+  void set_next_pending_update(DescriptorInfo* next) {
+    next_pending_update_ = next;
+  }
+
  private:
+  bool is_registered_;
+  bool has_pending_update_;
+  DescriptorInfo* next_pending_update_;
+
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfo);
 };
 
@@ -58,31 +81,62 @@ class DescriptorInfoMultiple
   DISALLOW_COPY_AND_ASSIGN(DescriptorInfoMultiple);
 };
 
-class EventHandlerImplementation {
+class EventHandlerImplementation;
+
+// One event loop of the event handler. Every shard runs on its own thread
+// with its own epoll instance, timer fd, interrupt pipe and timeout queue, and
+// owns the DescriptorInfos of the file descriptors assigned to it.
+//
+// With EventHandler::use_io_uring() the shard waits on an io_uring instead of
+// in epoll_wait. Readiness of sockets is still tracked by the epoll instance,
+// whose edge triggered events the token protocol of dart:io depends on, but
+// changes to it are submitted to the ring in batches together with the wait.
+// Timers are ring timeouts rather than a timer fd.
+class EventHandlerShard {
  public:
-  EventHandlerImplementation();
-  ~EventHandlerImplementation();
+  EventHandlerShard(EventHandlerImplementation* owner, intptr_t index);
+  ~EventHandlerShard();
 
   void UpdateEpollInstance(intptr_t old_mask, DescriptorInfo* di);
 
   // Gets the socket data structure for a given file
   // descriptor. Creates a new one if one is not found.
   DescriptorInfo* GetDescriptorInfo(intptr_t fd, bool is_listening);
-  void SendData(intptr_t id, Dart_Port dart_port, int64_t data);
-  void Start(EventHandler* handler);
-  void Shutdown();
+  void WakeupHandler(intptr_t id, Dart_Port dart_port, int64_t data);
+  void Start();
+
+  intptr_t index() const { return index_; }
+  bool uses_io_uring() const { return ring_ != NULL; }
+
+  // The number of events handled by one call to epoll_wait.
+  static const intptr_t kMaxEvents = 256;
 
  private:
   void HandleEvents(struct epoll_event* events, int size);
   static void Poll(uword args);
-  void WakeupHandler(intptr_t id, Dart_Port dart_port, int64_t data);
   void HandleInterruptFd();
+  void HandleTimeout();
   void UpdateTimerFd();
-  void SetPort(intptr_t fd, Dart_Port dart_port, intptr_t mask);
+  void RemoveDescriptorInfo(DescriptorInfo* di);
   intptr_t GetPollEvents(intptr_t events, DescriptorInfo* di);
   static void* GetHashmapKeyFromFd(intptr_t fd);
   static uint32_t GetHashmapHashFromFd(intptr_t fd);
 
+  // Used with io_uring only.
+  static const uint32_t kRingEntries = 2 * kMaxEvents;
+  void PollWithRing(struct epoll_event* events);
+  IOUring::SubmissionEntry* NextSubmission();
+  void ArmPoll(int fd, uint64_t user_data);
+  void UpdateRingTimeout();
+  void QueueEpollUpdate(DescriptorInfo* di);
+  void UnqueueEpollUpdate(DescriptorInfo* di);
+  void SubmitEpollUpdates();
+  void WaitForEpollUpdates();
+  void HandleFailedEpollUpdate(intptr_t fd, intptr_t op);
+  void ProcessCompletions();
+
+  EventHandlerImplementation* owner_;
+  const intptr_t index_;
   SimpleHashMap socket_map_;
   TimeoutQueue timeout_queue_;
   bool shutdown_;
@@ -90,6 +144,52 @@ class EventHandlerImplementation {
   int epoll_fd_;
   int timer_fd_;
 
+  IOUring* ring_;
+  // Descriptors whose epoll registration has to be updated, and the updates
+  // submitted to the ring that have not completed yet. The events of
+  // submitted updates are read by the kernel when they are submitted.
+  DescriptorInfo* pending_updates_;
+  intptr_t updates_in_flight_;
+  struct epoll_event update_events_[kMaxEvents];
+  // The ring timeout for the first timer, identified by its sequence number.
+  IOUring::Timespec timeout_spec_;
+  uint64_t timeout_sequence_;
+  bool timeout_armed_;
+  bool epoll_ready_;
+  bool interrupt_ready_;
+
+  DISALLOW_COPY_AND_ASSIGN(EventHandlerShard);
+};
+
+// Distributes the file descriptors and timers of the process over
+// EventHandler::thread_count() shards. File descriptors are assigned to
+// shards by their number, so a file descriptor that is reused after a close
+// stays on the same shard. Timers are assigned by their port, which is shared
+// by all timers of an isolate.
+class EventHandlerImplementation {
+ public:
+  EventHandlerImplementation();
+  ~EventHandlerImplementation();
+
+  void SendData(intptr_t id, Dart_Port dart_port, int64_t data);
+  void Start(EventHandler* handler);
+  void Shutdown();
+
+ private:
+  friend class EventHandlerShard;
+
+  EventHandlerShard* ShardForFd(intptr_t fd) const;
+  EventHandlerShard* ShardForPort(Dart_Port port) const;
+
+  // Called by every shard when its thread exits. The last one to exit
+  // notifies the EventHandler.
+  void NotifyShardShutdownDone();
+
+  EventHandler* handler_;
+  EventHandlerShard** shards_;
+  intptr_t num_shards_;
+  intptr_t running_shards_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandlerImplementation);
 };
 
@@ -3,6 +3,18 @@
 // BSD-style license that can be found in the LICENSE file.
 
 #include "bin/eventhandler.h"
+
+#if defined(HOST_OS_LINUX)
+#include <stdlib.h>      // NOLINT
+#include <sys/socket.h>  // NOLINT
+#include <unistd.h>      // NOLINT
+
+#include "bin/lockers.h"
+#include "bin/socket.h"
+#include "bin/utils.h"
+#include "platform/syslog.h"
+#endif
+
 #include "platform/assert.h"
 #include "vm/unit_test.h"
 
@@ -79,5 +91,242 @@ VM_UNIT_TEST_CASE(CircularLinkedList) {
   list.Remove(4242);
 }
 
+#if defined(HOST_OS_LINUX)
+
+// Restarts the event handler, waiting with io_uring if [use_io_uring] is set,
+// and restarts it with the previous setting when it goes out of scope. The
+// event handler falls back to epoll if the kernel does not support io_uring.
+class EventHandlerRestartScope {
+ public:
+  explicit EventHandlerRestartScope(bool use_io_uring)
+      : saved_use_io_uring_(EventHandler::use_io_uring()) {
+    Restart(use_io_uring);
+    if (use_io_uring) {
+      IOUring* ring = IOUring::New(1);
+      if (ring == NULL) {
+        Syslog::PrintErr("io_uring is not available, testing epoll instead\n");
+      }
+      delete ring;
+    }
+  }
+
+  ~EventHandlerRestartScope() { Restart(saved_use_io_uring_); }
+
+ private:
+  static void Restart(bool use_io_uring) {
+    EventHandler::Stop();
+    EventHandler::set_use_io_uring(use_io_uring);
+    EventHandler::Start();
+  }
+
+  const bool saved_use_io_uring_;
+
+  DISALLOW_COPY_AND_ASSIGN(EventHandlerRestartScope);
+};
+
+// Collects the messages the event handler posts to a native port. Timer
+// messages are recorded as kTimerMessage, socket events as their event mask.
+class EventReceiver {
+ public:
+  static const int64_t kTimerMessage = -1;
+  static const int64_t kNoMessage = -2;
+
+  EventReceiver() : port_(ILLEGAL_PORT), count_(0) {
+    ASSERT(receiver_ == NULL);
+    receiver_ = this;
+    port_ = Dart_NewNativePort("EventReceiver", &HandleMessage, false);
+    EXPECT(port_ != ILLEGAL_PORT);
+  }
+
+  ~EventReceiver() {
+    EXPECT(Dart_CloseNativePort(port_));
+    receiver_ = NULL;
+  }
+
+  Dart_Port port() const { return port_; }
+
+  // Returns the next message, or kNoMessage if none arrives within
+  // [timeout_millis].
+  int64_t Next(int64_t timeout_millis = 10000) {
+    MonitorLocker ml(&monitor_);
+    const int64_t deadline =
+        TimerUtils::GetCurrentMonotonicMillis() + timeout_millis;
+    while (count_ == 0) {
+      const int64_t remaining =
+          deadline - TimerUtils::GetCurrentMonotonicMillis();
+      if (remaining <= 0) {
+        return kNoMessage;
+      }
+      ml.Wait(remaining);
+    }
+    const int64_t message = messages_[0];
+    count_--;
+    for (intptr_t i = 0; i < count_; i++) {
+      messages_[i] = messages_[i + 1];
+    }
+    return message;
+  }
+
+ private:
+  static const intptr_t kMaxMessages = 16;
+
+  static void HandleMessage(Dart_Port port, Dart_CObject* message) {
+    EventReceiver* receiver = receiver_;
+    MonitorLocker ml(&receiver->monitor_);
+    RELEASE_ASSERT(receiver->count_ < kMaxMessages);
+    int64_t value;
+    if (message->type == Dart_CObject_kNull) {
+      value = kTimerMessage;
+    } else if (message->type == Dart_CObject_kInt32) {
+      value = message->value.as_int32;
+    } else {
+      value = message->value.as_int64;
+    }
+    receiver->messages_[receiver->count_++] = value;
+    ml.Notify();
+  }
+
+  static EventReceiver* receiver_;
+
+  Dart_Port port_;
+  Monitor monitor_;
+  int64_t messages_[kMaxMessages];
+  intptr_t count_;
+
+  DISALLOW_COPY_AND_ASSIGN(EventReceiver);
+};
+
+EventReceiver* EventReceiver::receiver_ = NULL;
+
+static void SendSocketCommand(Socket* socket, Dart_Port port, int64_t data) {
+  // The event handler releases the socket when it has handled the command.
+  socket->Retain();
+  EventHandler::SendFromNative(reinterpret_cast<intptr_t>(socket), port,
+                               data);
+}
+
+static void Listen(Socket* socket, Dart_Port port) {
+  SendSocketCommand(socket, port,
+                    (1 << kSetEventMaskCommand) | (1 << kInEvent));
+}
+
+// Closes [socket] through the event handler, which closes its file
+// descriptor.
+static void CloseSocket(Socket* socket,
+                        Dart_Port port,
+                        EventReceiver* receiver) {
+  SendSocketCommand(socket, port, 1 << kCloseCommand);
+  EXPECT_EQ(1 << kDestroyedEvent, receiver->Next());
+  EXPECT_EQ(-1, socket->fd());
+  socket->Release();
+}
+
+static void TestTimers(bool use_io_uring) {
+  EventHandlerRestartScope restart(use_io_uring);
+  EventReceiver receiver;
+  const Dart_Port port = receiver.port();
+
+  // A timer replaced by a later one fires once, at the later time.
+  int64_t now = TimerUtils::GetCurrentMonotonicMillis();
+  EventHandler::SendFromNative(kTimerId, port, now + 10);
+  EventHandler::SendFromNative(kTimerId, port, now + 200);
+  EXPECT_EQ(EventReceiver::kNoMessage, receiver.Next(100));
+  EXPECT_EQ(EventReceiver::kTimerMessage, receiver.Next());
+  EXPECT_EQ(EventReceiver::kNoMessage, receiver.Next(300));
+
+  // A cancelled timer does not fire.
+  now = TimerUtils::GetCurrentMonotonicMillis();
+  EventHandler::SendFromNative(kTimerId, port, now + 10);
+  EventHandler::SendFromNative(kTimerId, port, -1);
+  EXPECT_EQ(EventReceiver::kNoMessage, receiver.Next(200));
+
+  // A timer that is already due fires right away.
+  now = TimerUtils::GetCurrentMonotonicMillis();
+  EventHandler::SendFromNative(kTimerId, port, now - 10);
+  EXPECT_EQ(EventReceiver::kTimerMessage, receiver.Next());
+}
+
+static void TestReuseClosedFd(bool use_io_uring) {
+  EventHandlerRestartScope restart(use_io_uring);
+  EventReceiver receiver;
+  const Dart_Port port = receiver.port();
+
+  int fds[2];
+  EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  Socket* socket = new Socket(fds[0]);
+  Listen(socket, port);
+  EXPECT_EQ(1, write(fds[1], "a", 1));
+  EXPECT_EQ(1 << kInEvent, receiver.Next());
+  const int fd = fds[0];
+  CloseSocket(socket, port, &receiver);
+  close(fds[1]);
+
+  // Give the number of the closed descriptor to a new socket. It must not
+  // still be registered with the epoll instance, or registering the new
+  // socket fails and the event handler reports it as closed.
+  EXPECT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  EXPECT_EQ(fd, dup2(fds[0], fd));
+  close(fds[0]);
+  socket = new Socket(fd);
+  Listen(socket, port);
+  EXPECT_EQ(1, write(fds[1], "b", 1));
+  EXPECT_EQ(1 << kInEvent, receiver.Next());
+  CloseSocket(socket, port, &receiver);
+  close(fds[1]);
+}
+
+static void TestRegularFileRejected(bool use_io_uring) {
+  EventHandlerRestartScope restart(use_io_uring);
+  EventReceiver receiver;
+  const Dart_Port port = receiver.port();
+
+  // epoll does not accept regular files, and the event handler reports them
+  // as closed.
+  char path[] = "/tmp/dart_eventhandler_test_XXXXXX";
+  const int fd = mkstemp(path);
+  EXPECT(fd >= 0);
+  EXPECT_EQ(0, unlink(path));
+  Socket* socket = new Socket(fd);
+  Listen(socket, port);
+  EXPECT_EQ(1 << kCloseEvent, receiver.Next());
+  CloseSocket(socket, port, &receiver);
+
+  // The event handler keeps working.
+  EventHandler::SendFromNative(kTimerId, port,
+                               TimerUtils::GetCurrentMonotonicMillis());
+  EXPECT_EQ(EventReceiver::kTimerMessage, receiver.Next());
+}
+
+#endif  // defined(HOST_OS_LINUX)
+
 }  // namespace bin
+
+#if defined(HOST_OS_LINUX)
+
+TEST_CASE(EventHandler_Timers) {
+  bin::TestTimers(false);
+}
+
+TEST_CASE(EventHandler_TimersWithIOUring) {
+  bin::TestTimers(true);
+}
+
+TEST_CASE(EventHandler_ReuseClosedFd) {
+  bin::TestReuseClosedFd(false);
+}
+
+TEST_CASE(EventHandler_ReuseClosedFdWithIOUring) {
+  bin::TestReuseClosedFd(true);
+}
+
+TEST_CASE(EventHandler_RegularFileRejected) {
+  bin::TestRegularFileRejected(false);
+}
+
+TEST_CASE(EventHandler_RegularFileRejectedWithIOUring) {
+  bin::TestRegularFileRejected(true);
+}
+
+#endif  // defined(HOST_OS_LINUX)
+
 }  // namespace dart
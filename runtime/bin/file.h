@@ -183,6 +183,10 @@ class File : public ReferenceCounted<File> {
   // (stdin, stout or stderr).
   static File* OpenStdio(int fd);
 
+  // Returns the file of a _RandomAccessFileOpsImpl object, or NULL if the
+  // file has been closed.
+  static File* GetFileNativeField(Dart_Handle file_obj);
+
   static bool Exists(Namespace* namespc, const char* path);
   static bool Create(Namespace* namespc, const char* path);
   static bool CreateLink(Namespace* namespc,
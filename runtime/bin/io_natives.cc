@@ -145,13 +145,15 @@ namespace bin {
   V(Socket_GetType, 1)                                                         \
   V(Socket_JoinMulticast, 4)                                                   \
   V(Socket_LeaveMulticast, 4)                                                  \
-  V(Socket_Read, 2)                                                            \
+  V(Socket_ReadInto, 4)                                                        \
   V(Socket_RecvFrom, 1)                                                        \
+  V(Socket_SendFile, 4)                                                        \
   V(Socket_SendTo, 6)                                                          \
   V(Socket_SetOption, 4)                                                       \
   V(Socket_SetRawOption, 4)                                                    \
   V(Socket_SetSocketId, 3)                                                     \
   V(Socket_WriteList, 4)                                                       \
+  V(Socket_WriteVector, 4)                                                     \
   V(Stdin_ReadByte, 1)                                                         \
   V(Stdin_GetEchoMode, 1)                                                      \
   V(Stdin_SetEchoMode, 2)                                                      \
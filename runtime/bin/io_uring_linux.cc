@@ -0,0 +1,273 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/globals.h"
+#if defined(HOST_OS_LINUX)
+
+#include "bin/io_uring_linux.h"
+
+#include <errno.h>        // NOLINT
+#include <string.h>       // NOLINT
+#include <sys/mman.h>     // NOLINT
+#include <sys/syscall.h>  // NOLINT
+#include <unistd.h>       // NOLINT
+
+#include "platform/atomic.h"
+#include "platform/utils.h"
+
+namespace dart {
+namespace bin {
+
+// The io_uring system calls have the same numbers on all architectures.
+static const long kSysIOUringSetup = 425;     // NOLINT
+static const long kSysIOUringEnter = 426;     // NOLINT
+static const long kSysIOUringRegister = 427;  // NOLINT
+
+// Offsets for mmap of the rings, IORING_OFF_*.
+static const off_t kSubmissionRingOffset = 0;
+static const off_t kCompletionRingOffset = 0x8000000;
+static const off_t kSubmissionEntriesOffset = 0x10000000;
+
+static const uint32_t kFeatureSingleMmap = 1 << 0;  // IORING_FEAT_SINGLE_MMAP
+static const uint32_t kEnterGetEvents = 1 << 0;     // IORING_ENTER_GETEVENTS
+static const uint32_t kRegisterProbe = 8;           // IORING_REGISTER_PROBE
+static const uint16_t kOpSupported = 1 << 0;        // IO_URING_OP_SUPPORTED
+
+// struct io_sqring_offsets.
+struct SubmissionRingOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t flags;
+  uint32_t dropped;
+  uint32_t array;
+  uint32_t resv1;
+  uint64_t resv2;
+};
+
+// struct io_cqring_offsets.
+struct CompletionRingOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t overflow;
+  uint32_t cqes;
+  uint32_t flags;
+  uint32_t resv1;
+  uint64_t resv2;
+};
+
+// struct io_uring_params.
+struct SetupParams {
+  uint32_t sq_entries;
+  uint32_t cq_entries;
+  uint32_t flags;
+  uint32_t sq_thread_cpu;
+  uint32_t sq_thread_idle;
+  uint32_t features;
+  uint32_t wq_fd;
+  uint32_t resv[3];
+  SubmissionRingOffsets sq_off;
+  CompletionRingOffsets cq_off;
+};
+
+// struct io_uring_probe with room for all operations.
+struct Probe {
+  static const intptr_t kMaxOps = 256;
+
+  struct Op {
+    uint8_t op;
+    uint8_t resv;
+    uint16_t flags;
+    uint32_t resv2;
+  };
+
+  uint8_t last_op;
+  uint8_t ops_len;
+  uint16_t resv;
+  uint32_t resv2[3];
+  Op ops[kMaxOps];
+};
+
+COMPILE_ASSERT(sizeof(IOUring::SubmissionEntry) == 64);
+COMPILE_ASSERT(sizeof(IOUring::CompletionEntry) == 16);
+COMPILE_ASSERT(sizeof(SetupParams) == 120);
+
+// Probing for operations needs Linux 5.6, which is also the first version
+// that supports kEpollCtl.
+static bool SupportsOperations(int fd) {
+  Probe probe;
+  memset(&probe, 0, sizeof(probe));
+  if (syscall(kSysIOUringRegister, fd, kRegisterProbe, &probe,
+              Probe::kMaxOps) != 0) {
+    return false;
+  }
+  static const intptr_t kNumUsedOps = 4;
+  const IOUring::Opcode kUsedOps[kNumUsedOps] = {
+      IOUring::kPollAdd,
+      IOUring::kTimeout,
+      IOUring::kTimeoutRemove,
+      IOUring::kEpollCtl,
+  };
+  for (intptr_t i = 0; i < kNumUsedOps; i++) {
+    const intptr_t op = kUsedOps[i];
+    if ((op > probe.last_op) || ((probe.ops[op].flags & kOpSupported) == 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void* MapRing(int fd, intptr_t size, off_t offset) {
+  void* result = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd, offset);
+  return (result == MAP_FAILED) ? NULL : result;
+}
+
+template <typename T>
+static T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(reinterpret_cast<uint8_t*>(ring) + offset);
+}
+
+IOUring::IOUring(int fd, uint32_t entries)
+    : fd_(fd),
+      entries_(entries),
+      sq_ring_(NULL),
+      sq_ring_size_(0),
+      sq_head_(NULL),
+      sq_tail_(NULL),
+      sq_mask_(0),
+      sq_array_(NULL),
+      sqes_(NULL),
+      cq_ring_(NULL),
+      cq_ring_size_(0),
+      cq_head_(NULL),
+      cq_tail_(NULL),
+      cq_mask_(0),
+      cqes_(NULL),
+      queued_(0),
+      submitted_(0) {}
+
+IOUring::~IOUring() {
+  if (sqes_ != NULL) {
+    munmap(sqes_, entries_ * sizeof(SubmissionEntry));
+  }
+  if ((cq_ring_ != NULL) && (cq_ring_ != sq_ring_)) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_ != NULL) {
+    munmap(sq_ring_, sq_ring_size_);
+  }
+  close(fd_);
+}
+
+IOUring* IOUring::New(uint32_t entries) {
+  SetupParams params;
+  memset(&params, 0, sizeof(params));
+  // The file descriptor is created with O_CLOEXEC.
+  const int fd =
+      static_cast<int>(syscall(kSysIOUringSetup, entries, &params));
+  if (fd < 0) {
+    return NULL;
+  }
+  IOUring* ring = new IOUring(fd, params.sq_entries);
+  if (!SupportsOperations(fd)) {
+    delete ring;
+    return NULL;
+  }
+
+  ring->sq_ring_size_ =
+      params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  ring->cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(CompletionEntry);
+  const bool single_mmap = (params.features & kFeatureSingleMmap) != 0;
+  if (single_mmap) {
+    ring->sq_ring_size_ = Utils::Maximum(ring->sq_ring_size_,
+                                         ring->cq_ring_size_);
+    ring->cq_ring_size_ = ring->sq_ring_size_;
+  }
+  ring->sq_ring_ = MapRing(fd, ring->sq_ring_size_, kSubmissionRingOffset);
+  if (ring->sq_ring_ == NULL) {
+    delete ring;
+    return NULL;
+  }
+  ring->cq_ring_ =
+      single_mmap ? ring->sq_ring_
+                  : MapRing(fd, ring->cq_ring_size_, kCompletionRingOffset);
+  if (ring->cq_ring_ == NULL) {
+    delete ring;
+    return NULL;
+  }
+  ring->sqes_ = reinterpret_cast<SubmissionEntry*>(
+      MapRing(fd, params.sq_entries * sizeof(SubmissionEntry),
+              kSubmissionEntriesOffset));
+  if (ring->sqes_ == NULL) {
+    delete ring;
+    return NULL;
+  }
+
+  ring->sq_head_ = RingField<uint32_t>(ring->sq_ring_, params.sq_off.head);
+  ring->sq_tail_ = RingField<uint32_t>(ring->sq_ring_, params.sq_off.tail);
+  ring->sq_mask_ = *RingField<uint32_t>(ring->sq_ring_,
+                                        params.sq_off.ring_mask);
+  ring->sq_array_ = RingField<uint32_t>(ring->sq_ring_, params.sq_off.array);
+  ring->cq_head_ = RingField<uint32_t>(ring->cq_ring_, params.cq_off.head);
+  ring->cq_tail_ = RingField<uint32_t>(ring->cq_ring_, params.cq_off.tail);
+  ring->cq_mask_ = *RingField<uint32_t>(ring->cq_ring_,
+                                        params.cq_off.ring_mask);
+  ring->cqes_ =
+      RingField<CompletionEntry>(ring->cq_ring_, params.cq_off.cqes);
+  ring->queued_ = *ring->sq_tail_;
+  ring->submitted_ = ring->queued_;
+  return ring;
+}
+
+IOUring::SubmissionEntry* IOUring::NextSubmission() {
+  const uint32_t head = AtomicOperations::LoadAcquire(sq_head_);
+  if (queued_ - head >= entries_) {
+    return NULL;
+  }
+  const uint32_t index = queued_ & sq_mask_;
+  SubmissionEntry* entry = &sqes_[index];
+  memset(entry, 0, sizeof(*entry));
+  sq_array_[index] = index;
+  queued_++;
+  return entry;
+}
+
+bool IOUring::Submit(uint32_t wait_for) {
+  AtomicOperations::StoreRelease(sq_tail_, queued_);
+  const uint32_t flags = (wait_for > 0) ? kEnterGetEvents : 0;
+  while (true) {
+    const long result =  // NOLINT
+        syscall(kSysIOUringEnter, fd_, queued_ - submitted_, wait_for, flags,
+                NULL, 0);
+    if (result >= 0) {
+      submitted_ += static_cast<uint32_t>(result);
+      return true;
+    }
+    if (errno != EINTR) {
+      return false;
+    }
+  }
+}
+
+IOUring::CompletionEntry* IOUring::PeekCompletion() {
+  const uint32_t head = *cq_head_;
+  if (head == AtomicOperations::LoadAcquire(cq_tail_)) {
+    return NULL;
+  }
+  return &cqes_[head & cq_mask_];
+}
+
+void IOUring::ConsumeCompletion() {
+  AtomicOperations::StoreRelease(cq_head_, *cq_head_ + 1);
+}
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // defined(HOST_OS_LINUX)
@@ -0,0 +1,111 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_BIN_IO_URING_LINUX_H_
+#define RUNTIME_BIN_IO_URING_LINUX_H_
+
+#include "platform/globals.h"
+
+#if !defined(HOST_OS_LINUX)
+#error Only include io_uring_linux.h on Linux.
+#endif
+
+namespace dart {
+namespace bin {
+
+// A submission and completion queue pair of the Linux io_uring interface.
+//
+// The kernel ABI is declared here rather than taken from <linux/io_uring.h>,
+// which is missing from the sysroots the embedder is built against. Only the
+// parts used by the event handler are declared.
+class IOUring {
+ public:
+  // Operations, see IORING_OP_* in include/uapi/linux/io_uring.h.
+  enum Opcode {
+    kPollAdd = 6,
+    kTimeout = 11,
+    kTimeoutRemove = 12,
+    kEpollCtl = 29,
+  };
+
+  // IORING_TIMEOUT_ABS.
+  static const uint32_t kTimeoutAbsolute = 1 << 0;
+
+  struct Timespec {
+    int64_t tv_sec;
+    int64_t tv_nsec;
+  };
+
+  // struct io_uring_sqe.
+  struct SubmissionEntry {
+    uint8_t opcode;
+    uint8_t flags;
+    uint16_t ioprio;
+    int32_t fd;
+    uint64_t off;
+    uint64_t addr;
+    uint32_t len;
+    uint32_t op_flags;
+    uint64_t user_data;
+    uint64_t pad[3];
+  };
+
+  // struct io_uring_cqe.
+  struct CompletionEntry {
+    uint64_t user_data;
+    int32_t res;
+    uint32_t flags;
+  };
+
+  // Creates a ring with room for [entries] submissions. Returns NULL if the
+  // kernel does not support io_uring or one of the operations above, or if
+  // io_uring is disabled for the process.
+  static IOUring* New(uint32_t entries);
+  ~IOUring();
+
+  // Returns a cleared submission entry, or NULL if all entries are queued.
+  // The entry is passed to the kernel by the next call to Submit().
+  SubmissionEntry* NextSubmission();
+
+  // Passes all queued submissions to the kernel and waits until at least
+  // [wait_for] completions are available. Returns false if io_uring_enter
+  // failed with an error other than EINTR.
+  bool Submit(uint32_t wait_for);
+
+  // Returns the oldest completion that has not been consumed, or NULL.
+  CompletionEntry* PeekCompletion();
+  void ConsumeCompletion();
+
+ private:
+  IOUring(int fd, uint32_t entries);
+
+  const int fd_;
+  const uint32_t entries_;
+
+  void* sq_ring_;
+  intptr_t sq_ring_size_;
+  uint32_t* sq_head_;
+  uint32_t* sq_tail_;
+  uint32_t sq_mask_;
+  uint32_t* sq_array_;
+  SubmissionEntry* sqes_;
+
+  void* cq_ring_;
+  intptr_t cq_ring_size_;
+  uint32_t* cq_head_;
+  uint32_t* cq_tail_;
+  uint32_t cq_mask_;
+  CompletionEntry* cqes_;
+
+  // The submissions queued and passed to the kernel so far.
+  uint32_t queued_;
+  uint32_t submitted_;
+
+  DISALLOW_COPY_AND_ASSIGN(IOUring);
+};
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // RUNTIME_BIN_IO_URING_LINUX_H_
@@ -9,6 +9,7 @@
 #include <string.h>
 
 #include "bin/abi_version.h"
+#include "bin/eventhandler.h"
 #include "bin/options.h"
 #include "bin/platform.h"
 #include "platform/syslog.h"
@@ -214,6 +215,14 @@ void Options::PrintUsage() {
 "  The path to a directory that dart:io calls will treat as the root of the\n"
 "  filesystem.\n"
 #endif  // defined(HOST_OS_LINUX) || defined(HOST_OS_ANDROID)
+#if defined(HOST_OS_LINUX)
+"--event-handler-threads=<count>\n"
+"  The number of threads dart:io uses to wait for socket events and timers\n"
+"  (default 1). File descriptors are distributed over the threads.\n"
+"--use-io-uring\n"
+"  Wait for socket events and timers with io_uring instead of epoll if the\n"
+"  kernel supports it (Linux 5.6 or later).\n"
+#endif  // defined(HOST_OS_LINUX)
 "\n"
 "The following options are only used for VM development and may\n"
 "be changed in any future version:\n");
@@ -359,6 +368,36 @@ bool Options::ProcessAbiVersionOption(const char* arg,
   return true;
 }
 
+int Options::event_handler_threads_ = 1;
+bool Options::ProcessEventHandlerThreadsOption(const char* arg,
+                                               CommandLineOptions* vm_options) {
+  const char* value =
+      OptionProcessor::ProcessOption(arg, "--event_handler_threads=");
+  if (value == NULL) {
+    return false;
+  }
+  int threads = 0;
+  for (int i = 0; value[i]; ++i) {
+    if (value[i] >= '0' && value[i] <= '9') {
+      threads = (threads * 10) + value[i] - '0';
+    } else {
+      Syslog::PrintErr("--event_handler_threads must be an int\n");
+      return false;
+    }
+    if (threads > EventHandler::kMaxThreadCount) {
+      break;
+    }
+  }
+  if (threads < 1 || threads > EventHandler::kMaxThreadCount) {
+    Syslog::PrintErr(
+        "--event_handler_threads must be between 1 and %" Pd " inclusive\n",
+        EventHandler::kMaxThreadCount);
+    return false;
+  }
+  event_handler_threads_ = threads;
+  return true;
+}
+
 int Options::ParseArguments(int argc,
                             char** argv,
                             bool vm_run_app_snapshot,
@@ -415,6 +454,8 @@ int Options::ParseArguments(int argc,
 
   Socket::set_short_socket_read(Options::short_socket_read());
   Socket::set_short_socket_write(Options::short_socket_write());
+  EventHandler::set_thread_count(Options::event_handler_threads());
+  EventHandler::set_use_io_uring(Options::use_io_uring());
 #if !defined(DART_IO_SECURE_SOCKET_DISABLED)
   SSLCertContext::set_root_certs_file(Options::root_certs_file());
   SSLCertContext::set_root_certs_cache(Options::root_certs_cache());
@@ -6,6 +6,7 @@
 
 #include "bin/dartutils.h"
 #include "bin/eventhandler.h"
+#include "bin/file.h"
 #include "bin/io_buffer.h"
 #include "bin/isolate_data.h"
 #include "bin/lockers.h"
@@ -323,52 +324,44 @@ void FUNCTION_NAME(Socket_Available)(Dart_NativeArguments args) {
   }
 }
 
-void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
+// Reads into a range of a Uint8List supplied by the caller, which is usually
+// reused across reads, and returns the number of bytes read. This avoids
+// allocating an external typed data with a finalizer for every read.
+void FUNCTION_NAME(Socket_ReadInto)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
-  int64_t length = 0;
-  if (DartUtils::GetInt64Value(Dart_GetNativeArgument(args, 1), &length) &&
-      (length >= 0)) {
-    if (Socket::short_socket_read()) {
-      length = (length + 1) / 2;
-    }
-    uint8_t* buffer = NULL;
-    Dart_Handle result = IOBuffer::Allocate(length, &buffer);
-    if (Dart_IsNull(result)) {
-      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-      return;
-    }
-    if (Dart_IsError(result)) {
-      Dart_PropagateError(result);
-    }
-    ASSERT(buffer != NULL);
-    intptr_t bytes_read =
-        SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
-    if (bytes_read == length) {
-      Dart_SetReturnValue(args, result);
-    } else if (bytes_read > 0) {
-      uint8_t* new_buffer = NULL;
-      Dart_Handle new_result = IOBuffer::Allocate(bytes_read, &new_buffer);
-      if (Dart_IsNull(new_result)) {
-        Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-        return;
-      }
-      if (Dart_IsError(new_result)) {
-        Dart_PropagateError(new_result);
-      }
-      ASSERT(new_buffer != NULL);
-      memmove(new_buffer, buffer, bytes_read);
-      Dart_SetReturnValue(args, new_result);
-    } else if (bytes_read == 0) {
-      // On MacOS when reading from a tty Ctrl-D will result in reading one
-      // less byte then reported as available.
-      Dart_SetReturnValue(args, Dart_Null());
-    } else {
-      ASSERT(bytes_read == -1);
-      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
-    }
+  Dart_Handle buffer_obj = Dart_GetNativeArgument(args, 1);
+  intptr_t offset = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 2));
+  intptr_t length = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 3));
+  if (Socket::short_socket_read()) {
+    length = (length + 1) / 2;
+  }
+  Dart_TypedData_Type type;
+  uint8_t* buffer = NULL;
+  intptr_t len;
+  Dart_Handle result = Dart_TypedDataAcquireData(
+      buffer_obj, &type, reinterpret_cast<void**>(&buffer), &len);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT(type == Dart_TypedData_kUint8);
+  ASSERT((offset >= 0) && (length >= 0) && ((offset + length) <= len));
+  buffer += offset;
+  intptr_t bytes_read =
+      SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
+  if (bytes_read > 0) {
+    Dart_TypedDataReleaseData(buffer_obj);
+    Dart_SetIntegerReturnValue(args, bytes_read);
+  } else if (bytes_read == 0) {
+    Dart_TypedDataReleaseData(buffer_obj);
+    // On MacOS when reading from a tty Ctrl-D will result in reading one
+    // less byte then reported as available.
+    Dart_SetReturnValue(args, Dart_Null());
   } else {
-    OSError os_error(-1, "Invalid argument", OSError::kUnknown);
+    ASSERT(bytes_read == -1);
+    // Extract OSError before we release data, as it may override the error.
+    OSError os_error;
+    Dart_TypedDataReleaseData(buffer_obj);
     Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
   }
 }
@@ -494,6 +487,142 @@ void FUNCTION_NAME(Socket_WriteList)(Dart_NativeArguments args) {
   }
 }
 
+// Writes ranges of several typed data chunks with a single vectored write.
+// Returns the total number of bytes written, negated like in
+// Socket_WriteList if the write was short for other reasons than the socket
+// buffer being full.
+void FUNCTION_NAME(Socket_WriteVector)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  Dart_Handle buffers_obj = Dart_GetNativeArgument(args, 1);
+  Dart_Handle starts_obj = Dart_GetNativeArgument(args, 2);
+  Dart_Handle ends_obj = Dart_GetNativeArgument(args, 3);
+  ASSERT(Dart_IsList(buffers_obj));
+  intptr_t num_chunks = 0;
+  Dart_Handle result = Dart_ListLength(buffers_obj, &num_chunks);
+  if (Dart_IsError(result)) {
+    Dart_PropagateError(result);
+  }
+  ASSERT(num_chunks > 0);
+  // If not all chunks are passed to the system call, the write is 'short'
+  // and returns the negative number of bytes like a forced short write.
+  const intptr_t requested_chunks = num_chunks;
+  num_chunks = Utils::Minimum(num_chunks, SocketBase::kMaxWriteChunks);
+  if (Socket::short_socket_write()) {
+    num_chunks = 1;
+  }
+
+  Dart_Handle chunk_objs[SocketBase::kMaxWriteChunks];
+  SocketBase::WriteChunk chunks[SocketBase::kMaxWriteChunks];
+  intptr_t starts[SocketBase::kMaxWriteChunks];
+  for (intptr_t i = 0; i < num_chunks; i++) {
+    chunk_objs[i] = Dart_ListGetAt(buffers_obj, i);
+    if (Dart_IsError(chunk_objs[i])) {
+      Dart_PropagateError(chunk_objs[i]);
+    }
+    starts[i] = DartUtils::GetIntptrValue(Dart_ListGetAt(starts_obj, i));
+    intptr_t end = DartUtils::GetIntptrValue(Dart_ListGetAt(ends_obj, i));
+    ASSERT((starts[i] >= 0) && (starts[i] <= end));
+    chunks[i].num_bytes = end - starts[i];
+  }
+  // The data of a list can only be acquired once, so a list that is queued
+  // more than once ends the chunks written by this call.
+  for (intptr_t i = 1; i < num_chunks; i++) {
+    for (intptr_t j = 0; j < i; j++) {
+      if (Dart_IdentityEquals(chunk_objs[i], chunk_objs[j])) {
+        num_chunks = i;
+        break;
+      }
+    }
+  }
+  bool short_write = num_chunks < requested_chunks;
+  if (Socket::short_socket_write()) {
+    if (chunks[0].num_bytes > 1) {
+      short_write = true;
+    }
+    chunks[0].num_bytes = (chunks[0].num_bytes + 1) / 2;
+  }
+
+  for (intptr_t i = 0; i < num_chunks; i++) {
+    Dart_TypedData_Type type;
+    uint8_t* buffer = NULL;
+    intptr_t len;
+    result = Dart_TypedDataAcquireData(
+        chunk_objs[i], &type, reinterpret_cast<void**>(&buffer), &len);
+    if (Dart_IsError(result)) {
+      for (intptr_t j = 0; j < i; j++) {
+        Dart_TypedDataReleaseData(chunk_objs[j]);
+      }
+      Dart_PropagateError(result);
+    }
+    ASSERT((starts[i] + chunks[i].num_bytes) <= len);
+    chunks[i].buffer = buffer + starts[i];
+  }
+  intptr_t bytes_written = SocketBase::WriteVector(socket->fd(), chunks,
+                                                   num_chunks,
+                                                   SocketBase::kAsync);
+  if (bytes_written >= 0) {
+    for (intptr_t i = 0; i < num_chunks; i++) {
+      Dart_TypedDataReleaseData(chunk_objs[i]);
+    }
+    if (short_write) {
+      // If the write was forced 'short', indicate by returning the negative
+      // number of bytes. A forced short write may not trigger a write event.
+      Dart_SetIntegerReturnValue(args, -bytes_written);
+    } else {
+      Dart_SetIntegerReturnValue(args, bytes_written);
+    }
+  } else {
+    // Extract OSError before we release data, as it may override the error.
+    OSError os_error;
+    for (intptr_t i = 0; i < num_chunks; i++) {
+      Dart_TypedDataReleaseData(chunk_objs[i]);
+    }
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError(&os_error));
+  }
+}
+
+// Sends a range of an open file to the socket without copying the data
+// through the Dart heap. Returns the number of bytes sent like
+// Socket_WriteList, null at the end of the file and false if the file has to
+// be read and written instead.
+void FUNCTION_NAME(Socket_SendFile)(Dart_NativeArguments args) {
+  Socket* socket =
+      Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
+  File* file = File::GetFileNativeField(Dart_GetNativeArgument(args, 1));
+  int64_t offset = DartUtils::GetInt64ValueCheckRange(
+      Dart_GetNativeArgument(args, 2), 0, kMaxInt64);
+  intptr_t length = DartUtils::GetIntptrValue(Dart_GetNativeArgument(args, 3));
+  ASSERT(file != NULL);
+  ASSERT(length > 0);
+  bool short_write = false;
+  if (Socket::short_socket_write()) {
+    if (length > 1) {
+      short_write = true;
+    }
+    length = (length + 1) / 2;
+  }
+  intptr_t bytes_sent = SocketBase::SendFile(socket->fd(), file->GetFD(),
+                                             offset, length,
+                                             SocketBase::kAsync);
+  if (bytes_sent >= 0) {
+    if (short_write) {
+      // If the write was forced 'short', indicate by returning the negative
+      // number of bytes. A forced short write may not trigger a write event.
+      Dart_SetIntegerReturnValue(args, -bytes_sent);
+    } else {
+      Dart_SetIntegerReturnValue(args, bytes_sent);
+    }
+  } else if (bytes_sent == SocketBase::kSendFileEndOfFile) {
+    Dart_SetReturnValue(args, Dart_Null());
+  } else if (bytes_sent == SocketBase::kSendFileUnsupported) {
+    Dart_SetBooleanReturnValue(args, false);
+  } else {
+    ASSERT(bytes_sent == -1);
+    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+  }
+}
+
 void FUNCTION_NAME(Socket_SendTo)(Dart_NativeArguments args) {
   Socket* socket =
       Socket::GetSocketIdNativeField(Dart_GetNativeArgument(args, 0));
@@ -152,6 +152,31 @@ class SocketBase : public AllStatic {
                         const void* buffer,
                         intptr_t num_bytes,
                         SocketOpKind sync);
+  // A range of bytes passed to WriteVector.
+  struct WriteChunk {
+    const void* buffer;
+    intptr_t num_bytes;
+  };
+  static const intptr_t kMaxWriteChunks = 16;
+  // Write the chunks in order with a single system call where the platform
+  // supports it. Returns the total number of bytes written, which may end in
+  // the middle of a chunk, or -1 if nothing could be written.
+  static intptr_t WriteVector(intptr_t fd,
+                              const WriteChunk* chunks,
+                              intptr_t num_chunks,
+                              SocketOpKind sync);
+  static const intptr_t kSendFileUnsupported = -2;
+  static const intptr_t kSendFileEndOfFile = -3;
+  // Send up to num_bytes of the file with descriptor file_fd, starting at
+  // offset, without copying the data through user space. Returns the number
+  // of bytes sent, -1 on errors, kSendFileEndOfFile if offset is at the end
+  // of the file and kSendFileUnsupported if the platform, file or socket does
+  // not support this. Nothing is sent in the last two cases.
+  static intptr_t SendFile(intptr_t fd,
+                           intptr_t file_fd,
+                           int64_t offset,
+                           intptr_t num_bytes,
+                           SocketOpKind sync);
   // Send data on a socket. The port to send to is specified in the port
   // component of the passed RawAddr structure. The RawAddr structure is only
   // used for datagram sockets.
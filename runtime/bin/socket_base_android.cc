@@ -14,7 +14,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/sendfile.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "bin/fdutils.h"
@@ -105,6 +107,61 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 const WriteChunk* chunks,
+                                 intptr_t num_chunks,
+                                 SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  ASSERT((num_chunks > 0) && (num_chunks <= kMaxWriteChunks));
+  struct iovec iov[kMaxWriteChunks];
+  for (intptr_t i = 0; i < num_chunks; i++) {
+    iov[i].iov_base = const_cast<void*>(chunks[i].buffer);
+    iov[i].iov_len = chunks[i].num_bytes;
+  }
+  ssize_t written_bytes = TEMP_FAILURE_RETRY(writev(fd, iov, num_chunks));
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if ((sync == kAsync) && (written_bytes == -1) && (errno == EWOULDBLOCK)) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes written.
+    written_bytes = 0;
+  }
+  return written_bytes;
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              intptr_t file_fd,
+                              int64_t offset,
+                              intptr_t num_bytes,
+                              SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  off_t file_offset = offset;
+  if (file_offset != offset) {
+    // off_t is 32 bits on 32-bit Android, and sendfile64 is only available
+    // from API level 21, so larger offsets are read and written instead.
+    return kSendFileUnsupported;
+  }
+  ssize_t sent_bytes =
+      TEMP_FAILURE_RETRY(sendfile(fd, file_fd, &file_offset, num_bytes));
+  if (sent_bytes == 0) {
+    return (num_bytes > 0) ? kSendFileEndOfFile : 0;
+  }
+  if (sent_bytes == -1) {
+    ASSERT(EAGAIN == EWOULDBLOCK);
+    if ((sync == kAsync) && (errno == EWOULDBLOCK)) {
+      // If the would block we need to retry and therefore return 0 as
+      // the number of bytes sent.
+      return 0;
+    }
+    if ((errno == EINVAL) || (errno == ENOSYS)) {
+      // From the sendfile man page: applications may wish to fall back to
+      // read(2)/write(2) in the case where sendfile() fails with EINVAL or
+      // ENOSYS.
+      return kSendFileUnsupported;
+    }
+  }
+  return sent_bytes;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
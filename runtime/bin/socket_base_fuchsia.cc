@@ -147,6 +147,36 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 const WriteChunk* chunks,
+                                 intptr_t num_chunks,
+                                 SocketOpKind sync) {
+  // There is no vectored write here, so write the chunks one by one until
+  // one of them is not written completely.
+  intptr_t total = 0;
+  for (intptr_t i = 0; i < num_chunks; i++) {
+    intptr_t written_bytes =
+        Write(fd, chunks[i].buffer, chunks[i].num_bytes, sync);
+    if (written_bytes < 0) {
+      return (total > 0) ? total : written_bytes;
+    }
+    total += written_bytes;
+    if (written_bytes < chunks[i].num_bytes) {
+      break;
+    }
+  }
+  return total;
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              intptr_t file_fd,
+                              int64_t offset,
+                              intptr_t num_bytes,
+                              SocketOpKind sync) {
+  // Callers fall back to reading the file and writing it to the socket.
+  return kSendFileUnsupported;
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
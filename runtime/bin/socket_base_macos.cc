@@ -15,6 +15,7 @@
 #include <stdlib.h>       // NOLINT
 #include <string.h>       // NOLINT
 #include <sys/stat.h>     // NOLINT
+#include <sys/uio.h>      // NOLINT
 #include <unistd.h>       // NOLINT
 
 #include "bin/fdutils.h"
@@ -104,6 +105,59 @@ intptr_t SocketBase::Write(intptr_t fd,
   return written_bytes;
 }
 
+intptr_t SocketBase::WriteVector(intptr_t fd,
+                                 const WriteChunk* chunks,
+                                 intptr_t num_chunks,
+                                 SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  ASSERT((num_chunks > 0) && (num_chunks <= kMaxWriteChunks));
+  struct iovec iov[kMaxWriteChunks];
+  for (intptr_t i = 0; i < num_chunks; i++) {
+    iov[i].iov_base = const_cast<void*>(chunks[i].buffer);
+    iov[i].iov_len = chunks[i].num_bytes;
+  }
+  ssize_t written_bytes = TEMP_FAILURE_RETRY(writev(fd, iov, num_chunks));
+  ASSERT(EAGAIN == EWOULDBLOCK);
+  if ((sync == kAsync) && (written_bytes == -1) && (errno == EWOULDBLOCK)) {
+    // If the would block we need to retry and therefore return 0 as
+    // the number of bytes written.
+    written_bytes = 0;
+  }
+  return written_bytes;
+}
+
+intptr_t SocketBase::SendFile(intptr_t fd,
+                              intptr_t file_fd,
+                              int64_t offset,
+                              intptr_t num_bytes,
+                              SocketOpKind sync) {
+  ASSERT(fd >= 0);
+  while (true) {
+    // On return, length holds the number of bytes sent, also when sendfile
+    // fails with EAGAIN or EINTR after sending some of the data.
+    off_t length = num_bytes;
+    int result = sendfile(file_fd, fd, offset, &length, NULL, 0);
+    if (result == 0) {
+      return ((length == 0) && (num_bytes > 0)) ? kSendFileEndOfFile : length;
+    }
+    if (length > 0) {
+      return length;
+    }
+    ASSERT(EAGAIN == EWOULDBLOCK);
+    if ((sync == kAsync) && (errno == EWOULDBLOCK)) {
+      // If the would block we need to retry and therefore return 0 as
+      // the number of bytes sent.
+      return 0;
+    }
+    if ((errno == EINVAL) || (errno == ENOTSOCK) || (errno == ENOTSUP)) {
+      return kSendFileUnsupported;
+    }
+    if (errno != EINTR) {
+      return -1;
+    }
+  }
+}
+
 intptr_t SocketBase::SendTo(intptr_t fd,
                             const void* buffer,
                             intptr_t num_bytes,
@@ -334,6 +334,15 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
   static const int normalTokenBatchSize = 8;
   static const int listeningTokenBatchSize = 2;
 
+  // The most buffers passed to a single vectored write. Must match
+  // SocketBase::kMaxWriteChunks.
+  static const int maxWriteVectorLength = 16;
+
+  // Reads of up to this many bytes go through a buffer shared by all sockets
+  // of the isolate, and only the bytes read are copied out of it.
+  static const int readBufferSize = 64 * 1024;
+  static Uint8List _readBuffer;
+
   static const Duration _retryDuration = const Duration(milliseconds: 250);
   static const Duration _retryDurationLoopback =
       const Duration(milliseconds: 25);
@@ -672,17 +681,37 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
     if (isClosing || isClosed) return null;
     len = min(available, len == null ? available : len);
     if (len == 0) return null;
-    var result = nativeRead(len);
+    Uint8List buffer;
+    if (len <= readBufferSize) {
+      buffer = _readBuffer ??= new Uint8List(readBufferSize);
+    } else {
+      buffer = new Uint8List(len);
+    }
+    int bytesRead = readInto(buffer, 0, len);
+    if (bytesRead == null) return null;
+    if (identical(buffer, _readBuffer) || bytesRead < len) {
+      return buffer.sublist(0, bytesRead);
+    }
+    return buffer;
+  }
+
+  // Reads up to [end] - [start] bytes into [buffer] and returns the number of
+  // bytes read, or null if nothing could be read.
+  int readInto(Uint8List buffer, int start, int end) {
+    if (isClosing || isClosed) return null;
+    int len = min(available, end - start);
+    if (len <= 0) return null;
+    var result = nativeReadInto(buffer, start, len);
     if (result is OSError) {
       reportError(result, "Read failed");
       return null;
     }
     if (result != null) {
-      available -= result.length;
+      available -= result;
       // TODO(ricow): Remove when we track internal and pipe uses.
       assert(resourceInfo != null || isPipe || isInternal || isInternalSignal);
       if (resourceInfo != null) {
-        resourceInfo.totalRead += result.length;
+        resourceInfo.totalRead += result;
       }
     }
     // TODO(ricow): Remove when we track internal and pipe uses.
@@ -743,6 +772,53 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
         _ensureFastAndSerializableByteData(buffer, offset, offset + bytes);
     var result =
         nativeWrite(bufferAndStart.buffer, bufferAndStart.start, bytes);
+    return handleWriteResult(result, bytes);
+  }
+
+  // Writes [buffers], starting at [offset] in the first one, with a single
+  // native call and returns the number of bytes written. At most
+  // [maxWriteVectorLength] buffers are written.
+  int writeList(List<List<int>> buffers, int offset) {
+    if (isClosing || isClosed) return 0;
+    int count = min(buffers.length, maxWriteVectorLength);
+    if (count == 0) return 0;
+    if (count == 1) {
+      return write(buffers[0], offset, buffers[0].length - offset);
+    }
+    var fastBuffers = new List(count);
+    var starts = new List<int>(count);
+    var ends = new List<int>(count);
+    int bytes = 0;
+    for (int i = 0; i < count; i++) {
+      List<int> buffer = buffers[i];
+      int start = (i == 0) ? offset : 0;
+      _BufferAndStart bufferAndStart =
+          _ensureFastAndSerializableByteData(buffer, start, buffer.length);
+      fastBuffers[i] = bufferAndStart.buffer;
+      starts[i] = bufferAndStart.start;
+      ends[i] = bufferAndStart.start + buffer.length - start;
+      bytes += buffer.length - start;
+    }
+    if (bytes == 0) return 0;
+    var result = nativeWriteVector(fastBuffers, starts, ends);
+    return handleWriteResult(result, bytes);
+  }
+
+  // Sends up to [count] bytes of [file], starting at [position], directly
+  // from the file to the socket. Returns the number of bytes sent, null at
+  // the end of the file, or false if the file cannot be sent this way and
+  // has to be read and written instead.
+  sendFile(_RandomAccessFile file, int position, int count) {
+    if (isClosing || isClosed) return 0;
+    if (count == 0) return 0;
+    // Keep the count in the range of intptr_t on 32-bit platforms.
+    count = min(count, 1 << 30);
+    var result = nativeSendFile(file._ops, position, count);
+    if (result == null || result == false) return result;
+    return handleWriteResult(result, count);
+  }
+
+  int handleWriteResult(result, int bytes) {
     if (result is OSError) {
       OSError osError = result;
       scheduleMicrotask(() => reportError(osError, "Write failed"));
@@ -1173,10 +1249,14 @@ class _NativeSocket extends _NativeSocketNativeWrapper with _ServiceObject {
 
   void nativeSetSocketId(int id, int typeFlags) native "Socket_SetSocketId";
   nativeAvailable() native "Socket_Available";
-  nativeRead(int len) native "Socket_Read";
+  nativeReadInto(Uint8List buffer, int offset, int bytes)
+      native "Socket_ReadInto";
   nativeRecvFrom() native "Socket_RecvFrom";
   nativeWrite(List<int> buffer, int offset, int bytes)
       native "Socket_WriteList";
+  nativeWriteVector(List buffers, List<int> starts, List<int> ends)
+      native "Socket_WriteVector";
+  nativeSendFile(file, int position, int count) native "Socket_SendFile";
   nativeSendTo(List<int> buffer, int offset, int bytes, Uint8List address,
       int port) native "Socket_SendTo";
   nativeCreateConnect(Uint8List addr, int port) native "Socket_CreateConnect";
@@ -1397,6 +1477,12 @@ class _RawSocket extends Stream<RawSocketEvent> implements RawSocket {
   int write(List<int> buffer, [int offset, int count]) =>
       _socket.write(buffer, offset, count);
 
+  int _writeList(List<List<int>> buffers, int offset) =>
+      _socket.writeList(buffers, offset);
+
+  _sendFile(_RandomAccessFile file, int position, int count) =>
+      _socket.sendFile(file, position, count);
+
   Future<RawSocket> close() => _socket.close().then<RawSocket>((_) => this);
 
   void shutdown(SocketDirection direction) => _socket.shutdown(direction);
@@ -1526,39 +1612,105 @@ class Socket {
 }
 
 class _SocketStreamConsumer extends StreamConsumer<List<int>> {
+  // While waiting for the socket to become writable, data is queued until
+  // this many bytes are pending. The queued buffers are then written together
+  // with a single vectored write.
+  static const int maxPendingBytes = 64 * 1024;
+
   StreamSubscription subscription;
   final _Socket socket;
-  int offset;
-  List<int> buffer;
+  final List<List<int>> buffers = <List<int>>[];
+  int offset = 0; // Offset of the first unwritten byte in buffers.first.
+  int pendingBytes = 0;
+  bool waitingForWrite = false;
+  bool streamDone = false;
   bool paused = false;
   Completer streamCompleter;
 
+  // A stream from File.openRead that is sent with sendfile instead of being
+  // listened to, the file once it is open, and the range left to send.
+  _FileStream fileStream;
+  _RandomAccessFile file;
+  int filePosition;
+  int fileEnd;
+
   _SocketStreamConsumer(this.socket);
 
   Future<Socket> addStream(Stream<List<int>> stream) {
     socket._ensureRawSocketSubscription();
     streamCompleter = new Completer<Socket>();
-    if (socket._raw != null) {
-      subscription = stream.listen((data) {
-        assert(!paused);
-        assert(buffer == null);
-        buffer = data;
-        offset = 0;
-        try {
+    streamDone = false;
+    if (canSendFile(stream)) {
+      sendFileStream(stream);
+    } else if (socket._raw != null) {
+      listen(stream);
+    }
+    return streamCompleter.future;
+  }
+
+  bool canSendFile(Stream<List<int>> stream) {
+    if (stream is! _FileStream || socket._raw is! _RawSocket) return false;
+    _FileStream fileStream = stream;
+    // Leave streams that are already listened to, and the error cases of
+    // the range, to the stream itself.
+    return fileStream._controller == null &&
+        fileStream._path != null &&
+        fileStream._position >= 0 &&
+        (fileStream._end == null || fileStream._end >= fileStream._position);
+  }
+
+  void sendFileStream(_FileStream stream) {
+    fileStream = stream;
+    RandomAccessFile opened;
+    new File(stream._path).open().then((RandomAccessFile openedFile) {
+      opened = openedFile;
+      return openedFile.length();
+    }).then((int length) {
+      if (!identical(fileStream, stream) || socket._raw == null) {
+        // Stopped or closed while opening the file.
+        opened.close();
+        return;
+      }
+      file = opened;
+      filePosition = stream._position;
+      fileEnd = max(filePosition, min(stream._end ?? length, length));
+      write();
+    }).catchError((error, stackTrace) {
+      if (opened != null) opened.close();
+      if (!identical(fileStream, stream)) return;
+      fileStream = null;
+      socket.destroy();
+      done(error, stackTrace);
+    });
+  }
+
+  void listen(Stream<List<int>> stream) {
+    subscription = stream.listen((data) {
+      assert(!paused);
+      buffers.add(data);
+      pendingBytes += data.length;
+      try {
+        if (waitingForWrite) {
+          pauseIfFull();
+        } else {
           write();
-        } catch (e) {
-          socket.destroy();
-          stop();
-          done(e);
         }
-      }, onError: (error, [stackTrace]) {
+      } catch (e) {
         socket.destroy();
-        done(error, stackTrace);
-      }, onDone: () {
+        stop();
+        done(e);
+      }
+    }, onError: (error, [stackTrace]) {
+      socket.destroy();
+      done(error, stackTrace);
+    }, onDone: () {
+      // Complete when the queued data has been written.
+      if (buffers.isEmpty) {
         done();
-      }, cancelOnError: true);
-    }
-    return streamCompleter.future;
+      } else {
+        streamDone = true;
+      }
+    }, cancelOnError: true);
   }
 
   Future<Socket> close() {
@@ -1567,26 +1719,77 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
   }
 
   void write() {
+    if (fileStream != null) {
+      waitingForWrite = false;
+      if (file != null) writeFile();
+      return;
+    }
     if (subscription == null) return;
-    assert(buffer != null);
+    waitingForWrite = false;
+    if (buffers.isEmpty) return;
     // Write as much as possible.
-    offset += socket._write(buffer, offset, buffer.length - offset);
-    if (offset < buffer.length) {
-      if (!paused) {
-        paused = true;
-        subscription.pause();
-      }
+    offset += socket._writeList(buffers, offset);
+    int written = 0;
+    while (written < buffers.length && offset >= buffers[written].length) {
+      offset -= buffers[written].length;
+      pendingBytes -= buffers[written].length;
+      written++;
+    }
+    buffers.removeRange(0, written);
+    if (buffers.isNotEmpty) {
+      waitingForWrite = true;
+      pauseIfFull();
       socket._enableWriteEvent();
     } else {
-      buffer = null;
+      assert(offset == 0 && pendingBytes == 0);
       if (paused) {
         paused = false;
         subscription.resume();
       }
+      if (streamDone) {
+        streamDone = false;
+        done();
+      }
+    }
+  }
+
+  void writeFile() {
+    var result = socket._sendFile(file, filePosition, fileEnd - filePosition);
+    if (result == false) {
+      // Read the rest of the file and write it instead.
+      var stream = new _FileStream(file.path, filePosition, fileEnd);
+      closeFile();
+      listen(stream);
+      return;
+    }
+    if (result != null) filePosition += result;
+    if (result == null || filePosition == fileEnd) {
+      closeFile();
+      done();
+    } else {
+      waitingForWrite = true;
+      socket._enableWriteEvent();
+    }
+  }
+
+  void closeFile() {
+    fileStream = null;
+    if (file != null) {
+      file.close();
+      file = null;
+    }
+  }
+
+  void pauseIfFull() {
+    if (!paused && pendingBytes >= maxPendingBytes) {
+      paused = true;
+      subscription.pause();
     }
   }
 
   void done([error, stackTrace]) {
+    streamDone = false;
+    closeFile();
     if (streamCompleter != null) {
       if (error != null) {
         streamCompleter.completeError(error, stackTrace);
@@ -1598,8 +1801,9 @@ class _SocketStreamConsumer extends StreamConsumer<List<int>> {
   }
 
   void stop() {
-    if (subscription == null) return;
-    subscription.cancel();
+    if (subscription == null && fileStream == null) return;
+    closeFile();
+    subscription?.cancel();
     subscription = null;
     paused = false;
     socket._disableWriteEvent();
@@ -1734,7 +1938,7 @@ class _Socket extends Stream<List<int>> implements Socket {
     _detachReady = new Completer();
     _sink.close();
     return _detachReady.future.then((_) {
-      assert(_consumer.buffer == null);
+      assert(_consumer.buffers.isEmpty);
       var raw = _raw;
       _raw = null;
       return [raw, _subscription];
@@ -1812,8 +2016,16 @@ class _Socket extends Stream<List<int>> implements Socket {
     _consumer.done(error, stackTrace);
   }
 
-  int _write(List<int> data, int offset, int length) =>
-      _raw.write(data, offset, length);
+  _sendFile(_RandomAccessFile file, int position, int count) {
+    _RawSocket raw = _raw;
+    return raw._sendFile(file, position, count);
+  }
+
+  int _writeList(List<List<int>> data, int offset) {
+    var raw = _raw;
+    if (raw is _RawSocket) return raw._writeList(data, offset);
+    return raw.write(data.first, offset, data.first.length - offset);
+  }
 
   void _enableWriteEvent() {
     _raw.writeEventsEnabled = true;
@@ -533,4 +533,26 @@ DEFINE_NATIVE_ENTRY(TransferableTypedData_materialize, 0, 1) {
   return typed_data.raw();
 }
 
+DEFINE_NATIVE_ENTRY(TransferableTypedData_detach, 0, 1) {
+  GET_NON_NULL_NATIVE_ARGUMENT(Instance, instance, arguments->NativeArgAt(0));
+  const intptr_t length = GetUint8SizeOrThrow(instance);
+
+  // The bytes are always copied. Optimized code may keep the length and data
+  // pointer of [instance] after loading them once, so they cannot be changed
+  // to hand over its backing store.
+  uint8_t* data = reinterpret_cast<uint8_t*>(malloc(length));
+  if (data == nullptr) {
+    const Instance& exception =
+        Instance::Handle(thread->isolate()->object_store()->out_of_memory());
+    Exceptions::Throw(thread, exception);
+    UNREACHABLE();
+  }
+  {
+    NoSafepointScope no_safepoint;
+    const auto& typed_data = TypedDataBase::Cast(instance);
+    memcpy(data, typed_data.DataAddr(0), length);
+  }
+  return TransferableTypedData::New(data, length);
+}
+
 }  // namespace dart
@@ -692,6 +692,14 @@ abstract class TransferableTypedData {
     }
     return _TransferableTypedDataImpl(chunks);
   }
+
+  @patch
+  factory TransferableTypedData.detach(TypedData data) {
+    if (data == null) {
+      throw ArgumentError.notNull("data");
+    }
+    return _TransferableTypedDataImpl._detach(data);
+  }
 }
 
 @pragma("vm:entry-point")
@@ -705,4 +713,7 @@ class _TransferableTypedDataImpl implements TransferableTypedData {
 
   Uint8List _materializeIntoUint8List()
       native "TransferableTypedData_materialize";
+
+  static TransferableTypedData _detach(TypedData data)
+      native "TransferableTypedData_detach";
 }
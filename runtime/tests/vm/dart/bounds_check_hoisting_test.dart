@@ -0,0 +1,93 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization-counter-threshold=10 --no-use-osr --no-background-compilation
+
+// Test that bounds checks hoisted out of loops still throw in the right
+// iteration, after all side effects of the earlier iterations.
+
+import 'dart:typed_data';
+
+import "package:expect/expect.dart";
+
+int downward(Int32List a, Int32List b, int n) {
+  int sum = 0;
+  for (int i = n - 1; i >= 0; i--) {
+    sum += a[i] - b[i];
+  }
+  return sum;
+}
+
+void strided(Int32List from, Int32List to, int n) {
+  for (int i = 0, j = 1; i < n; i++, j += 3) {
+    to[i] = from[j];
+  }
+}
+
+void shifted(Int32List from, Int32List to, int start, int n) {
+  for (int i = start; i < n; i++) {
+    to[i - start] = from[i + 1] - from[i];
+  }
+}
+
+void testDownward() {
+  for (int n = 0; n < 10; n++) {
+    final a = new Int32List(n);
+    final b = new Int32List(n + 2);
+    for (int i = 0; i < n; i++) {
+      a[i] = 3 * i;
+      b[i] = i;
+    }
+    Expect.equals(n * (n - 1), downward(a, b, n));
+    Expect.throws(() => downward(a, b, n + 1), (e) => e is RangeError);
+  }
+}
+
+void testStrided() {
+  for (int n = 0; n < 10; n++) {
+    final from = new Int32List(3 * n);
+    for (int i = 0; i < from.length; i++) {
+      from[i] = i;
+    }
+    final to = new Int32List(n);
+    // The last iteration reads from[3 * n - 2], which is in bounds.
+    strided(from, to, n);
+    for (int i = 0; i < n; i++) {
+      Expect.equals(3 * i + 1, to[i]);
+    }
+    // One more iteration is out of bounds of both lists.
+    final longer = new Int32List(n + 1);
+    Expect.throws(() => strided(from, longer, n + 1), (e) => e is RangeError);
+    for (int i = 0; i < n; i++) {
+      Expect.equals(3 * i + 1, longer[i]);
+    }
+    Expect.equals(0, longer[n]);
+  }
+}
+
+void testShifted() {
+  for (int n = 1; n < 10; n++) {
+    final from = new Int32List(n + 1);
+    for (int i = 0; i <= n; i++) {
+      from[i] = i * i;
+    }
+    final to = new Int32List(n);
+    shifted(from, to, 0, n);
+    for (int i = 0; i < n; i++) {
+      Expect.equals(2 * i + 1, to[i]);
+    }
+    // A negative start fails in the first iteration.
+    Expect.throws(() => shifted(from, to, -1, n), (e) => e is RangeError);
+    // An empty loop never touches the lists.
+    shifted(from, to, n + 5, n);
+  }
+}
+
+main() {
+  for (int i = 0; i < 20; i++) {
+    testDownward();
+    testStrided();
+    testShifted();
+  }
+}
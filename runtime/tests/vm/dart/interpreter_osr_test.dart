@@ -0,0 +1,109 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization-counter-threshold=100 --use-osr --no-background-compilation
+
+// Test that long running loops in a single invocation of a function are
+// replaced with optimized code in the middle of the loop. With the bytecode
+// interpreter this transfers interpreted frames into OSR code, which must
+// see the arguments and locals of the frame and return to its caller.
+
+import "package:expect/expect.dart";
+
+int sumTo(int n) {
+  int sum = 0;
+  for (int i = 1; i <= n; i++) {
+    sum += i;
+  }
+  return sum;
+}
+
+class Accumulator {
+  int total = 0;
+  final int factor;
+
+  Accumulator(this.factor);
+
+  int addProducts(int rows, int columns) {
+    int count = 0;
+    for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < columns; j++) {
+        total += factor * i * j;
+        count++;
+      }
+    }
+    return count;
+  }
+}
+
+int throwAt(List<int> list, int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    // Fails with a RangeError once i reaches list.length.
+    sum += list[i];
+  }
+  return sum;
+}
+
+int catchInLoop(int n) {
+  int caught = 0;
+  for (int i = 0; i < n; i++) {
+    try {
+      if (i % 1000 == 0) throw i;
+    } on int catch (e) {
+      Expect.equals(i, e);
+      caught++;
+    }
+  }
+  return caught;
+}
+
+String loopWithContext(int n) {
+  final parts = <String>[];
+  String last = '';
+  for (int i = 0; i < n; i++) {
+    last = 'x$i';
+    if (i % 10000 == 0) {
+      parts.add(last);
+    }
+  }
+  final join = () => parts.join(',');
+  return '${join()};$last';
+}
+
+void testSimple() {
+  Expect.equals(50000005000000, sumTo(10000000));
+}
+
+void testReceiverAndNestedLoops() {
+  final acc = new Accumulator(3);
+  Expect.equals(1000000, acc.addProducts(1000, 1000));
+  // 3 * (sum of i) * (sum of j).
+  Expect.equals(3 * 499500 * 499500, acc.total);
+}
+
+void testExceptions() {
+  final list = new List<int>.filled(100000, 1);
+  Expect.equals(100000, throwAt(list, 100000));
+  Expect.throws(() => throwAt(list, 200000), (e) => e is RangeError);
+  Expect.equals(100, catchInLoop(100000));
+}
+
+void testContext() {
+  Expect.equals('x0,x10000,x20000;x29999', loopWithContext(30000));
+}
+
+main() {
+  testSimple();
+  testReceiverAndNestedLoops();
+  testExceptions();
+  testContext();
+
+  // A loop in main itself is entered directly from the embedder.
+  int sum = 0;
+  for (int i = 0; i < 1000000; i++) {
+    sum += i & 3;
+  }
+  Expect.equals(1500000, sum);
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Test that comparisons followed by conditional jumps, and other sequences
+// of bytecodes the interpreter executes as a single superinstruction, behave
+// like the separate instructions for all kinds of operands.
+
+import "package:expect/expect.dart";
+
+const int kMint = 0x7fffffffffff0000;
+
+int countLess(int a, int b) {
+  int count = 0;
+  if (a < b) count++;
+  if (a <= b) count += 10;
+  if (a > b) count += 100;
+  if (a >= b) count += 1000;
+  if (a == b) count += 10000;
+  return count;
+}
+
+int countLessDouble(double a, double b) {
+  int count = 0;
+  if (a < b) count++;
+  if (a <= b) count += 10;
+  if (a > b) count += 100;
+  if (a >= b) count += 1000;
+  if (a == b) count += 10000;
+  return count;
+}
+
+// The results of the comparisons are also used as values, which must not be
+// affected by the fused jumps.
+List<bool> compareValues(int a, int b) => [a < b, a == b, !(a >= b)];
+
+bool isNull(Object o) => o == null;
+
+int loop(int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    if (i.isEven && i != 4) sum += i;
+  }
+  return sum;
+}
+
+int countNulls(List<Object> list) {
+  int count = 0;
+  for (var o in list) {
+    if (o == null) count++;
+  }
+  return count;
+}
+
+int Function() makeCounter() {
+  int count = 0;
+  // Loads its context from the closure in the prologue.
+  return () => ++count;
+}
+
+void testInts() {
+  Expect.equals(11, countLess(1, 2));
+  Expect.equals(11010, countLess(2, 2));
+  Expect.equals(1100, countLess(3, 2));
+  Expect.equals(11, countLess(-1, kMint));
+  Expect.equals(11010, countLess(kMint, kMint));
+  Expect.equals(1100, countLess(kMint + 1, kMint));
+  Expect.listEquals([true, false, true], compareValues(1, 2));
+  Expect.listEquals([false, true, false], compareValues(kMint, kMint));
+  Expect.equals(2 + 6 + 8, loop(10));
+}
+
+void testDoubles() {
+  Expect.equals(11, countLessDouble(1.0, 2.5));
+  Expect.equals(11010, countLessDouble(2.5, 2.5));
+  Expect.equals(1100, countLessDouble(3.0, 2.5));
+  Expect.equals(0, countLessDouble(double.nan, 1.0));
+  Expect.equals(0, countLessDouble(double.nan, double.nan));
+}
+
+void testNulls() {
+  Expect.isTrue(isNull(null));
+  Expect.isFalse(isNull(0));
+  Expect.equals(2, countNulls([null, 1, 'a', null]));
+  Expect.throws(() => countLess(null, 1), (e) => e is Error);
+  Expect.throws(() => countLess(1, null), (e) => e is Error);
+  Expect.throws(() => countLessDouble(null, 1.0), (e) => e is Error);
+}
+
+void testClosures() {
+  final counter = makeCounter();
+  Expect.equals(1, counter());
+  Expect.equals(2, counter());
+  Expect.equals(1, makeCounter()());
+}
+
+main() {
+  for (int i = 0; i < 20; i++) {
+    testInts();
+    testDoubles();
+    testNulls();
+    testClosures();
+  }
+}
@@ -0,0 +1,178 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization-counter-threshold=10 --no-use-osr --no-background-compilation
+
+// Test that vectorized loops over typed data compute the same results as the
+// scalar loop for every length, including the elements left to the epilogue.
+
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import "package:expect/expect.dart";
+
+void axpy(Float64List x, Float64List y, Float64List out, double a) {
+  for (int i = 0; i < out.length; i++) {
+    out[i] = a * x[i] + y[i];
+  }
+}
+
+void negateSqrt(Float64List x, Float64List out) {
+  for (int i = 0; i < out.length; i++) {
+    out[i] = -math.sqrt(x[i]);
+  }
+}
+
+void copyBytes(Uint8List from, Uint8List to, int n) {
+  for (int i = 0; i < n; i++) {
+    to[i] = from[i];
+  }
+}
+
+void copyToClamped(Int8List from, Uint8ClampedList to) {
+  for (int i = 0; i < to.length; i++) {
+    to[i] = from[i];
+  }
+}
+
+void copyInts(Int32List from, Uint32List to) {
+  for (int i = 0; i < to.length; i++) {
+    to[i] = from[i];
+  }
+}
+
+void copyRange(Uint8List from, Uint8List to, int start, int end) {
+  for (int i = start; i < end; i++) {
+    to[i] = from[i];
+  }
+}
+
+void copyFromMinusFour(Uint8List from, Uint8List to) {
+  for (int i = -4; i < to.length; i++) {
+    to[i] = from[i];
+  }
+}
+
+// 2^62 - 2, close to the largest Smi on 64-bit platforms.
+const int nearSmiMax = 0x3ffffffffffffffe;
+
+void copyNearSmiMax(Uint8List from, Uint8List to) {
+  for (int i = nearSmiMax; i < nearSmiMax + 20; i++) {
+    to[i] = from[i];
+  }
+}
+
+void testArithmetic() {
+  for (int n = 0; n < 20; n++) {
+    final x = new Float64List(n);
+    final y = new Float64List(n);
+    for (int i = 0; i < n; i++) {
+      x[i] = i * 1.5;
+      y[i] = -i / 3;
+    }
+    final out = new Float64List(n);
+    axpy(x, y, out, 0.1);
+    for (int i = 0; i < n; i++) {
+      Expect.equals(0.1 * x[i] + y[i], out[i]);
+    }
+
+    // In place: the output aliases an input at the same index.
+    axpy(x, y, y, 2.0);
+    for (int i = 0; i < n; i++) {
+      Expect.equals(2.0 * x[i] + -i / 3, y[i]);
+    }
+
+    negateSqrt(x, out);
+    for (int i = 0; i < n; i++) {
+      Expect.equals(-math.sqrt(x[i]), out[i]);
+    }
+  }
+  final nan = new Float64List.fromList([double.nan, -0.0, double.infinity]);
+  final out = new Float64List(3);
+  negateSqrt(nan, out);
+  Expect.isTrue(out[0].isNaN);
+  Expect.equals(0.0, out[1]);
+  Expect.isFalse(out[1].isNegative);  // -sqrt(-0.0) is 0.0
+  Expect.equals(double.negativeInfinity, out[2]);
+}
+
+void testCopies() {
+  for (int n = 0; n < 40; n++) {
+    final from = new Uint8List(n);
+    for (int i = 0; i < n; i++) {
+      from[i] = 255 - i;
+    }
+    final to = new Uint8List(n);
+    copyBytes(from, to, n);
+    Expect.listEquals(from, to);
+
+    final signed = new Int8List(n);
+    for (int i = 0; i < n; i++) {
+      signed[i] = i - 20;
+    }
+    final clamped = new Uint8ClampedList(n);
+    copyToClamped(signed, clamped);
+    for (int i = 0; i < n; i++) {
+      Expect.equals(math.max(0, i - 20), clamped[i]);
+    }
+
+    final ints = new Int32List(n);
+    for (int i = 0; i < n; i++) {
+      ints[i] = -i;
+    }
+    final uints = new Uint32List(n);
+    copyInts(ints, uints);
+    for (int i = 0; i < n; i++) {
+      Expect.equals((-i) & 0xffffffff, uints[i]);
+    }
+  }
+}
+
+void testOutOfBounds() {
+  // The source is shorter than the loop bound: every element before the
+  // failing index must have been copied when the error is thrown.
+  for (int n = 0; n < 40; n++) {
+    final from = new Uint8List(n);
+    for (int i = 0; i < n; i++) {
+      from[i] = i + 1;
+    }
+    final to = new Uint8List(n + 5);
+    Expect.throws(() => copyBytes(from, to, n + 5), (e) => e is RangeError);
+    for (int i = 0; i < n; i++) {
+      Expect.equals(i + 1, to[i]);
+    }
+    Expect.equals(0, to[n]);
+  }
+}
+
+void testStarts() {
+  final from = new Uint8List.fromList(new List<int>.generate(40, (i) => i + 1));
+  for (int start = 0; start < 8; start++) {
+    final to = new Uint8List(40);
+    copyRange(from, to, start, 40);
+    for (int i = 0; i < 40; i++) {
+      Expect.equals(i < start ? 0 : i + 1, to[i]);
+    }
+  }
+
+  // Starting below zero must throw before any element is written.
+  final to = new Uint8List(40);
+  Expect.throws(() => copyRange(from, to, -4, 40), (e) => e is RangeError);
+  Expect.throws(() => copyFromMinusFour(from, to), (e) => e is RangeError);
+  Expect.throws(() => copyNearSmiMax(from, to), (e) => e is RangeError);
+  Expect.throws(() => copyRange(from, to, nearSmiMax, nearSmiMax + 20),
+      (e) => e is RangeError);
+  for (int i = 0; i < 40; i++) {
+    Expect.equals(0, to[i]);
+  }
+}
+
+main() {
+  for (int i = 0; i < 20; i++) {
+    testArithmetic();
+    testCopies();
+    testOutOfBounds();
+    testStarts();
+  }
+}
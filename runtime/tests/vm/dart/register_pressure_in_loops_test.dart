@@ -0,0 +1,91 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization-counter-threshold=10 --no-use-osr --no-background-compilation
+
+// Test that values spilled around loops, values sharing spill slots and
+// values reloaded at joins keep their values in optimized code.
+
+import "package:expect/expect.dart";
+
+@pragma('vm:never-inline')
+int opaque(int x) => x;
+
+@pragma('vm:never-inline')
+double opaqueDouble(double x) => x;
+
+// Many values are live across the loop but only used after it, while the
+// loop body needs all registers for a call.
+int liveAcrossLoop(int a, int b, int n) {
+  final int v0 = a + 1, v1 = a + 2, v2 = a + 3, v3 = a + 4;
+  final int v4 = b + 5, v5 = b + 6, v6 = b + 7, v7 = b + 8;
+  final double d0 = a * 0.5, d1 = b * 0.25;
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    sum += opaque(i) * (i & 3);
+  }
+  return sum + v0 + v1 + v2 + v3 + v4 + v5 + v6 + v7 + (d0 + d1).toInt();
+}
+
+// Short lived values in different arms of a branch can share spill slots.
+int disjointValues(int a, int b, bool flag) {
+  int result;
+  if (flag) {
+    final int x0 = opaque(a), x1 = opaque(a + 1), x2 = opaque(a + 2);
+    result = opaque(x0) + x1 * x2;
+  } else {
+    final int y0 = opaque(b), y1 = opaque(b + 1), y2 = opaque(b + 2);
+    result = opaque(y0) - y1 * y2;
+  }
+  return result + a - b;
+}
+
+// A value spilled in both arms of a branch is used after the join.
+double reloadAtJoin(double x, int n) {
+  final double scale = opaqueDouble(x);
+  double acc = 0.0;
+  for (int i = 0; i < n; i++) {
+    if (i.isEven) {
+      acc += opaqueDouble(i.toDouble());
+    } else {
+      acc -= opaqueDouble(1.0);
+    }
+    acc *= scale;
+  }
+  return acc;
+}
+
+// Nested loops where the outer loop needs the values in registers and the
+// inner loop does not.
+int nestedLoops(List<int> list, int m) {
+  int outer = 0;
+  for (int j = 0; j < m; j++) {
+    final int base = list[j % list.length];
+    int inner = 0;
+    for (int i = 0; i < list.length; i++) {
+      inner += opaque(list[i]);
+    }
+    outer += base * inner;
+  }
+  return outer;
+}
+
+double referenceReloadAtJoin(double x, int n) {
+  double acc = 0.0;
+  for (int i = 0; i < n; i++) {
+    acc = (i.isEven ? acc + i : acc - 1.0) * x;
+  }
+  return acc;
+}
+
+main() {
+  final list = [1, 2, 3, 4, 5];
+  for (int k = 0; k < 50; k++) {
+    Expect.equals(7716, liveAcrossLoop(10, 20, 100));
+    Expect.equals(65, disjointValues(6, 3, true));
+    Expect.equals(-14, disjointValues(6, 3, false));
+    Expect.equals(referenceReloadAtJoin(0.5, 10), reloadAtJoin(0.5, 10));
+    Expect.equals(270, nestedLoops(list, 7));
+  }
+}
@@ -0,0 +1,107 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization-counter-threshold=10 --no-background-compilation
+
+// Test that TransferableTypedData.detach copies the bytes of a list and
+// leaves the list usable, also in optimized code.
+
+import 'dart:async';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import "package:expect/expect.dart";
+
+echo(SendPort sendPort) {
+  final port = ReceivePort();
+  sendPort.send(port.sendPort);
+  port.listen((message) {
+    final list = (message as TransferableTypedData).materialize().asUint8List();
+    for (int i = 0; i < list.length; i++) {
+      list[i]++;
+    }
+    sendPort.send(TransferableTypedData.detach(list));
+    Expect.equals(3, list.length);
+    port.close();
+  });
+}
+
+testCopies() {
+  final materialized = TransferableTypedData.fromList(<Uint8List>[
+    Uint8List.fromList(<int>[1, 2, 3])
+  ]).materialize().asUint8List();
+  final fromMaterialized = TransferableTypedData.detach(materialized);
+  Expect.listEquals(<int>[1, 2, 3], materialized);
+  Expect.listEquals(
+      <int>[1, 2, 3], fromMaterialized.materialize().asUint8List());
+
+  final heap = Uint8List.fromList(<int>[4, 5, 6]);
+  final fromHeap = TransferableTypedData.detach(heap);
+  Expect.listEquals(<int>[4, 5, 6], heap);
+  Expect.listEquals(<int>[4, 5, 6], fromHeap.materialize().asUint8List());
+
+  final partial = materialized.buffer.asUint8List(1);
+  final fromView = TransferableTypedData.detach(partial);
+  Expect.listEquals(<int>[2, 3], fromView.materialize().asUint8List());
+
+  final empty = TransferableTypedData.detach(Uint8List(0));
+  Expect.equals(0, empty.materialize().lengthInBytes);
+  Expect.throwsArgumentError(() => TransferableTypedData.detach(null));
+}
+
+// Writes to [list] after each detach. Once optimized, this keeps the length
+// and data of [list] that were loaded before the call.
+int writeAfterDetach(Uint8List list, List<TransferableTypedData> detached) {
+  int sum = 0;
+  for (int i = 0; i < list.length; i++) {
+    detached.add(TransferableTypedData.detach(list));
+    list[i] = i;
+    sum += list[i];
+  }
+  return sum;
+}
+
+testUseAfterDetachInOptimizedCode() {
+  for (int round = 0; round < 50; round++) {
+    final list = TransferableTypedData.fromList(<Uint8List>[
+      Uint8List.fromList(List<int>.filled(8, 100))
+    ]).materialize().asUint8List();
+    final detached = <TransferableTypedData>[];
+    Expect.equals(28, writeAfterDetach(list, detached));
+    Expect.listEquals(<int>[0, 1, 2, 3, 4, 5, 6, 7], list);
+    // Each transferable holds the bytes as they were when it was detached.
+    for (int i = 0; i < detached.length; i++) {
+      final bytes = detached[i].materialize().asUint8List();
+      Expect.equals(8, bytes.length);
+      for (int j = 0; j < bytes.length; j++) {
+        Expect.equals(j < i ? j : 100, bytes[j]);
+      }
+    }
+  }
+}
+
+testRoundTrip() async {
+  final port = ReceivePort();
+  final inbox = StreamIterator<dynamic>(port);
+  await Isolate.spawn(echo, port.sendPort);
+  await inbox.moveNext();
+  final SendPort outbox = inbox.current;
+
+  final list = TransferableTypedData.fromList(<Uint8List>[
+    Uint8List.fromList(<int>[10, 20, 30])
+  ]).materialize().asUint8List();
+  outbox.send(TransferableTypedData.detach(list));
+  Expect.listEquals(<int>[10, 20, 30], list);
+
+  await inbox.moveNext();
+  final TransferableTypedData result = inbox.current;
+  Expect.listEquals(<int>[11, 21, 31], result.materialize().asUint8List());
+  port.close();
+}
+
+main() async {
+  testCopies();
+  testUseAfterDetachInOptimizedCode();
+  await testRoundTrip();
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Test that type feedback saved for a function is dropped when the function
+// was edited before the feedback is loaded, and kept for unchanged functions.
+
+import "dart:async";
+import "dart:io";
+
+import "package:expect/expect.dart";
+import "package:path/path.dart" as p;
+
+import "snapshot_test_helper.dart";
+
+const String programMain = """
+main() {
+  print(fib(30));
+}
+""";
+
+// Both versions start at the same position and compute the same values.
+const String originalFib = """
+int fib(int n) {
+  if (n <= 1) return 1;
+  return fib(n - 1) + fib(n - 2);
+}
+""";
+
+const String editedFib = """
+int fib(int n) {
+  if (n < 2) return 1;
+  return fib(n - 2) + fib(n - 1);
+}
+""";
+
+Future<void> main() async {
+  if (!Platform.script.toString().endsWith(".dart")) {
+    print("This test must run from source");
+    return;
+  }
+
+  await withTempDir((String tmp) async {
+    final String programPath = p.join(tmp, "program.dart");
+    final String feedbackPath = p.join(tmp, "type_feedback.bin");
+
+    File(programPath).writeAsStringSync(programMain + originalFib);
+    final result1 = await runDart("generate type feedback", [
+      "--save_type_feedback=$feedbackPath",
+      programPath,
+    ]);
+    expectOutput("1346269", result1);
+
+    File(programPath).writeAsStringSync(programMain + editedFib);
+    final result2 = await runDart("use stale type feedback", [
+      "--load_type_feedback=$feedbackPath",
+      "--trace_compilation_trace",
+      programPath,
+    ]);
+    final String stdout = result2.processResult.stdout;
+    Expect.isTrue(stdout.contains("Changed function fib"));
+    Expect.isFalse(stdout.contains("Changed function main"));
+    Expect.isTrue(stdout.contains("1346269"));
+  });
+}
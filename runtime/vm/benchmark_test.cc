@@ -15,6 +15,7 @@
 
 #include "vm/clustered_snapshot.h"
 #include "vm/dart_api_impl.h"
+#include "vm/random.h"
 #include "vm/stack_frame.h"
 #include "vm/timer.h"
 
@@ -22,6 +23,9 @@ using dart::bin::File;
 
 namespace dart {
 
+DECLARE_FLAG(bool, inline_hottest_receivers);
+DECLARE_FLAG(bool, use_huge_pages);
+
 Benchmark* Benchmark::first_ = NULL;
 Benchmark* Benchmark::tail_ = NULL;
 const char* Benchmark::executable_ = NULL;
@@ -195,9 +199,14 @@ BENCHMARK(GenKernelKernelMaxRSS) {
 //
 // Measure creation of core isolate from a snapshot.
 //
-BENCHMARK(CorelibIsolateStartup) {
+static void CorelibIsolateStartup(Benchmark* benchmark,
+                                  Thread* thread,
+                                  bool parallel_fill,
+                                  const char* name) {
   const int kNumIterations = 1000;
-  Timer timer(true, "CorelibIsolateStartup");
+  const bool saved_parallel_snapshot_fill = FLAG_parallel_snapshot_fill;
+  FLAG_parallel_snapshot_fill = parallel_fill;
+  Timer timer(true, name);
   Isolate* isolate = thread->isolate();
   Dart_ExitIsolate();
   for (int i = 0; i < kNumIterations; i++) {
@@ -208,6 +217,16 @@ BENCHMARK(CorelibIsolateStartup) {
   }
   benchmark->set_score(timer.TotalElapsedTime() / kNumIterations);
   Dart_EnterIsolate(reinterpret_cast<Dart_Isolate>(isolate));
+  FLAG_parallel_snapshot_fill = saved_parallel_snapshot_fill;
+}
+
+BENCHMARK(CorelibIsolateStartup) {
+  CorelibIsolateStartup(benchmark, thread, false, "CorelibIsolateStartup");
+}
+
+BENCHMARK(CorelibIsolateStartupParallelFill) {
+  CorelibIsolateStartup(benchmark, thread, true,
+                        "CorelibIsolateStartupParallelFill");
 }
 
 //
@@ -738,6 +757,134 @@ BENCHMARK(LargeMap) {
   benchmark->set_score(elapsed_time);
 }
 
+// Measures marking of a large old-space object graph whose edges point to
+// random pages, which is dominated by TLB misses on large heaps.
+static void MarkLargeGraph(Benchmark* benchmark,
+                           Thread* thread,
+                           bool use_huge_pages,
+                           const char* name) {
+  const bool saved_use_huge_pages = FLAG_use_huge_pages;
+  FLAG_use_huge_pages = use_huge_pages;
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  HANDLESCOPE(thread);
+  const intptr_t kNumNodes = 1 * MB;
+  const intptr_t kNumEdges = 4;
+  const Array& nodes = Array::Handle(Array::New(kNumNodes, Heap::kOld));
+  Array& node = Array::Handle();
+  for (intptr_t i = 0; i < kNumNodes; i++) {
+    node = Array::New(kNumEdges, Heap::kOld);
+    nodes.SetAt(i, node);
+  }
+  Random random(42);
+  Object& target = Object::Handle();
+  for (intptr_t i = 0; i < kNumNodes; i++) {
+    node ^= nodes.At(i);
+    for (intptr_t j = 0; j < kNumEdges; j++) {
+      target = nodes.At(random.NextUInt32() % kNumNodes);
+      node.SetAt(j, target);
+    }
+  }
+  Heap* heap = thread->heap();
+  heap->CollectAllGarbage();
+  const intptr_t kLoopCount = 10;
+  Timer timer(true, name);
+  timer.Start();
+  for (intptr_t i = 0; i < kLoopCount; i++) {
+    heap->CollectAllGarbage();
+  }
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+  FLAG_use_huge_pages = saved_use_huge_pages;
+}
+
+BENCHMARK(MarkLargeGraph) {
+  MarkLargeGraph(benchmark, thread, false, "Mark large graph");
+}
+
+BENCHMARK(MarkLargeGraphHugePages) {
+  MarkLargeGraph(benchmark, thread, true, "Mark large graph, huge pages");
+}
+
+// Measures dispatch throughput of a call site with ten receiver classes,
+// where four classes receive 92% of the calls, like the hot call sites of
+// visitors and AST walkers.
+static void SkewedPolymorphicDispatch(Benchmark* benchmark,
+                                      bool inline_hottest_receivers,
+                                      const char* name) {
+  const int kNumIterations = 100000;
+  const char* kScriptChars =
+      "abstract class Node { int visit(int x); }\n"
+      "class N0 extends Node { int visit(int x) => x + 0; }\n"
+      "class N1 extends Node { int visit(int x) => x ^ 1; }\n"
+      "class N2 extends Node { int visit(int x) => x + 2; }\n"
+      "class N3 extends Node { int visit(int x) => x ^ 3; }\n"
+      "class N4 extends Node { int visit(int x) => x + 4; }\n"
+      "class N5 extends Node { int visit(int x) => x ^ 5; }\n"
+      "class N6 extends Node { int visit(int x) => x + 6; }\n"
+      "class N7 extends Node { int visit(int x) => x ^ 7; }\n"
+      "class N8 extends Node { int visit(int x) => x + 8; }\n"
+      "class N9 extends Node { int visit(int x) => x ^ 9; }\n"
+      "\n"
+      "final List<Node> nodes = () {\n"
+      "  final all = <Node>[N0(), N1(), N2(), N3(), N4(), N5(), N6(), N7(),\n"
+      "                     N8(), N9()];\n"
+      "  const counts = const <int>[40, 25, 15, 12, 2, 2, 1, 1, 1, 1];\n"
+      "  final list = <Node>[];\n"
+      "  for (int i = 0; i < all.length; i++) {\n"
+      "    for (int j = 0; j < counts[i]; j++) list.add(all[i]);\n"
+      "  }\n"
+      "  // Interleave the receivers.\n"
+      "  return new List<Node>.generate(100, (i) => list[(i * 37) % 100]);\n"
+      "}();\n"
+      "\n"
+      "int benchmark(int count) {\n"
+      "  final list = nodes;\n"
+      "  int x = 0;\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    for (int j = 0; j < list.length; j++) {\n"
+      "      x = list[j].visit(x);\n"
+      "    }\n"
+      "  }\n"
+      "  return x;\n"
+      "}\n";
+
+  const bool saved_inline_hottest_receivers = FLAG_inline_hottest_receivers;
+  const bool saved_background_compilation = FLAG_background_compilation;
+  FLAG_inline_hottest_receivers = inline_hottest_receivers;
+  // Make sure the benchmark runs optimized code after the warmup.
+  FLAG_background_compilation = false;
+
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kNumIterations);
+
+  // Warmup first to avoid compilation jitters.
+  Dart_Handle result = Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  EXPECT_VALID(result);
+
+  Timer timer(true, name);
+  timer.Start();
+  result = Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  EXPECT_VALID(result);
+  timer.Stop();
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+
+  FLAG_background_compilation = saved_background_compilation;
+  FLAG_inline_hottest_receivers = saved_inline_hottest_receivers;
+}
+
+BENCHMARK(SkewedPolymorphicDispatch) {
+  SkewedPolymorphicDispatch(benchmark, true, "Skewed polymorphic dispatch");
+}
+
+BENCHMARK(SkewedPolymorphicDispatchMegamorphic) {
+  SkewedPolymorphicDispatch(benchmark, false,
+                            "Skewed polymorphic dispatch, megamorphic");
+}
+
 BENCHMARK_MEMORY(InitialRSS) {
   benchmark->set_score(bin::Process::MaxRSS());
 }
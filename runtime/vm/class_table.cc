@@ -15,6 +15,16 @@
 namespace dart {
 
 DEFINE_FLAG(bool, print_class_table, false, "Print initial class table.");
+DEFINE_FLAG(int,
+            pretenure_threshold,
+            80,
+            "Percentage of a class's new-space instances that must survive a "
+            "new GC for the class to be allocated in old space.");
+DEFINE_FLAG(int,
+            pretenure_min_count,
+            1000,
+            "Minimum number of a class's instances in new space before its "
+            "survival rate is used to decide about pretenuring.");
 
 ClassTable::ClassTable()
     : top_(kNumPredefinedCids),
@@ -366,6 +376,14 @@ void ClassHeapStats::UpdatePromotedAfterNewGC() {
   promoted_size = recent.old_size - old_pre_new_gc_size_;
 }
 
+double ClassHeapStats::SurvivalRateAfterNewGC() const {
+  if (pre_gc.new_count == 0) {
+    return 0.0;
+  }
+  const intptr_t survivors = post_gc.new_count + promoted_count;
+  return static_cast<double>(survivors) / pre_gc.new_count;
+}
+
 void ClassHeapStats::PrintToJSONObject(const Class& cls,
                                        JSONObject* obj,
                                        bool internal) const {
@@ -430,11 +448,13 @@ void ClassHeapStats::PrintToJSONObject(const Class& cls,
   obj->AddProperty64("bytesCurrent", bytes_current);
 }
 
-void ClassTable::UpdateAllocatedOldGC(intptr_t cid, intptr_t size) {
+void ClassTable::UpdateAllocatedOldGC(intptr_t cid,
+                                      intptr_t size,
+                                      intptr_t count) {
   ClassHeapStats* stats = PreliminaryStatsAt(cid);
   ASSERT(stats != NULL);
   ASSERT(size != 0);
-  stats->recent.AddOldGC(size);
+  stats->recent.AddOldGC(size, count);
 }
 
 void ClassTable::UpdateAllocatedExternalNew(intptr_t cid, intptr_t size) {
@@ -474,6 +494,10 @@ ClassHeapStats* ClassTable::StatsWithUpdatedSize(intptr_t cid) {
 void ClassTable::ResetCountersOld() {
   for (intptr_t i = 0; i < top_; i++) {
     class_heap_stats_table_[i].ResetAtOldGC();
+    // Pretenuring decisions are only revisited while instances are allocated
+    // in new space, so forget them at every old GC. Classes whose instances
+    // still survive get pretenured again after the next new GC.
+    class_heap_stats_table_[i].set_pretenure(false);
   }
 }
 
@@ -489,6 +513,31 @@ void ClassTable::UpdatePromoted() {
   }
 }
 
+bool ClassTable::CanPretenureClassId(intptr_t cid) {
+  // Only classes whose slow-path allocation goes through the AllocateObject,
+  // AllocateArray or AllocateContext runtime entries. Other predefined
+  // classes would just lose their inline allocation.
+  return (cid == kArrayCid) || (cid == kContextCid) ||
+         (cid >= kNumPredefinedCids);
+}
+
+void ClassTable::UpdatePretenuring() {
+  if (!FLAG_use_pretenuring) {
+    return;
+  }
+  const double threshold = FLAG_pretenure_threshold / 100.0;
+  for (intptr_t i = 1; i < top_; i++) {
+    ClassHeapStats* stats = &class_heap_stats_table_[i];
+    if (stats->pretenure() || !CanPretenureClassId(i) ||
+        (stats->pre_gc.new_count < FLAG_pretenure_min_count)) {
+      continue;
+    }
+    if (stats->SurvivalRateAfterNewGC() >= threshold) {
+      stats->set_pretenure(true);
+    }
+  }
+}
+
 intptr_t ClassTable::ClassOffsetFor(intptr_t cid) {
   return cid * sizeof(ClassHeapStats);  // NOLINT
 }
@@ -580,11 +629,11 @@ void ClassTable::UpdateLiveNew(intptr_t cid, intptr_t size) {
   stats->post_gc.AddNew(size);
 }
 
-void ClassTable::UpdateLiveNewGC(intptr_t cid, intptr_t size) {
+void ClassTable::UpdateLiveNewGC(intptr_t cid, intptr_t size, intptr_t count) {
   ClassHeapStats* stats = PreliminaryStatsAt(cid);
   ASSERT(stats != NULL);
   ASSERT(size >= 0);
-  stats->post_gc.AddNewGC(size);
+  stats->post_gc.AddNewGC(size, count);
 }
 
 void ClassTable::UpdateLiveOldExternal(intptr_t cid, intptr_t size) {
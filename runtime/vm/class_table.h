@@ -62,8 +62,8 @@ class AllocStats {
     AtomicOperations::IncrementBy(&new_size, size);
   }
 
-  void AddNewGC(T size) {
-    new_count += 1;
+  void AddNewGC(T size, T count = 1) {
+    new_count += count;
     new_size += size;
   }
 
@@ -149,6 +149,11 @@ class ClassHeapStats {
   }
   static intptr_t state_offset() { return OFFSET_OF(ClassHeapStats, state_); }
   static intptr_t TraceAllocationMask() { return (1 << kTraceAllocationBit); }
+  // Generated code leaves inline allocation to the runtime if any of these
+  // bits are set.
+  static intptr_t SlowPathAllocationMask() {
+    return (1 << kTraceAllocationBit) | (1 << kPretenureBit);
+  }
 
   void Initialize();
   void ResetAtNewGC();
@@ -169,13 +174,25 @@ class ClassHeapStats {
     state_ = TraceAllocationBit::update(trace_allocation, state_);
   }
 
+  bool pretenure() const { return PretenureBit::decode(state_); }
+
+  void set_pretenure(bool pretenure) {
+    state_ = PretenureBit::update(pretenure, state_);
+  }
+
+  // Fraction of the instances in new space at the start of the last new GC
+  // that survived it.
+  double SurvivalRateAfterNewGC() const;
+
  private:
   enum StateBits {
     kTraceAllocationBit = 0,
+    kPretenureBit = 1,
   };
 
   class TraceAllocationBit
       : public BitField<intptr_t, bool, kTraceAllocationBit, 1> {};
+  class PretenureBit : public BitField<intptr_t, bool, kPretenureBit, 1> {};
 
   // Recent old at start of last new GC (used to compute promoted_*).
   intptr_t old_pre_new_gc_count_;
@@ -286,7 +303,7 @@ class ClassTable {
     ASSERT(size != 0);
     stats->recent.AddOld(size);
   }
-  void UpdateAllocatedOldGC(intptr_t cid, intptr_t size);
+  void UpdateAllocatedOldGC(intptr_t cid, intptr_t size, intptr_t count = 1);
   void UpdateAllocatedExternalNew(intptr_t cid, intptr_t size);
   void UpdateAllocatedExternalOld(intptr_t cid, intptr_t size);
 
@@ -296,6 +313,9 @@ class ClassTable {
   void ResetCountersNew();
   // Called immediately after a new GC.
   void UpdatePromoted();
+  // Called immediately after a new GC. Marks classes whose instances mostly
+  // survive new GCs for allocation in old space.
+  void UpdatePretenuring();
 
   // Used by the generated code.
   static intptr_t class_heap_stats_table_offset() {
@@ -326,6 +346,16 @@ class ClassTable {
     ClassHeapStats* stats = PreliminaryStatsAt(cid);
     return stats->trace_allocation();
   }
+
+  // Whether the runtime should allocate new instances of cid in old space.
+  bool ShouldPretenure(intptr_t cid) {
+    ClassHeapStats* stats = PreliminaryStatsAt(cid);
+    return stats->pretenure();
+  }
+  void SetPretenureFor(intptr_t cid, bool pretenure) {
+    ClassHeapStats* stats = PreliminaryStatsAt(cid);
+    stats->set_pretenure(pretenure);
+  }
 #endif  // !PRODUCT
 
   void AddOldTable(ClassAndSize* old_table);
@@ -344,6 +374,7 @@ class ClassTable {
   static const int capacity_increment_ = 256;
 
   static bool ShouldUpdateSizeForClassId(intptr_t cid);
+  static bool CanPretenureClassId(intptr_t cid);
 
   intptr_t top_;
   intptr_t capacity_;
@@ -363,7 +394,7 @@ class ClassTable {
   }
   void UpdateLiveOld(intptr_t cid, intptr_t size, intptr_t count = 1);
   void UpdateLiveNew(intptr_t cid, intptr_t size);
-  void UpdateLiveNewGC(intptr_t cid, intptr_t size);
+  void UpdateLiveNewGC(intptr_t cid, intptr_t size, intptr_t count = 1);
   void UpdateLiveOldExternal(intptr_t cid, intptr_t size);
   void UpdateLiveNewExternal(intptr_t cid, intptr_t size);
 #endif  // !PRODUCT
@@ -13,12 +13,15 @@
 #include "vm/dart.h"
 #include "vm/heap/heap.h"
 #include "vm/image_snapshot.h"
+#include "vm/lockers.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
+#include "vm/os.h"
 #include "vm/program_visitor.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
+#include "vm/thread_pool.h"
 #include "vm/timeline.h"
 #include "vm/version.h"
 
@@ -201,6 +204,9 @@ class ClassDeserializationCluster : public DeserializationCluster {
   ClassDeserializationCluster() {}
   ~ClassDeserializationCluster() {}
 
+  // Registers the classes in the isolate's class table.
+  bool CanFillConcurrently() const { return false; }
+
   void ReadAlloc(Deserializer* d) {
     predefined_start_index_ = d->next_index();
     PageSpace* old_space = d->heap()->old_space();
@@ -3954,6 +3960,9 @@ class LinkedHashMapDeserializationCluster : public DeserializationCluster {
   LinkedHashMapDeserializationCluster() {}
   ~LinkedHashMapDeserializationCluster() {}
 
+  // Allocates the backing data arrays.
+  bool CanFillConcurrently() const { return false; }
+
   void ReadAlloc(Deserializer* d) {
     start_index_ = d->next_index();
     PageSpace* old_space = d->heap()->old_space();
@@ -4775,7 +4784,17 @@ void Serializer::Serialize() {
   for (intptr_t cid = 1; cid < num_cids_; cid++) {
     SerializationCluster* cluster = clusters_by_cid_[cid];
     if (cluster != NULL) {
+      // Each fill section is prefixed with its length so the reader can find
+      // all of them up front and fill clusters out of order.
+      const intptr_t length_position = stream_.Position();
+      uint32_t length = 0;
+      stream_.WriteBytes(&length, sizeof(length));
       cluster->WriteAndMeasureFill(this);
+      const intptr_t end_position = stream_.Position();
+      length = end_position - length_position - sizeof(length);
+      stream_.SetPosition(length_position);
+      stream_.WriteBytes(&length, sizeof(length));
+      stream_.SetPosition(end_position);
 #if defined(DEBUG)
       Write<int32_t>(kSectionMarker);
 #endif
@@ -4983,6 +5002,23 @@ Deserializer::Deserializer(Thread* thread,
   stream_.SetPosition(offset);
 }
 
+Deserializer::Deserializer(const Deserializer& parent, intptr_t position)
+    : ThreadStackResource(NULL),
+      heap_(parent.heap_),
+      zone_(NULL),
+      kind_(parent.kind_),
+      stream_(parent.stream_.buffer(), parent.stream_.size()),
+      image_reader_(parent.image_reader_),
+      num_base_objects_(parent.num_base_objects_),
+      num_objects_(parent.num_objects_),
+      num_clusters_(0),
+      code_order_length_(parent.code_order_length_),
+      refs_(parent.refs_),
+      next_ref_index_(parent.next_ref_index_),
+      clusters_(NULL) {
+  stream_.SetPosition(position);
+}
+
 Deserializer::~Deserializer() {
   delete[] clusters_;
 }
@@ -5259,6 +5295,8 @@ void Deserializer::Deserialize() {
            num_base_objects_, next_ref_index_ - 1);
   }
 
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+
   for (intptr_t i = 0; i < num_clusters_; i++) {
     clusters_[i] = ReadCluster();
     clusters_[i]->ReadAlloc(this);
@@ -5271,13 +5309,116 @@ void Deserializer::Deserialize() {
   // We should have completely filled the ref array.
   ASSERT((next_ref_index_ - 1) == num_objects_);
 
+  const int64_t alloc_end = OS::GetCurrentMonotonicMicros();
+
+  intptr_t* positions = zone_->Alloc<intptr_t>(num_clusters_);
+  intptr_t* sizes = zone_->Alloc<intptr_t>(num_clusters_);
   for (intptr_t i = 0; i < num_clusters_; i++) {
-    clusters_[i]->ReadFill(this);
+    uint32_t length;
+    ReadBytes(reinterpret_cast<uint8_t*>(&length), sizeof(length));
+    positions[i] = stream_.Position();
+    sizes[i] = length;
+    Advance(length);
 #if defined(DEBUG)
     int32_t section_marker = Read<int32_t>();
     ASSERT(section_marker == kSectionMarker);
 #endif
   }
+  const intptr_t end_position = stream_.Position();
+
+  const intptr_t num_parallel = ReadFills(positions, sizes);
+  stream_.SetPosition(end_position);
+
+  if (FLAG_print_snapshot_load_times) {
+    const int64_t fill_end = OS::GetCurrentMonotonicMicros();
+    OS::PrintErr("Snapshot %s: %" Pd " objects, %" Pd " clusters\n",
+                 Snapshot::KindToCString(kind_), num_objects_, num_clusters_);
+    OS::PrintErr("  Alloc: %" Pd64 " us\n", alloc_end - start);
+    OS::PrintErr("  Fill: %" Pd64 " us (%" Pd " clusters on helper threads)\n",
+                 fill_end - alloc_end, num_parallel);
+  }
+}
+
+namespace {
+
+class FillClusterTask : public ThreadPool::Task {
+ public:
+  FillClusterTask(const Deserializer* parent,
+                  DeserializationCluster* cluster,
+                  intptr_t position,
+                  Monitor* monitor,
+                  intptr_t* pending)
+      : parent_(parent),
+        cluster_(cluster),
+        position_(position),
+        monitor_(monitor),
+        pending_(pending) {}
+
+  virtual void Run() {
+    {
+      Deserializer d(*parent_, position_);
+      cluster_->ReadFill(&d);
+    }
+    MonitorLocker ml(monitor_);
+    if (--(*pending_) == 0) {
+      ml.Notify();
+    }
+  }
+
+ private:
+  const Deserializer* parent_;
+  DeserializationCluster* cluster_;
+  intptr_t position_;
+  Monitor* monitor_;
+  intptr_t* pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(FillClusterTask);
+};
+
+}  // namespace
+
+intptr_t Deserializer::ReadFills(intptr_t* positions, const intptr_t* sizes) {
+  // Sections smaller than this are cheaper to fill than to hand off.
+  const intptr_t kMinParallelFillSize = 64 * KB;
+
+  Monitor monitor;
+  intptr_t pending = 0;
+  intptr_t num_parallel = 0;
+  if (FLAG_parallel_snapshot_fill && (Dart::thread_pool() != NULL)) {
+    for (intptr_t i = 0; i < num_clusters_; i++) {
+      if ((sizes[i] < kMinParallelFillSize) ||
+          !clusters_[i]->CanFillConcurrently()) {
+        continue;
+      }
+      {
+        MonitorLocker ml(&monitor);
+        pending++;
+      }
+      if (Dart::thread_pool()->Run<FillClusterTask>(this, clusters_[i],
+                                                    positions[i], &monitor,
+                                                    &pending)) {
+        positions[i] = -1;
+        num_parallel++;
+      } else {
+        MonitorLocker ml(&monitor);
+        pending--;
+      }
+    }
+  }
+
+  // Fill the remaining clusters while the helpers are running.
+  for (intptr_t i = 0; i < num_clusters_; i++) {
+    if (positions[i] == -1) continue;
+    stream_.SetPosition(positions[i]);
+    clusters_[i]->ReadFill(this);
+    ASSERT(stream_.Position() == positions[i] + sizes[i]);
+  }
+
+  MonitorLocker ml(&monitor);
+  while (pending > 0) {
+    ml.Wait();
+  }
+  return num_parallel;
 }
 
 class HeapLocker : public StackResource {
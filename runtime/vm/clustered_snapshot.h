@@ -92,6 +92,11 @@ class DeserializationCluster : public ZoneAllocated {
   // Initialize the cluster's objects. Do not touch the memory of other objects.
   virtual void ReadFill(Deserializer* deserializer) = 0;
 
+  // Whether ReadFill may run on a helper thread concurrently with the fill of
+  // other clusters. Such a fill only stores into the cluster's own objects and
+  // must not allocate or use the isolate, thread or zone of the deserializer.
+  virtual bool CanFillConcurrently() const { return true; }
+
   // Complete any action that requires the full graph to be deserialized, such
   // as rehashing.
   virtual void PostLoad(const Array& refs, Snapshot::Kind kind, Zone* zone) {}
@@ -475,6 +480,10 @@ class Deserializer : public ThreadStackResource {
                const uint8_t* shared_data_buffer,
                const uint8_t* shared_instructions_buffer,
                intptr_t offset = 0);
+  // Creates a reader for the fill section of a single cluster, starting at
+  // [position] in the stream of [parent]. Used by helper threads during a
+  // parallel fill; it has no thread, isolate or zone.
+  Deserializer(const Deserializer& parent, intptr_t position);
   ~Deserializer();
 
   // Verifies the image alignment.
@@ -579,6 +588,11 @@ class Deserializer : public ThreadStackResource {
   intptr_t code_order_length() const { return code_order_length_; }
 
  private:
+  // Runs the fill of each cluster from its section of the stream, using the
+  // thread pool for large sections when --parallel_snapshot_fill is set.
+  // Returns the number of clusters filled on helper threads.
+  intptr_t ReadFills(intptr_t* positions, const intptr_t* sizes);
+
   Heap* heap_;
   Zone* zone_;
   Snapshot::Kind kind_;
@@ -18,6 +18,11 @@ namespace dart {
 #if !defined(DART_PRECOMPILED_RUNTIME)
 
 DEFINE_FLAG(bool, trace_compilation_trace, false, "Trace compilation trace.");
+DEFINE_FLAG(bool,
+            optimize_feedback_in_background,
+            false,
+            "Optimize functions with loaded type feedback on the background "
+            "compiler instead of before returning from loading.");
 
 CompilationTraceSaver::CompilationTraceSaver(Zone* zone)
     : buf_(zone, 1 * MB),
@@ -438,10 +443,15 @@ TypeFeedbackSaver::TypeFeedbackSaver(WriteStream* stream)
       call_sites_(Array::Handle()),
       call_site_(ICData::Handle()) {}
 
-// These flags affect deopt ids.
+// Bump this when the layout of the feedback changes, so that feedback in an
+// older layout is rejected instead of being misread.
+static const intptr_t kFeedbackFormatVersion = 2;
+
+// The feedback format, and the flags that affect deopt ids.
 static char* CompilerFlags() {
   TextBuffer buffer(64);
 
+  buffer.Printf("format-%" Pd, kFeedbackFormatVersion);
 #define ADD_FLAG(flag) buffer.AddString(FLAG_##flag ? " " #flag : " no-" #flag)
   ADD_FLAG(enable_asserts);
   ADD_FLAG(use_field_guards);
@@ -498,6 +508,7 @@ void TypeFeedbackSaver::SaveFields() {
       str_ = field_.name();
       str_ = String::RemovePrivateKey(str_);
       WriteString(str_);
+      WriteInt(field_.SourceFingerprint());
 
       WriteInt(field_.guarded_cid());
       WriteInt(field_.is_nullable());
@@ -519,6 +530,7 @@ void TypeFeedbackSaver::Visit(const Function& function) {
 
   WriteInt(function.kind());
   WriteInt(function.token_pos().value());
+  WriteInt(function.SourceFingerprint());
 
   code_ = function.CurrentCode();
   intptr_t usage = function.usage_counter();
@@ -637,11 +649,29 @@ RawObject* TypeFeedbackLoader::LoadFeedback(ReadStream* stream) {
     }
   }
 
+  Isolate* isolate = thread_->isolate();
+  const bool in_background =
+      FLAG_optimize_feedback_in_background && FLAG_background_compilation &&
+      (isolate->optimizing_background_compiler() != NULL) &&
+      !BackgroundCompiler::IsDisabled(isolate,
+                                      /* optimizing_compiler = */ true);
+  if (in_background) {
+    BackgroundCompiler::Start(isolate);
+  }
+
   while (functions_to_compile_.Length() > 0) {
     func_ ^= functions_to_compile_.RemoveLast();
 
     if (Compiler::CanOptimizeFunction(thread_, func_) &&
         (func_.usage_counter() >= FLAG_optimization_counter_threshold)) {
+      if (in_background && func_.is_background_optimizable()) {
+        // Like the runtime does when queueing, keep the counter far below
+        // the threshold so the function is not queued again, but offset it
+        // by the saved usage so the hottest functions are compiled first.
+        func_.SetUsageCounter(INT_MIN + func_.usage_counter());
+        isolate->optimizing_background_compiler()->Compile(func_);
+        continue;
+      }
       error_ = Compiler::CompileOptimizedFunction(thread_, func_);
       if (error_.IsError()) {
         return error_.raw();
@@ -747,6 +777,7 @@ RawObject* TypeFeedbackLoader::LoadFields() {
 
     for (intptr_t i = 0; i < num_fields; i++) {
       field_name_ = ReadString();
+      int32_t fingerprint = ReadInt();
       intptr_t guarded_cid = cid_map_[ReadInt()];
       intptr_t is_nullable = ReadInt();
 
@@ -769,6 +800,14 @@ RawObject* TypeFeedbackLoader::LoadFields() {
         }
         continue;
       }
+      if (field_.SourceFingerprint() != fingerprint) {
+        // The declaration changed since the feedback was saved, so the
+        // guarded state may no longer hold.
+        if (FLAG_trace_compilation_trace) {
+          THR_Print("Changed field %s\n", field_name_.ToCString());
+        }
+        continue;
+      }
 
       if (guarded_cid == kIllegalCid) {
         // Guarded CID from feedback is not in current program: assume the field
@@ -815,6 +854,7 @@ RawObject* TypeFeedbackLoader::LoadFunction() {
   func_name_ = ReadString();  // Without private mangling.
   RawFunction::Kind kind = static_cast<RawFunction::Kind>(ReadInt());
   intptr_t token_pos = ReadInt();
+  int32_t fingerprint = ReadInt();
   intptr_t usage = ReadInt();
   intptr_t inlining_depth = ReadInt();
   intptr_t num_call_sites = ReadInt();
@@ -827,6 +867,14 @@ RawObject* TypeFeedbackLoader::LoadFunction() {
         THR_Print("Missing function %s %s\n", func_name_.ToCString(),
                   Function::KindToCString(kind));
       }
+    } else if (func_.SourceFingerprint() != fingerprint) {
+      // The body changed since the feedback was saved: its call sites and
+      // counts may not correspond to the current code.
+      skip = true;
+      if (FLAG_trace_compilation_trace) {
+        THR_Print("Changed function %s %s\n", func_name_.ToCString(),
+                  Function::KindToCString(kind));
+      }
     }
   }
 
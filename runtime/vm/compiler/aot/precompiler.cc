@@ -151,6 +151,8 @@ Precompiler::Precompiler(Thread* thread)
       dropped_typearg_count_(0),
       dropped_type_count_(0),
       dropped_library_count_(0),
+      compile_time_micros_(0),
+      iterate_time_micros_(0),
       libraries_(GrowableObjectArray::Handle(I->object_store()->libraries())),
       pending_functions_(
           GrowableObjectArray::Handle(GrowableObjectArray::New())),
@@ -367,6 +369,11 @@ void Precompiler::DoCompileAll() {
     THR_Print(" %" Pd " type arguments,", dropped_typearg_count_);
     THR_Print(" %" Pd " classes,", dropped_class_count_);
     THR_Print(" %" Pd " libraries.\n", dropped_library_count_);
+
+    THR_Print("Spent %" Pd64 " ms reaching the fixed point, %" Pd64
+              " ms of it compiling functions.\n",
+              iterate_time_micros_ / kMicrosecondsPerMillisecond,
+              compile_time_micros_ / kMicrosecondsPerMillisecond);
   }
 }
 
@@ -437,6 +444,7 @@ void Precompiler::AddRoots() {
 }
 
 void Precompiler::Iterate() {
+  const int64_t start = OS::GetCurrentMonotonicMicros();
   Function& function = Function::Handle(Z);
 
   while (changed_) {
@@ -450,6 +458,8 @@ void Precompiler::Iterate() {
     CheckForNewDynamicFunctions();
     CollectCallbackFields();
   }
+
+  iterate_time_micros_ += OS::GetCurrentMonotonicMicros() - start;
 }
 
 void Precompiler::CollectCallbackFields() {
@@ -531,7 +541,9 @@ void Precompiler::ProcessFunction(const Function& function) {
     ASSERT(!function.is_abstract());
     ASSERT(!function.IsRedirectingFactory());
 
+    const int64_t start = OS::GetCurrentMonotonicMicros();
     error_ = CompileFunction(this, thread_, zone_, function);
+    compile_time_micros_ += OS::GetCurrentMonotonicMicros() - start;
     if (!error_.IsNull()) {
       Jump(error_);
     }
@@ -2331,6 +2343,9 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         // At the moment we are leaking CodeStatistics objects for
         // simplicity because this is just a development mode flag.
         function_stats = new CodeStatistics(&assembler);
+        function_stats->RecordBoundsChecks(
+            flow_graph->num_eliminated_bounds_checks(),
+            flow_graph->num_hoisted_bounds_checks());
       }
 
       FlowGraphCompiler graph_compiler(
@@ -244,6 +244,12 @@ class Precompiler : public ValueObject {
   void DoCompileAll();
   void AddRoots();
   void AddAnnotatedRoots();
+
+  // Compiles pending functions and adds their callees until a fixed point is
+  // reached. This runs on the mutator only: compiling a function lazily
+  // creates shared objects (closure functions, dispatchers, canonical types
+  // and constants) and appends to the global object pool, and the snapshot
+  // depends on the order in which that happens.
   void Iterate();
 
   void AddType(const AbstractType& type);
@@ -310,6 +316,8 @@ class Precompiler : public ValueObject {
   intptr_t dropped_typearg_count_;
   intptr_t dropped_type_count_;
   intptr_t dropped_library_count_;
+  int64_t compile_time_micros_;
+  int64_t iterate_time_micros_;
 
   compiler::ObjectPoolBuilder global_object_pool_builder_;
   GrowableObjectArray& libraries_;
@@ -3475,7 +3475,7 @@ void Assembler::MaybeTraceAllocation(Register stats_addr_reg, Label* trace) {
   ASSERT(stats_addr_reg != TMP);
   const uword state_offset = ClassHeapStats::state_offset();
   ldr(TMP, Address(stats_addr_reg, state_offset));
-  tst(TMP, Operand(ClassHeapStats::TraceAllocationMask()));
+  tst(TMP, Operand(ClassHeapStats::SlowPathAllocationMask()));
   b(trace, NE);
 }
 
@@ -1124,8 +1124,8 @@ class Assembler : public AssemblerBase {
   void LoadWordUnaligned(Register dst, Register addr, Register tmp);
   void StoreWordUnaligned(Register src, Register addr, Register tmp);
 
-  // If allocation tracing is enabled, will jump to |trace| label,
-  // which will allocate in the runtime where tracing occurs.
+  // If allocation tracing or pretenuring is enabled, will jump to |trace|
+  // label, which will allocate in the runtime where tracing occurs.
   void MaybeTraceAllocation(Register stats_addr_reg, Label* trace);
 
   // Inlined allocation of an instance of class 'cls', code has no runtime
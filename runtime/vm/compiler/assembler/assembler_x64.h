@@ -894,8 +894,8 @@ class Assembler : public AssemblerBase {
   void UpdateAllocationStatsWithSize(intptr_t cid, Register size_reg);
   void UpdateAllocationStatsWithSize(intptr_t cid, intptr_t instance_size);
 
-  // If allocation tracing for |cid| is enabled, will jump to |trace| label,
-  // which will allocate in the runtime where tracing occurs.
+  // If allocation tracing or pretenuring for |cid| is enabled, will jump to
+  // |trace| label, which will allocate in the runtime where tracing occurs.
   void MaybeTraceAllocation(intptr_t cid, Label* trace, bool near_jump);
 
   // Inlined allocation of an instance of class 'cls', code has no runtime
@@ -0,0 +1,502 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/compiler/backend/bounds_check_hoisting.h"
+
+#include "vm/bit_vector.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            hoist_bounds_checks,
+            true,
+            "Hoist bounds checks on induction variables out of loops.");
+DECLARE_FLAG(bool, array_bounds_check_elimination);
+
+// Factors of the symbolic bounds are kept small enough for all sums and
+// products of them to be exact, and for the results to be smis on every
+// target.
+static bool IsSmallFactor(int64_t value) {
+  return Utils::IsInt(31, value);
+}
+
+static bool IsTaggedSmi(Definition* def) {
+  return (def->representation() == kTagged) &&
+         (def->Type()->ToCid() == kSmiCid);
+}
+
+// A loop invariant value
+//
+//     c + m_1 * x_1 + ... + m_n * x_n
+//
+// over tagged definitions x_i that are available in the loop preheader.
+// Definitions that are not known to be smis are checked when the value is
+// emitted.
+class InvariantExpr : public ZoneAllocated {
+ public:
+  InvariantExpr() : constant_(0), defs_(), mults_() {}
+
+  int64_t constant() const { return constant_; }
+
+  bool IsConstant() const {
+    for (intptr_t i = 0; i < mults_.length(); i++) {
+      if (mults_[i] != 0) return false;
+    }
+    return true;
+  }
+
+  bool NeedsSmiChecks() const {
+    for (intptr_t i = 0; i < defs_.length(); i++) {
+      if (mults_[i] != 0 && !IsTaggedSmi(defs_[i])) return true;
+    }
+    return false;
+  }
+
+  // Adds scale * value. Returns false if the result can no longer be
+  // represented with small factors.
+  bool AddConstant(int64_t scale, int64_t value) {
+    if (!IsSmallFactor(scale) || !IsSmallFactor(value)) return false;
+    constant_ += scale * value;
+    return IsSmallFactor(constant_);
+  }
+
+  // Adds scale * x for an invariant induction x.
+  bool Add(int64_t scale, InductionVar* x) {
+    ASSERT(InductionVar::IsInvariant(x));
+    if (!AddConstant(scale, x->offset())) return false;
+    if (x->mult() == 0) return true;
+    if (x->def()->representation() != kTagged) return false;
+    return AddTerm(scale, x->mult(), x->def());
+  }
+
+  // Adds scale * other.
+  bool Add(int64_t scale, InvariantExpr* other) {
+    if (!AddConstant(scale, other->constant_)) return false;
+    for (intptr_t i = 0; i < other->defs_.length(); i++) {
+      if (!AddTerm(scale, other->mults_[i], other->defs_[i])) return false;
+    }
+    return true;
+  }
+
+  // Returns true if this and the other expression differ at most in their
+  // constant.
+  bool HasSameTerms(InvariantExpr* other) const {
+    return IsIncludedIn(other) && other->IsIncludedIn(this);
+  }
+
+  // Emits the expression as smi arithmetic before the given preheader goto.
+  Definition* Emit(FlowGraph* flow_graph, Instruction* point) const;
+
+ private:
+  int64_t MultOf(Definition* def) const {
+    for (intptr_t i = 0; i < defs_.length(); i++) {
+      if (defs_[i] == def) return mults_[i];
+    }
+    return 0;
+  }
+
+  bool IsIncludedIn(const InvariantExpr* other) const {
+    for (intptr_t i = 0; i < defs_.length(); i++) {
+      if (mults_[i] != other->MultOf(defs_[i])) return false;
+    }
+    return true;
+  }
+
+  bool AddTerm(int64_t scale, int64_t mult, Definition* def) {
+    if (!IsSmallFactor(scale) || !IsSmallFactor(mult)) return false;
+    for (intptr_t i = 0; i < defs_.length(); i++) {
+      if (defs_[i] == def) {
+        mults_[i] += scale * mult;
+        return IsSmallFactor(mults_[i]);
+      }
+    }
+    defs_.Add(def);
+    mults_.Add(scale * mult);
+    return IsSmallFactor(mults_.Last());
+  }
+
+  int64_t constant_;
+  GrowableArray<Definition*> defs_;
+  GrowableArray<int64_t> mults_;
+};
+
+// Inserts the given instruction before the preheader goto. Anything that
+// can deoptimize deoptimizes to the state before the loop, like code that
+// was hoisted there by LICM.
+static void InsertInPreheader(FlowGraph* flow_graph,
+                              Instruction* point,
+                              Instruction* instr) {
+  flow_graph->InsertBefore(
+      point, instr, nullptr,
+      instr->IsDefinition() ? FlowGraph::kValue : FlowGraph::kEffect);
+  instr->InheritDeoptTarget(flow_graph->zone(), point);
+}
+
+static Definition* EmitBinaryOp(FlowGraph* flow_graph,
+                                Instruction* point,
+                                Token::Kind op_kind,
+                                Definition* left,
+                                Definition* right) {
+  // Overflow deoptimizes, so the bound is always exact.
+  BinarySmiOpInstr* op = new (flow_graph->zone())
+      BinarySmiOpInstr(op_kind, new (flow_graph->zone()) Value(left),
+                       new (flow_graph->zone()) Value(right), DeoptId::kNone);
+  InsertInPreheader(flow_graph, point, op);
+  return op;
+}
+
+static Definition* EmitMinMax(FlowGraph* flow_graph,
+                              Instruction* point,
+                              MethodRecognizer::Kind kind,
+                              Definition* left,
+                              Definition* right) {
+  MathMinMaxInstr* op = new (flow_graph->zone()) MathMinMaxInstr(
+      kind, new (flow_graph->zone()) Value(left),
+      new (flow_graph->zone()) Value(right), DeoptId::kNone, kSmiCid);
+  InsertInPreheader(flow_graph, point, op);
+  return op;
+}
+
+// The loop itself usually performs the same smi check on the limit, and
+// LICM already hoisted it into the preheader. Marking the check as hoisted
+// makes a failure prohibit further hoisting for the function.
+static void EmitCheckSmi(FlowGraph* flow_graph,
+                         Instruction* point,
+                         Definition* value) {
+  CheckSmiInstr* check = new (flow_graph->zone())
+      CheckSmiInstr(new (flow_graph->zone()) Value(value), DeoptId::kNone,
+                    point->token_pos());
+  check->set_licm_hoisted(true);
+  InsertInPreheader(flow_graph, point, check);
+}
+
+static Definition* SmiConstant(FlowGraph* flow_graph, int64_t value) {
+  return flow_graph->GetConstant(
+      Smi::ZoneHandle(flow_graph->zone(), Smi::New(value)));
+}
+
+Definition* InvariantExpr::Emit(FlowGraph* flow_graph,
+                                Instruction* point) const {
+  Definition* result = nullptr;
+  for (intptr_t i = 0; i < defs_.length(); i++) {
+    const int64_t mult = mults_[i];
+    if (mult == 0) {
+      continue;
+    }
+    Definition* term = defs_[i];
+    if (!IsTaggedSmi(term)) {
+      EmitCheckSmi(flow_graph, point, term);
+    }
+    Token::Kind op_kind = Token::kADD;
+    if (mult == -1 && result != nullptr) {
+      op_kind = Token::kSUB;
+    } else if (mult != 1) {
+      term = EmitBinaryOp(flow_graph, point, Token::kMUL, term,
+                          SmiConstant(flow_graph, mult));
+    }
+    result = (result == nullptr)
+                 ? term
+                 : EmitBinaryOp(flow_graph, point, op_kind, result, term);
+  }
+  if (result == nullptr) {
+    return SmiConstant(flow_graph, constant_);
+  }
+  if (constant_ != 0) {
+    result = EmitBinaryOp(flow_graph, point, Token::kADD, result,
+                          SmiConstant(flow_graph, constant_));
+  }
+  return result;
+}
+
+// The bounds checks of a single loop that can be replaced by checks in its
+// preheader.
+class HoistableChecks : public ValueObject {
+ public:
+  HoistableChecks(FlowGraph* flow_graph, LoopInfo* loop)
+      : flow_graph_(flow_graph),
+        zone_(flow_graph->zone()),
+        loop_(loop),
+        allow_smi_checks_(
+            !flow_graph->function().ProhibitsHoistingCheckClass()),
+        preheader_goto_(nullptr),
+        last_iteration_(nullptr),
+        checks_(),
+        lengths_(),
+        upper_bounds_(),
+        lower_bounds_() {}
+
+  // Finds all checks in the loop that can be hoisted. Returns false if
+  // there are none.
+  bool Collect();
+
+  // Emits the combined checks into the preheader and removes the checks
+  // from the loop.
+  void Hoist();
+
+ private:
+  bool ComputeLastIteration();
+  bool AddCheck(CheckArrayBoundInstr* check);
+  void AddUpperBound(Definition* length, InvariantExpr* upper);
+  void AddLowerBound(InvariantExpr* lower);
+  void EmitCheck(Definition* length, Definition* index);
+
+  FlowGraph* flow_graph_;
+  Zone* zone_;
+  LoopInfo* loop_;
+  const bool allow_smi_checks_;
+  GotoInstr* preheader_goto_;
+
+  // Normalized loop index of the last iteration in which the body runs.
+  InvariantExpr* last_iteration_;
+
+  // The checks that are removed from the loop.
+  GrowableArray<CheckArrayBoundInstr*> checks_;
+
+  // Largest index used per length, and smallest index used overall. Entries
+  // that only differ in their constant are merged.
+  GrowableArray<Definition*> lengths_;
+  GrowableArray<InvariantExpr*> upper_bounds_;
+  GrowableArray<InvariantExpr*> lower_bounds_;
+};
+
+bool HoistableChecks::Collect() {
+  BlockEntryInstr* header = loop_->header();
+  BlockEntryInstr* preheader = header->ImmediateDominator();
+  if (preheader == nullptr) {
+    return false;
+  }
+  preheader_goto_ = preheader->last_instruction()->AsGoto();
+  if (preheader_goto_ == nullptr || preheader_goto_->successor() != header ||
+      preheader_goto_->env() == nullptr) {
+    return false;
+  }
+  // The preheader must be the only way into the loop.
+  for (intptr_t i = 0; i < header->PredecessorCount(); i++) {
+    BlockEntryInstr* pred = header->PredecessorAt(i);
+    if (pred != preheader && !loop_->Contains(pred)) {
+      return false;
+    }
+  }
+  if (!ComputeLastIteration()) {
+    return false;
+  }
+
+  for (BitVector::Iterator it(loop_->blocks()); !it.Done(); it.Advance()) {
+    BlockEntryInstr* block = flow_graph_->preorder()[it.Current()];
+    // Checks in the header also run when the loop exits, and checks in
+    // inner loops belong to the preheader of the inner loop.
+    if (block == header || block->loop_info() != loop_) {
+      continue;
+    }
+    for (ForwardInstructionIterator instr_it(block); !instr_it.Done();
+         instr_it.Advance()) {
+      CheckArrayBoundInstr* check = instr_it.Current()->AsCheckArrayBound();
+      if (check != nullptr && AddCheck(check)) {
+        checks_.Add(check);
+      }
+    }
+  }
+  return !checks_.is_empty();
+}
+
+// All loop blocks other than the header are only reached after the exit
+// test in the header succeeded, so they run in the iterations k = 0 .. last
+// of the normalized loop index, where
+//
+//     last = U - i0 - 1   for  i < U (i++)
+//     last = i0 - L - 1   for  i > L (i--)
+//
+bool HoistableChecks::ComputeLastIteration() {
+  InductionVar* control = loop_->control();
+  int64_t stride = 0;
+  if (!InductionVar::IsLinear(control, &stride)) {
+    return false;
+  }
+  InductionVar* limit = nullptr;
+  for (auto bound : control->bounds()) {
+    if (bound.branch_ == loop_->header()->last_instruction()) {
+      limit = bound.limit_;
+      break;
+    }
+  }
+  if (limit == nullptr) {
+    return false;
+  }
+  ASSERT(stride == 1 || stride == -1);
+  last_iteration_ = new (zone_) InvariantExpr();
+  return last_iteration_->Add(stride, limit) &&
+         last_iteration_->Add(-stride, control->initial()) &&
+         last_iteration_->AddConstant(1, -1);
+}
+
+bool HoistableChecks::AddCheck(CheckArrayBoundInstr* check) {
+  // Removing the check must not lose a smi check on the index.
+  Definition* length = check->length()->definition();
+  if (check->index()->Type()->ToCid() != kSmiCid || !IsTaggedSmi(length) ||
+      !preheader_goto_->IsDominatedBy(length)) {
+    return false;
+  }
+
+  // Only linear inductions have their extreme values in the first and the
+  // last iteration.
+  Definition* index = check->index()
+                          ->definition()
+                          ->OriginalDefinitionIgnoreBoxingAndConstraints();
+  InductionVar* induc = loop_->LookupInduction(index);
+  int64_t stride = 0;
+  if (!InductionVar::IsLinear(induc, &stride) || stride == 0) {
+    return false;
+  }
+  InvariantExpr* first = new (zone_) InvariantExpr();
+  InvariantExpr* last = new (zone_) InvariantExpr();
+  if (!first->Add(1, induc->initial()) || !last->Add(1, induc->initial()) ||
+      !last->Add(stride, last_iteration_)) {
+    return false;
+  }
+  InvariantExpr* lower = (stride > 0) ? first : last;
+  InvariantExpr* upper = (stride > 0) ? last : first;
+  if (!allow_smi_checks_ &&
+      (lower->NeedsSmiChecks() || upper->NeedsSmiChecks())) {
+    return false;
+  }
+
+  // Leave checks that are known to fail once the loop runs in place, so
+  // the error is raised in the right iteration.
+  if (lower->IsConstant() && lower->constant() < 0) {
+    return false;
+  }
+  if (upper->IsConstant() && length->IsConstant()) {
+    const Smi& constant_length = Smi::Cast(length->AsConstant()->value());
+    if (upper->constant() >= constant_length.Value()) {
+      return false;
+    }
+  } else {
+    AddUpperBound(length, upper);
+  }
+  if (!lower->IsConstant()) {
+    AddLowerBound(lower);
+  }
+  return true;
+}
+
+void HoistableChecks::AddUpperBound(Definition* length, InvariantExpr* upper) {
+  for (intptr_t i = 0; i < lengths_.length(); i++) {
+    if (lengths_[i] == length && upper_bounds_[i]->HasSameTerms(upper)) {
+      if (upper->constant() > upper_bounds_[i]->constant()) {
+        upper_bounds_[i] = upper;
+      }
+      return;
+    }
+  }
+  lengths_.Add(length);
+  upper_bounds_.Add(upper);
+}
+
+void HoistableChecks::AddLowerBound(InvariantExpr* lower) {
+  for (intptr_t i = 0; i < lower_bounds_.length(); i++) {
+    if (lower_bounds_[i]->HasSameTerms(lower)) {
+      if (lower->constant() < lower_bounds_[i]->constant()) {
+        lower_bounds_[i] = lower;
+      }
+      return;
+    }
+  }
+  lower_bounds_.Add(lower);
+}
+
+void HoistableChecks::EmitCheck(Definition* length, Definition* index) {
+  CheckArrayBoundInstr* check = new (zone_)
+      CheckArrayBoundInstr(new (zone_) Value(length), new (zone_) Value(index),
+                           DeoptId::kNone);
+  check->mark_generalized();
+  InsertInPreheader(flow_graph_, preheader_goto_, check);
+}
+
+void HoistableChecks::Hoist() {
+  intptr_t num_hoisted = 0;
+
+  // Arrays accessed at the same largest index share a single check against
+  // the smallest of their lengths.
+  GrowableArray<bool> emitted(lengths_.length());
+  for (intptr_t i = 0; i < lengths_.length(); i++) {
+    emitted.Add(false);
+  }
+  for (intptr_t i = 0; i < lengths_.length(); i++) {
+    if (emitted[i]) {
+      continue;
+    }
+    Definition* length = lengths_[i];
+    for (intptr_t j = i + 1; j < lengths_.length(); j++) {
+      if (!emitted[j] && upper_bounds_[j]->HasSameTerms(upper_bounds_[i]) &&
+          upper_bounds_[j]->constant() == upper_bounds_[i]->constant()) {
+        length = EmitMinMax(flow_graph_, preheader_goto_,
+                            MethodRecognizer::kMathMin, length, lengths_[j]);
+        emitted[j] = true;
+      }
+    }
+    EmitCheck(length, upper_bounds_[i]->Emit(flow_graph_, preheader_goto_));
+    num_hoisted++;
+  }
+
+  // A single check makes sure the smallest index is not negative.
+  if (!lower_bounds_.is_empty()) {
+    Definition* lower = lower_bounds_[0]->Emit(flow_graph_, preheader_goto_);
+    for (intptr_t i = 1; i < lower_bounds_.length(); i++) {
+      lower = EmitMinMax(flow_graph_, preheader_goto_,
+                         MethodRecognizer::kMathMin, lower,
+                         lower_bounds_[i]->Emit(flow_graph_, preheader_goto_));
+    }
+    EmitCheck(SmiConstant(flow_graph_, compiler::target::kSmiMax), lower);
+    num_hoisted++;
+  }
+
+  if (FLAG_trace_optimization && flow_graph_->should_print()) {
+    THR_Print("Replaced %" Pd " bounds checks in loop B%" Pd
+              " by %" Pd " checks in B%" Pd "\n",
+              checks_.length(), loop_->header()->block_id(), num_hoisted,
+              preheader_goto_->GetBlock()->block_id());
+  }
+
+  for (intptr_t i = 0; i < checks_.length(); i++) {
+    CheckArrayBoundInstr* check = checks_[i];
+    check->ReplaceUsesWith(check->index()->definition());
+    check->RemoveFromGraph();
+  }
+  flow_graph_->RecordEliminatedBoundsChecks(checks_.length(), num_hoisted);
+}
+
+void BoundsCheckHoisting::Optimize(FlowGraph* flow_graph) {
+  // Hoisted checks deoptimize to the loop preheader, which needs the
+  // environments at gotos that LICM also relies on. Once a hoisted check
+  // failed, the function is reoptimized without hoisting.
+  if (!FLAG_hoist_bounds_checks || !FLAG_array_bounds_check_elimination ||
+      FLAG_precompiled_mode || !flow_graph->is_licm_allowed() ||
+      flow_graph->function().ProhibitsBoundsCheckGeneralization()) {
+    return;
+  }
+
+  const LoopHierarchy& loop_hierarchy = flow_graph->GetLoopHierarchy();
+  const ZoneGrowableArray<BlockEntryInstr*>& headers =
+      loop_hierarchy.headers();
+  if (headers.is_empty()) {
+    return;
+  }
+  loop_hierarchy.ComputeInduction();
+
+  for (intptr_t i = 0; i < headers.length(); i++) {
+    HoistableChecks checks(flow_graph, headers[i]->loop_info());
+    if (checks.Collect()) {
+      checks.Hoist();
+    }
+  }
+}
+
+}  // namespace dart
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
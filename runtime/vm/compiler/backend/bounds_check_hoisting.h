@@ -0,0 +1,42 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_BOUNDS_CHECK_HOISTING_H_
+#define RUNTIME_VM_COMPILER_BACKEND_BOUNDS_CHECK_HOISTING_H_
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+class FlowGraph;
+
+// Removes bounds checks on linear induction variables from loops.
+//
+// For a loop controlled by a unit stride induction, e.g.
+//
+//     for (int i = init; i < n; i++) {
+//       ... a[i] ... b[2 * i + 1] ... c[j] ...   // j = j + 3
+//     }
+//
+// every CheckArrayBound whose index is a linear induction of the loop with
+// a constant stride (including derived inductions like 2 * i + 1 and other
+// basic inductions like j) and whose length is loop invariant only has to
+// be performed for the first and the last iteration. These extreme values
+// are computed symbolically in the loop preheader, where checks sharing the
+// same extreme index are combined into a single check against the minimum
+// of their lengths, and the checks in the loop are removed.
+//
+// The hoisted checks deoptimize in the preheader, so they are speculative:
+// a loop that exits early (or is not entered at all) could still fail them.
+// Like the checks of BoundsCheckGeneralizer they are marked as generalized,
+// so a failure prohibits hoisting for the function when it is reoptimized.
+// This pass is JIT only since AOT bounds checks cannot deoptimize.
+class BoundsCheckHoisting : public AllStatic {
+ public:
+  static void Optimize(FlowGraph* flow_graph);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_BOUNDS_CHECK_HOISTING_H_
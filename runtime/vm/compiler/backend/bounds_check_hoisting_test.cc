@@ -0,0 +1,125 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Unit tests for hoisting bounds checks on induction variables out of loops.
+
+#include "vm/compiler/backend/bounds_check_hoisting.h"
+#include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+// Runs the full JIT pipeline on 'foo' and counts the bounds checks that are
+// left inside and outside of loops.
+static FlowGraph* CountBoundsChecks(Thread* thread,
+                                    const char* script_chars,
+                                    intptr_t* in_loops,
+                                    intptr_t* outside_loops) {
+  const auto& root_library = Library::Handle(LoadTestScript(script_chars));
+  Invoke(root_library, "main");
+
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  flow_graph->GetLoopHierarchy();
+  *in_loops = 0;
+  *outside_loops = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    BlockEntryInstr* block = block_it.Current();
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      if (it.Current()->IsCheckArrayBound()) {
+        if (block->loop_info() != nullptr) {
+          (*in_loops)++;
+        } else {
+          (*outside_loops)++;
+        }
+      }
+    }
+  }
+  return flow_graph;
+}
+
+ISOLATE_UNIT_TEST_CASE(BoundsCheckHoisting_DownwardLoop) {
+  // Both arrays are checked against the same largest index n - 1.
+  const char* script_chars =
+      R"(
+      import 'dart:typed_data';
+      foo(Int32List a, Int32List b, int n) {
+        int sum = 0;
+        for (int i = n - 1; i >= 0; i--) {
+          sum += a[i] - b[i];
+        }
+        return sum;
+      }
+      main() {
+        final list = new Int32List(10);
+        foo(list, list, 10);
+      }
+    )";
+  intptr_t in_loops = 0;
+  intptr_t outside_loops = 0;
+  FlowGraph* flow_graph =
+      CountBoundsChecks(thread, script_chars, &in_loops, &outside_loops);
+  EXPECT_EQ(0, in_loops);
+  EXPECT_EQ(1, outside_loops);
+  EXPECT_EQ(1, flow_graph->num_hoisted_bounds_checks());
+  EXPECT(flow_graph->num_eliminated_bounds_checks() >= 2);
+}
+
+ISOLATE_UNIT_TEST_CASE(BoundsCheckHoisting_NonUnitStride) {
+  // The index j is a basic induction with stride 3 next to the control i.
+  const char* script_chars =
+      R"(
+      import 'dart:typed_data';
+      foo(Int32List a, int n) {
+        int sum = 0;
+        for (int i = 0, j = 1; i < n; i++, j += 3) {
+          sum += a[j];
+        }
+        return sum;
+      }
+      main() {
+        foo(new Int32List(31), 10);
+      }
+    )";
+  intptr_t in_loops = 0;
+  intptr_t outside_loops = 0;
+  FlowGraph* flow_graph =
+      CountBoundsChecks(thread, script_chars, &in_loops, &outside_loops);
+  EXPECT_EQ(0, in_loops);
+  EXPECT_EQ(1, outside_loops);
+  EXPECT_EQ(1, flow_graph->num_hoisted_bounds_checks());
+}
+
+ISOLATE_UNIT_TEST_CASE(BoundsCheckHoisting_NotAnInduction) {
+  // The index is loaded from memory, so the check stays in the loop.
+  const char* script_chars =
+      R"(
+      import 'dart:typed_data';
+      foo(Int32List a, Int32List b) {
+        int sum = 0;
+        for (int i = 0; i < b.length; i++) {
+          sum += a[b[i]];
+        }
+        return sum;
+      }
+      main() {
+        foo(new Int32List(10), new Int32List(10));
+      }
+    )";
+  intptr_t in_loops = 0;
+  intptr_t outside_loops = 0;
+  FlowGraph* flow_graph =
+      CountBoundsChecks(thread, script_chars, &in_loops, &outside_loops);
+  EXPECT_EQ(1, in_loops);
+  EXPECT_EQ(0, flow_graph->num_hoisted_bounds_checks());
+}
+
+}  // namespace dart
@@ -63,6 +63,8 @@ class CombinedCodeStatistics {
   intptr_t object_header_bytes_;
   intptr_t return_const_count_;
   intptr_t return_const_with_load_field_count_;
+  intptr_t eliminated_bounds_checks_;
+  intptr_t hoisted_bounds_checks_;
 };
 
 class CodeStatistics {
@@ -75,6 +77,13 @@ class CodeStatistics {
   void SpecialBegin(intptr_t tag);
   void SpecialEnd(intptr_t tag);
 
+  // Records the bounds checks that the optimizer removed from the function
+  // and the checks it inserted into loop preheaders instead.
+  void RecordBoundsChecks(intptr_t eliminated, intptr_t hoisted) {
+    eliminated_bounds_checks_ = eliminated;
+    hoisted_bounds_checks_ = hoisted;
+  }
+
   void AppendTo(CombinedCodeStatistics* stat);
 
   void Finalize();
@@ -93,6 +102,8 @@ class CodeStatistics {
   intptr_t instruction_bytes_;
   intptr_t unaccounted_bytes_;
   intptr_t alignment_bytes_;
+  intptr_t eliminated_bounds_checks_;
+  intptr_t hoisted_bounds_checks_;
 
   intptr_t stack_[kStackSize];
   intptr_t stack_index_;
@@ -334,6 +334,19 @@ class FlowGraph : public ZoneAllocated {
 
   bool IsCompiledForOsr() const { return graph_entry()->IsCompiledForOsr(); }
 
+  // Number of bounds checks removed by range analysis and loop optimizations,
+  // and number of checks they inserted into loop preheaders instead.
+  intptr_t num_eliminated_bounds_checks() const {
+    return num_eliminated_bounds_checks_;
+  }
+  intptr_t num_hoisted_bounds_checks() const {
+    return num_hoisted_bounds_checks_;
+  }
+  void RecordEliminatedBoundsChecks(intptr_t eliminated, intptr_t hoisted) {
+    num_eliminated_bounds_checks_ += eliminated;
+    num_hoisted_bounds_checks_ += hoisted;
+  }
+
   void AddToDeferredPrefixes(ZoneGrowableArray<const LibraryPrefix*>* from);
 
   ZoneGrowableArray<const LibraryPrefix*>* deferred_prefixes() const {
@@ -525,6 +538,9 @@ class FlowGraph : public ZoneAllocated {
   LoopHierarchy* loop_hierarchy_;
   ZoneGrowableArray<BitVector*>* loop_invariant_loads_;
 
+  intptr_t num_eliminated_bounds_checks_;
+  intptr_t num_hoisted_bounds_checks_;
+
   ZoneGrowableArray<const LibraryPrefix*>* deferred_prefixes_;
   DirectChainedHashMap<ConstantPoolTrait> constant_instr_pool_;
   BitVector* captured_parameters_;
@@ -8093,6 +8093,11 @@ class SimdOpInstr : public Definition {
     return new SimdOpInstr(KindForMethod(kind), left, right, deopt_id);
   }
 
+  // Create a unary SimdOp instr.
+  static SimdOpInstr* Create(Kind kind, Value* left, intptr_t deopt_id) {
+    return new SimdOpInstr(kind, left, deopt_id);
+  }
+
   // Create a unary SimdOp.
   static SimdOpInstr* Create(MethodRecognizer::Kind kind,
                              Value* left,
@@ -78,6 +78,11 @@ DEFINE_FLAG(int,
             500,
             "Max. number of inlined calls per depth");
 DEFINE_FLAG(bool, print_inlining_tree, false, "Print inlining tree");
+DEFINE_FLAG(bool,
+            inline_hottest_receivers,
+            true,
+            "Inline the hottest receivers of polymorphic calls with more than "
+            "max_polymorphic_checks receiver classes.");
 DEFINE_FLAG(bool,
             enable_inlining_annotations,
             false,
@@ -2129,13 +2134,65 @@ bool PolymorphicInliner::trace_inlining() const {
   return owner_->trace_inlining();
 }
 
+PolymorphicInliningPolicy::PolymorphicInliningPolicy(
+    const CallTargets& targets,
+    intptr_t total_count)
+    : total_count_(total_count),
+      is_megamorphic_(targets.length() > FLAG_max_polymorphic_checks),
+      num_candidates_(ComputeNumCandidates(targets)) {}
+
+intptr_t PolymorphicInliningPolicy::ComputeNumCandidates(
+    const CallTargets& targets) const {
+  if (!is_megamorphic_) return targets.length();
+  // Without type feedback there is no way to tell the hot receivers apart.
+  if (!FLAG_inline_hottest_receivers || (total_count_ == 0)) return 0;
+  // The targets are sorted by decreasing call count. Take receivers as long
+  // as the calls they save pay for the class id test in front of the rest.
+  intptr_t remaining = total_count_;
+  intptr_t num_candidates = 0;
+  while (num_candidates < FLAG_max_polymorphic_checks) {
+    const intptr_t count = targets.TargetAt(num_candidates)->count;
+    remaining -= count;
+    if (count * kCallCostInClassIdTests < remaining) break;
+    num_candidates++;
+  }
+  return num_candidates;
+}
+
+bool PolymorphicInliningPolicy::ShouldTryHarder(
+    intptr_t index,
+    intptr_t num_non_inlined) const {
+  // The tail of a megamorphic call site is never inlined.
+  if (is_megamorphic_) return false;
+  return (index >= num_candidates_ - 2) && (num_non_inlined == 0);
+}
+
+bool PolymorphicInliningPolicy::IsWorthClassIdTest(intptr_t count,
+                                                   bool try_harder) const {
+  // If it's less than 3% of the dispatches, we won't even consider checking
+  // for the class ID and branching to another already-inlined version.
+  return try_harder || (count >= (total_count_ >> 5));
+}
+
+bool PolymorphicInliningPolicy::IsWorthInlining(intptr_t count,
+                                                bool small,
+                                                bool try_harder) const {
+  // If it's less than 12% of the dispatches, we don't consider inlining.
+  // For very small functions we are willing to consider inlining for 6% of
+  // the cases.
+  return try_harder || (count >= (total_count_ >> (small ? 4 : 3)));
+}
+
 bool PolymorphicInliner::Inline() {
   ASSERT(&variants_ == &call_->targets_);
 
   intptr_t total = call_->total_call_count();
+  const PolymorphicInliningPolicy policy(variants_, total);
   for (intptr_t var_idx = 0; var_idx < variants_.length(); ++var_idx) {
     TargetInfo* info = variants_.TargetAt(var_idx);
-    if (variants_.length() > FLAG_max_polymorphic_checks) {
+    if (!policy.IsCandidate(var_idx)) {
+      TRACE_INLINING(
+          TracePolyInlining(variants_, var_idx, total, "megamorphic tail"));
       non_inlined_variants_->Add(info);
       continue;
     }
@@ -2146,16 +2203,13 @@ bool PolymorphicInliner::Inline() {
     // We we almost inlined all the cases then try a little harder to inline
     // the last two, because it's a big win if we inline all of them (compiler
     // can see all side effects).
-    const bool try_harder = (var_idx >= variants_.length() - 2) &&
-                            non_inlined_variants_->length() == 0;
+    const bool try_harder =
+        policy.ShouldTryHarder(var_idx, non_inlined_variants_->length());
 
     intptr_t size = target.optimized_instruction_count();
     bool small = (size != 0 && size < FLAG_inlining_size_threshold);
 
-    // If it's less than 3% of the dispatches, we won't even consider
-    // checking for the class ID and branching to another already-inlined
-    // version.
-    if (!try_harder && count < (total >> 5)) {
+    if (!policy.IsWorthClassIdTest(count, try_harder)) {
       TRACE_INLINING(
           TracePolyInlining(variants_, var_idx, total, "way too infrequent"));
       non_inlined_variants_->Add(info);
@@ -2170,10 +2224,9 @@ bool PolymorphicInliner::Inline() {
       continue;
     }
 
-    // If it's less than 12% of the dispatches and it's not already inlined, we
-    // don't consider inlining.  For very small functions we are willing to
-    // consider inlining for 6% of the cases.
-    if (!try_harder && count < (total >> (small ? 4 : 3))) {
+    // Not already inlined, so the receiver has to be frequent enough to be
+    // worth inlining on its own.
+    if (!policy.IsWorthInlining(count, small, try_harder)) {
       TRACE_INLINING(
           TracePolyInlining(variants_, var_idx, total, "too infrequent"));
       non_inlined_variants_->Add(&variants_[var_idx]);
@@ -11,6 +11,7 @@
 
 namespace dart {
 
+class CallTargets;
 class Definition;
 class Field;
 class FlowGraph;
@@ -83,6 +84,51 @@ class SpeculativeInliningPolicy {
   GrowableArray<intptr_t> inlining_blacklist_;
 };
 
+// Profitability model for inlining the receivers of a polymorphic instance
+// call. The receivers are considered in decreasing order of their call
+// counts, which is also the order in which their class ids are tested.
+//
+// Every inlined receiver puts a class id test in front of all less frequent
+// receivers. At call sites with more than FLAG_max_polymorphic_checks
+// receivers only a prefix of the hottest receivers is inlined, and only as
+// long as each of them is called often enough to pay for the test it adds to
+// the remaining calls. The tail is left to the fallback call, which goes
+// through the megamorphic cache for infrequent receivers.
+class PolymorphicInliningPolicy : public ValueObject {
+ public:
+  PolymorphicInliningPolicy(const CallTargets& targets, intptr_t total_count);
+
+  // Whether the call site has too many receivers to inline all of them.
+  bool is_megamorphic() const { return is_megamorphic_; }
+
+  // The number of hottest receivers that may be inlined.
+  intptr_t num_candidates() const { return num_candidates_; }
+
+  bool IsCandidate(intptr_t index) const { return index < num_candidates_; }
+
+  // Whether the frequency thresholds below should be waived for the receiver
+  // at [index], because it is one of the last two receivers and inlining all
+  // of them lets the compiler see all side effects of the call.
+  bool ShouldTryHarder(intptr_t index, intptr_t num_non_inlined) const;
+
+  // Whether a receiver with [count] calls is worth a class id test at all,
+  // e.g. to share an already inlined body.
+  bool IsWorthClassIdTest(intptr_t count, bool try_harder) const;
+
+  // Whether a receiver with [count] calls is worth inlining its target.
+  bool IsWorthInlining(intptr_t count, bool small, bool try_harder) const;
+
+  // Rough cost of a call that is not inlined in terms of class id tests.
+  static const intptr_t kCallCostInClassIdTests = 4;
+
+ private:
+  intptr_t ComputeNumCandidates(const CallTargets& targets) const;
+
+  const intptr_t total_count_;
+  const bool is_megamorphic_;
+  const intptr_t num_candidates_;
+};
+
 class FlowGraphInliner : ValueObject {
  public:
   FlowGraphInliner(FlowGraph* flow_graph,
@@ -134,4 +134,137 @@ ISOLATE_UNIT_TEST_CASE(Inliner_PolyInliningRedefinition) {
   EXPECT(current->AsRedefinition()->Type()->ToCid() == kDynamicCid);
 }
 
+// Builds call targets for consecutive class ids with the given call counts,
+// which have to be in decreasing order.
+static const CallTargets& MakeTargets(const Function& target,
+                                      const intptr_t* counts,
+                                      intptr_t length) {
+  Zone* zone = Thread::Current()->zone();
+  CallTargets* targets = new (zone) CallTargets(zone);
+  for (intptr_t i = 0; i < length; i++) {
+    const intptr_t cid = kNumPredefinedCids + i;
+    targets->Add(new (zone) TargetInfo(
+        cid, cid, &target, counts[i], StaticTypeExactnessState::NotTracking()));
+  }
+  return *targets;
+}
+
+ISOLATE_UNIT_TEST_CASE(Inliner_PolymorphicInliningPolicy) {
+  const auto& root_library = Library::Handle(LoadTestScript("foo() {}"));
+  const auto& target = Function::ZoneHandle(GetFunction(root_library, "foo"));
+
+  // Few receivers: all of them are candidates, the frequency thresholds
+  // decide.
+  const intptr_t kPolymorphic[] = {60, 30, 10};
+  PolymorphicInliningPolicy polymorphic(MakeTargets(target, kPolymorphic, 3),
+                                        100);
+  EXPECT(!polymorphic.is_megamorphic());
+  EXPECT_EQ(3, polymorphic.num_candidates());
+  EXPECT(polymorphic.IsWorthInlining(12, /*small=*/false, false));
+  EXPECT(!polymorphic.IsWorthInlining(10, /*small=*/false, false));
+  EXPECT(polymorphic.IsWorthInlining(10, /*small=*/true, false));
+  EXPECT(polymorphic.IsWorthInlining(1, /*small=*/false, true));
+  EXPECT(polymorphic.IsWorthClassIdTest(4, false));
+  EXPECT(!polymorphic.IsWorthClassIdTest(2, false));
+  EXPECT(polymorphic.ShouldTryHarder(1, 0));
+  EXPECT(!polymorphic.ShouldTryHarder(1, 1));
+
+  // Skewed receivers of a megamorphic call site: the hottest ones are
+  // inlined, up to FLAG_max_polymorphic_checks.
+  const intptr_t kSkewed[] = {40, 25, 15, 12, 1, 1, 1, 1, 1, 1};
+  PolymorphicInliningPolicy skewed(MakeTargets(target, kSkewed, 10), 98);
+  EXPECT(skewed.is_megamorphic());
+  EXPECT_EQ(FLAG_max_polymorphic_checks, skewed.num_candidates());
+  EXPECT(!skewed.ShouldTryHarder(skewed.num_candidates() - 1, 0));
+
+  // A moderately skewed head followed by a heavy tail: only the receivers
+  // that pay for their class id test are candidates.
+  const intptr_t kHeavyTail[] = {40, 10, 7, 7, 7, 7, 7, 5, 5, 5};
+  PolymorphicInliningPolicy heavy_tail(MakeTargets(target, kHeavyTail, 10),
+                                       100);
+  EXPECT(heavy_tail.is_megamorphic());
+  EXPECT_EQ(1, heavy_tail.num_candidates());
+
+  // Evenly distributed receivers are left to the megamorphic call.
+  const intptr_t kUniform[] = {10, 10, 10, 10, 10, 10, 10, 10, 10, 10};
+  PolymorphicInliningPolicy uniform(MakeTargets(target, kUniform, 10), 100);
+  EXPECT(uniform.is_megamorphic());
+  EXPECT_EQ(0, uniform.num_candidates());
+
+  // Without type feedback nothing is inlined at megamorphic call sites.
+  const intptr_t kNoFeedback[] = {0, 0, 0, 0, 0, 0};
+  PolymorphicInliningPolicy no_feedback(MakeTargets(target, kNoFeedback, 6),
+                                        0);
+  EXPECT_EQ(0, no_feedback.num_candidates());
+}
+
+// Runs the inliner on 'dispatch' after calling it with receivers of ten
+// classes as often as given in 'counts'. Returns the number of receivers that
+// are left to the fallback call.
+static intptr_t NumNonInlinedReceivers(const char* counts) {
+  const char* script = OS::SCreate(Thread::Current()->zone(), R"(
+    abstract class Node { int visit(); }
+    class N0 extends Node { int visit() => 0; }
+    class N1 extends Node { int visit() => 1; }
+    class N2 extends Node { int visit() => 2; }
+    class N3 extends Node { int visit() => 3; }
+    class N4 extends Node { int visit() => 4; }
+    class N5 extends Node { int visit() => 5; }
+    class N6 extends Node { int visit() => 6; }
+    class N7 extends Node { int visit() => 7; }
+    class N8 extends Node { int visit() => 8; }
+    class N9 extends Node { int visit() => 9; }
+
+    dispatch(Node node) => node.visit();
+
+    main() {
+      final nodes = <Node>[N0(), N1(), N2(), N3(), N4(), N5(), N6(), N7(),
+                           N8(), N9()];
+      final counts = const <int>[%s];
+      for (int i = 0; i < nodes.length; i++) {
+        for (int j = 0; j < counts[i]; j++) {
+          dispatch(nodes[i]);
+        }
+      }
+    }
+  )", counts);
+
+  const auto& root_library = Library::Handle(LoadTestScript(script));
+  const auto& function =
+      Function::Handle(GetFunction(root_library, "dispatch"));
+
+  Invoke(root_library, "main");
+
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({
+      CompilerPass::kComputeSSA,
+      CompilerPass::kApplyICData,
+      CompilerPass::kTryOptimizePatterns,
+      CompilerPass::kSetOuterInliningId,
+      CompilerPass::kTypePropagation,
+      CompilerPass::kApplyClassIds,
+      CompilerPass::kInlining,
+  });
+
+  intptr_t non_inlined = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (auto call = it.Current()->AsPolymorphicInstanceCall()) {
+        non_inlined += call->NumberOfChecks();
+      }
+    }
+  }
+  return non_inlined;
+}
+
+// Test that the hottest receivers of a skewed megamorphic call site are
+// inlined and only the tail is left to the fallback call.
+ISOLATE_UNIT_TEST_CASE(Inliner_SkewedMegamorphicCall) {
+  EXPECT_EQ(6, NumNonInlinedReceivers("40, 25, 15, 12, 1, 1, 1, 1, 1, 1"));
+  EXPECT_EQ(10,
+            NumNonInlinedReceivers("10, 10, 10, 10, 10, 10, 10, 10, 10, 10"));
+}
+
 }  // namespace dart
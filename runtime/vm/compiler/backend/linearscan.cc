@@ -116,6 +116,7 @@ FlowGraphAllocator::FlowGraphAllocator(const FlowGraph& flow_graph,
       spill_slots_(),
       quad_spill_slots_(),
       untagged_spill_slots_(),
+      spill_slot_ranges_(),
       cpu_spill_slot_count_(0),
       intrinsic_mode_(intrinsic_mode) {
   for (intptr_t i = 0; i < vreg_count_; i++) {
@@ -812,6 +813,7 @@ void FlowGraphAllocator::ProcessInitialDefinition(Definition* defn,
     spill_slots_.Add(range_end);
     quad_spill_slots_.Add(false);
     untagged_spill_slots_.Add(false);
+    spill_slot_ranges_.Add(NULL);
     // Note, all incoming parameters are assumed to be tagged.
     MarkAsObjectAtSafepoints(range);
   } else if (defn->IsConstant() && block->IsCatchBlockEntry()) {
@@ -819,6 +821,7 @@ void FlowGraphAllocator::ProcessInitialDefinition(Definition* defn,
     spill_slots_.Add(range_end);
     quad_spill_slots_.Add(false);
     untagged_spill_slots_.Add(false);
+    spill_slot_ranges_.Add(NULL);
   }
 }
 
@@ -1912,6 +1915,31 @@ LiveRange* FlowGraphAllocator::SplitBetween(LiveRange* range,
   return range->SplitAt(split_pos);
 }
 
+intptr_t FlowGraphAllocator::LoopAwareSpillPosition(LiveRange* range,
+                                                    intptr_t from,
+                                                    intptr_t to) {
+  // When spilling the value inside a loop check if the spill can be moved
+  // to the loop header: the value must be live into the loop, must not need
+  // a register anywhere in the loop and must not need one until the loop is
+  // left. Then the whole loop uses the spill slot instead of reloading the
+  // value into its register on every back edge. Try outer loops as well.
+  for (LoopInfo* loop_info = BlockEntryAt(from)->loop_info();
+       loop_info != nullptr; loop_info = loop_info->outer()) {
+    const intptr_t loop_start = extra_loop_info_[loop_info->id()]->start;
+    const intptr_t loop_end = extra_loop_info_[loop_info->id()]->end;
+    if ((range->Start() > loop_start) || (to < loop_end) ||
+        !RangeHasOnlyUnconstrainedUsesInLoop(range, loop_info->id())) {
+      break;
+    }
+    ASSERT(loop_start <= from);
+    from = loop_start;
+    TRACE_ALLOC(THR_Print("  moved spill position to loop header B%" Pd
+                          " at %" Pd "\n",
+                          loop_info->header()->block_id(), from));
+  }
+  return from;
+}
+
 void FlowGraphAllocator::SpillBetween(LiveRange* range,
                                       intptr_t from,
                                       intptr_t to) {
@@ -1919,6 +1947,7 @@ void FlowGraphAllocator::SpillBetween(LiveRange* range,
   TRACE_ALLOC(THR_Print("spill v%" Pd " [%" Pd ", %" Pd ") "
                         "between [%" Pd ", %" Pd ")\n",
                         range->vreg(), range->Start(), range->End(), from, to));
+  from = LoopAwareSpillPosition(range, from, to);
   LiveRange* tail = range->SplitAt(from);
 
   if (tail->Start() < to) {
@@ -1935,22 +1964,53 @@ void FlowGraphAllocator::SpillBetween(LiveRange* range,
 void FlowGraphAllocator::SpillAfter(LiveRange* range, intptr_t from) {
   TRACE_ALLOC(THR_Print("spill v%" Pd " [%" Pd ", %" Pd ") after %" Pd "\n",
                         range->vreg(), range->Start(), range->End(), from));
+  from = LoopAwareSpillPosition(range, from, kMaxPosition);
+  LiveRange* tail = range->SplitAt(from);
+  Spill(tail);
+}
 
-  // When spilling the value inside the loop check if this spill can
-  // be moved outside.
-  LoopInfo* loop_info = BlockEntryAt(from)->loop_info();
-  if (loop_info != nullptr) {
-    if ((range->Start() <= loop_info->header()->start_pos()) &&
-        RangeHasOnlyUnconstrainedUsesInLoop(range, loop_info->id())) {
-      ASSERT(loop_info->header()->start_pos() <= from);
-      from = loop_info->header()->start_pos();
-      TRACE_ALLOC(
-          THR_Print("  moved spill position to loop header %" Pd "\n", from));
+// Returns true if the given live ranges, including all their split
+// siblings, are live at the same position.
+static bool LiveRangesInterfere(LiveRange* a, LiveRange* b) {
+  for (LiveRange* x = a; x != NULL; x = x->next_sibling()) {
+    for (LiveRange* y = b; y != NULL; y = y->next_sibling()) {
+      if (y->Start() >= x->End()) break;
+      if (x->Start() >= y->End()) continue;
+      if (FirstIntersection(x->first_use_interval(), y->first_use_interval()) !=
+          kMaxPosition) {
+        return true;
+      }
     }
   }
+  return false;
+}
 
-  LiveRange* tail = range->SplitAt(from);
-  Spill(tail);
+bool FlowGraphAllocator::CanShareSpillSlot(intptr_t idx, LiveRange* range) {
+  // Slots of incoming parameters and constants of catch blocks are not
+  // tracked and can only be reused after their end.
+  ZoneGrowableArray<LiveRange*>* ranges = spill_slot_ranges_[idx];
+  if (ranges == NULL) return false;
+
+  // The value is stored into the slot right after its definition and kept
+  // there until its last use, so the slot is in use exactly where the value
+  // is live. Control flow can't reach a use of a value from a lifetime hole,
+  // so another value can be stored into the slot there.
+  for (intptr_t i = 0; i < ranges->length(); i++) {
+    if (LiveRangesInterfere((*ranges)[i], range)) return false;
+  }
+  return true;
+}
+
+void FlowGraphAllocator::AddSpillSlotRange(intptr_t idx, LiveRange* range) {
+  ZoneGrowableArray<LiveRange*>* ranges = spill_slot_ranges_[idx];
+  if (ranges == NULL) return;
+  if (ranges->length() == kMaxRangesPerSpillSlot) {
+    // Stop tracking the slot to bound allocation time. It can only be reused
+    // after the end of all ranges allocated to it.
+    spill_slot_ranges_[idx] = NULL;
+    return;
+  }
+  ranges->Add(range);
 }
 
 void FlowGraphAllocator::AllocateSpillSlotFor(LiveRange* range) {
@@ -1994,10 +2054,12 @@ void FlowGraphAllocator::AllocateSpillSlotFor(LiveRange* range) {
   intptr_t idx = register_kind_ == Location::kRegister
                      ? flow_graph_.graph_entry()->fixed_slot_count()
                      : 0;
+  // A slot which is still in use at the start of the range can be shared
+  // if the range fits into lifetime holes of all ranges using the slot.
   for (; idx < spill_slots_.length(); idx++) {
     if ((need_quad == quad_spill_slots_[idx]) &&
         (need_untagged == untagged_spill_slots_[idx]) &&
-        (spill_slots_[idx] <= start)) {
+        ((spill_slots_[idx] <= start) || CanShareSpillSlot(idx, range))) {
       break;
     }
   }
@@ -2006,6 +2068,7 @@ void FlowGraphAllocator::AllocateSpillSlotFor(LiveRange* range) {
     spill_slots_.Add(kMaxPosition);
     quad_spill_slots_.Add(false);
     untagged_spill_slots_.Add(false);
+    spill_slot_ranges_.Add(NULL);
   }
 
   if (idx == spill_slots_.length()) {
@@ -2015,19 +2078,23 @@ void FlowGraphAllocator::AllocateSpillSlotFor(LiveRange* range) {
     spill_slots_.Add(0);
     quad_spill_slots_.Add(need_quad);
     untagged_spill_slots_.Add(need_untagged);
+    spill_slot_ranges_.Add(new ZoneGrowableArray<LiveRange*>());
     if (need_quad) {  // Allocate two double stack slots if we need quad slot.
       spill_slots_.Add(0);
       quad_spill_slots_.Add(need_quad);
       untagged_spill_slots_.Add(need_untagged);
+      spill_slot_ranges_.Add(new ZoneGrowableArray<LiveRange*>());
     }
   }
 
-  // Set spill slot expiration boundary to the live range's end.
-  spill_slots_[idx] = end;
+  // Extend spill slot expiration boundary to the live range's end.
+  spill_slots_[idx] = Utils::Maximum(spill_slots_[idx], end);
+  AddSpillSlotRange(idx, range);
   if (need_quad) {
     ASSERT(quad_spill_slots_[idx] && quad_spill_slots_[idx + 1]);
     idx++;  // Use the higher index it corresponds to the lower stack address.
-    spill_slots_[idx] = end;
+    spill_slots_[idx] = Utils::Maximum(spill_slots_[idx], end);
+    AddSpillSlotRange(idx, range);
   } else {
     ASSERT(!quad_spill_slots_[idx]);
   }
@@ -2772,16 +2839,18 @@ bool FlowGraphAllocator::TargetLocationIsSpillSlot(LiveRange* range,
   return false;
 }
 
-void FlowGraphAllocator::ConnectSplitSiblings(LiveRange* parent,
-                                              BlockEntryInstr* source_block,
-                                              BlockEntryInstr* target_block) {
+bool FlowGraphAllocator::FindSplitSiblingsMove(LiveRange* parent,
+                                               BlockEntryInstr* source_block,
+                                               BlockEntryInstr* target_block,
+                                               Location* source,
+                                               Location* target) {
   TRACE_ALLOC(THR_Print("Connect v%" Pd " on the edge B%" Pd " -> B%" Pd "\n",
                         parent->vreg(), source_block->block_id(),
                         target_block->block_id()));
   if (parent->next_sibling() == NULL) {
     // Nothing to connect. The whole range was allocated to the same location.
     TRACE_ALLOC(THR_Print("range v%" Pd " has no siblings\n", parent->vreg()));
-    return;
+    return false;
   }
 
   const intptr_t source_pos = source_block->end_pos() - 1;
@@ -2789,8 +2858,8 @@ void FlowGraphAllocator::ConnectSplitSiblings(LiveRange* parent,
 
   const intptr_t target_pos = target_block->start_pos();
 
-  Location target;
-  Location source;
+  *target = Location();
+  *source = Location();
 
 #if defined(DEBUG)
   LiveRange* source_cover = NULL;
@@ -2798,17 +2867,17 @@ void FlowGraphAllocator::ConnectSplitSiblings(LiveRange* parent,
 #endif
 
   LiveRange* range = parent;
-  while ((range != NULL) && (source.IsInvalid() || target.IsInvalid())) {
+  while ((range != NULL) && (source->IsInvalid() || target->IsInvalid())) {
     if (range->CanCover(source_pos)) {
-      ASSERT(source.IsInvalid());
-      source = range->assigned_location();
+      ASSERT(source->IsInvalid());
+      *source = range->assigned_location();
 #if defined(DEBUG)
       source_cover = range;
 #endif
     }
     if (range->CanCover(target_pos)) {
-      ASSERT(target.IsInvalid());
-      target = range->assigned_location();
+      ASSERT(target->IsInvalid());
+      *target = range->assigned_location();
 #if defined(DEBUG)
       target_cover = range;
 #endif
@@ -2820,15 +2889,28 @@ void FlowGraphAllocator::ConnectSplitSiblings(LiveRange* parent,
   TRACE_ALLOC(THR_Print("connecting v%" Pd " between [%" Pd ", %" Pd ") {%s} "
                         "to [%" Pd ", %" Pd ") {%s}\n",
                         parent->vreg(), source_cover->Start(),
-                        source_cover->End(), source.Name(),
+                        source_cover->End(), source->Name(),
                         target_cover->Start(), target_cover->End(),
-                        target.Name()));
+                        target->Name()));
 
   // Siblings were allocated to the same register.
-  if (source.Equals(target)) return;
+  if (source->Equals(*target)) return false;
 
   // Values are eagerly spilled. Spill slot already contains appropriate value.
-  if (TargetLocationIsSpillSlot(parent, target)) {
+  if (TargetLocationIsSpillSlot(parent, *target)) {
+    return false;
+  }
+
+  return true;
+}
+
+void FlowGraphAllocator::ConnectSplitSiblings(LiveRange* parent,
+                                              BlockEntryInstr* source_block,
+                                              BlockEntryInstr* target_block) {
+  Location target;
+  Location source;
+  if (!FindSplitSiblingsMove(parent, source_block, target_block, &source,
+                             &target)) {
     return;
   }
 
@@ -2841,6 +2923,47 @@ void FlowGraphAllocator::ConnectSplitSiblings(LiveRange* parent,
   }
 }
 
+bool FlowGraphAllocator::TryConnectSplitSiblingsAtJoin(LiveRange* parent,
+                                                       JoinEntryInstr* join) {
+  // If the value has to be reloaded from the same stack slot into the same
+  // location on all incoming edges, a single move at the start of the join
+  // replaces the moves at the ends of all predecessors.
+  //
+  // The moves at the end of a predecessor, including phi moves, do not
+  // write the stack slot: the value is live across the edge, so the slot
+  // is not shared with any value defined by a phi or live at the start of
+  // the join. They can read the target location, which is only written
+  // afterwards.
+  Location common_source;
+  Location common_target;
+  for (intptr_t i = 0; i < join->PredecessorCount(); i++) {
+    BlockEntryInstr* pred = join->PredecessorAt(i);
+    if (pred->IsGraphEntry() || !pred->last_instruction()->IsGoto()) {
+      return false;
+    }
+    Location source;
+    Location target;
+    if (!FindSplitSiblingsMove(parent, pred, join, &source, &target)) {
+      return false;
+    }
+    if (!source.HasStackIndex()) {
+      return false;
+    }
+    if (i == 0) {
+      common_source = source;
+      common_target = target;
+    } else if (!source.Equals(common_source) ||
+               !target.Equals(common_target)) {
+      return false;
+    }
+  }
+
+  TRACE_ALLOC(THR_Print("Connect v%" Pd " at the start of join B%" Pd "\n",
+                        parent->vreg(), join->block_id()));
+  join->GetParallelMove()->AddMove(common_target, common_source);
+  return true;
+}
+
 void FlowGraphAllocator::ResolveControlFlow() {
   // Resolve linear control flow between touching split siblings
   // inside basic blocks.
@@ -2871,9 +2994,14 @@ void FlowGraphAllocator::ResolveControlFlow() {
   // Resolve non-linear control flow across branches.
   for (intptr_t i = 1; i < block_order_.length(); i++) {
     BlockEntryInstr* block = block_order_[i];
+    JoinEntryInstr* join = block->AsJoinEntry();
     BitVector* live = liveness_.GetLiveInSet(block);
     for (BitVector::Iterator it(live); !it.Done(); it.Advance()) {
       LiveRange* range = GetLiveRange(it.Current());
+      if ((join != NULL) && (join->PredecessorCount() > 1) &&
+          TryConnectSplitSiblingsAtJoin(range, join)) {
+        continue;
+      }
       for (intptr_t j = 0; j < block->PredecessorCount(); j++) {
         ConnectSplitSiblings(range, block->PredecessorAt(j), block);
       }
@@ -2960,6 +3088,54 @@ void FlowGraphAllocator::CollectRepresentations() {
   }
 }
 
+// Counts the spills (stores from registers into stack slots) and reloads
+// (loads from stack slots into registers) in the given parallel move.
+static void CountSpillsAndReloads(ParallelMoveInstr* parallel_move,
+                                  bool in_loop,
+                                  intptr_t* counts) {
+  if (parallel_move == NULL) return;
+  for (intptr_t i = 0; i < parallel_move->NumMoves(); i++) {
+    MoveOperands* move = parallel_move->MoveOperandsAt(i);
+    if (move->IsRedundant()) continue;
+    intptr_t index;
+    if (move->src().IsMachineRegister() && move->dest().HasStackIndex()) {
+      index = 0;
+    } else if (move->src().HasStackIndex() &&
+               move->dest().IsMachineRegister()) {
+      index = 2;
+    } else {
+      continue;
+    }
+    counts[index]++;
+    if (in_loop) counts[index + 1]++;
+  }
+}
+
+void FlowGraphAllocator::PrintAllocationStatistics() const {
+  // Spills, spills in loops, reloads, reloads in loops.
+  intptr_t counts[4] = {0, 0, 0, 0};
+  for (intptr_t i = 0; i < block_order_.length(); i++) {
+    BlockEntryInstr* block = block_order_[i];
+    const bool in_loop = block->loop_info() != nullptr;
+    CountSpillsAndReloads(block->parallel_move(), in_loop, counts);
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* current = it.Current();
+      if (current->IsParallelMove()) {
+        CountSpillsAndReloads(current->AsParallelMove(), in_loop, counts);
+      } else if (current->IsGoto()) {
+        CountSpillsAndReloads(current->AsGoto()->parallel_move(), in_loop,
+                              counts);
+      }
+    }
+  }
+  THR_Print("Register allocation [%s]: %" Pd " spills (%" Pd
+            " in loops), %" Pd " reloads (%" Pd " in loops), %" Pd
+            " spill slots\n",
+            flow_graph_.function().ToFullyQualifiedCString(), counts[0],
+            counts[1], counts[2], counts[3],
+            flow_graph_.graph_entry()->spill_slot_count());
+}
+
 void FlowGraphAllocator::AllocateRegisters() {
   CollectRepresentations();
 
@@ -3015,6 +3191,7 @@ void FlowGraphAllocator::AllocateRegisters() {
   spill_slots_.Clear();
   quad_spill_slots_.Clear();
   untagged_spill_slots_.Clear();
+  spill_slot_ranges_.Clear();
 
   PrepareForAllocation(Location::kFpuRegister, kNumberOfFpuRegisters,
                        unallocated_xmm_, fpu_regs_, blocked_fpu_registers_);
@@ -3050,6 +3227,10 @@ void FlowGraphAllocator::AllocateRegisters() {
                               (last_used_fpu_register + 1));
 #endif
 
+  if (FLAG_print_register_allocation_stats) {
+    PrintAllocationStatistics();
+  }
+
   if (FLAG_print_ssa_liveranges) {
     const Function& function = flow_graph_.function();
 
@@ -159,6 +159,19 @@ class FlowGraphAllocator : public ValueObject {
                             BlockEntryInstr* source_block,
                             BlockEntryInstr* target_block);
 
+  // Finds the locations of the split siblings of the given range at the end
+  // of the source block and at the start of the target block. Returns false
+  // if no move is needed on the edge between them.
+  bool FindSplitSiblingsMove(LiveRange* parent,
+                             BlockEntryInstr* source_block,
+                             BlockEntryInstr* target_block,
+                             Location* source,
+                             Location* target);
+
+  // Connects split siblings with a single move at the start of the join
+  // instead of moves on all incoming edges, if possible.
+  bool TryConnectSplitSiblingsAtJoin(LiveRange* range, JoinEntryInstr* join);
+
   // Returns true if the target location is the spill slot for the given range.
   bool TargetLocationIsSpillSlot(LiveRange* range, Location target);
 
@@ -220,9 +233,20 @@ class FlowGraphAllocator : public ValueObject {
   // Find a spill slot that can be used by the given live range.
   void AllocateSpillSlotFor(LiveRange* range);
 
+  // Returns true if the given live range does not interfere with any of
+  // the live ranges allocated to the given spill slot.
+  bool CanShareSpillSlot(intptr_t idx, LiveRange* range);
+  void AddSpillSlotRange(intptr_t idx, LiveRange* range);
+
   // Allocate the given live range to a spill slot.
   void Spill(LiveRange* range);
 
+  // Returns the position at which the given live range should be spilled
+  // if it has to be spilled at the given position and does not need a
+  // register until the to position: the header of the outermost loop which
+  // contains the spill position and can use the spill slot throughout.
+  intptr_t LoopAwareSpillPosition(LiveRange* range, intptr_t from, intptr_t to);
+
   // Spill the given live range from the given position onwards.
   void SpillAfter(LiveRange* range, intptr_t from);
 
@@ -244,6 +268,9 @@ class FlowGraphAllocator : public ValueObject {
 
   void PrintLiveRanges();
 
+  // Prints the number of spills and reloads inserted by the allocator.
+  void PrintAllocationStatistics() const;
+
   const FlowGraph& flow_graph_;
 
   ReachingDefs reaching_defs_;
@@ -326,6 +353,12 @@ class FlowGraphAllocator : public ValueObject {
   // #18955 for details.
   GrowableArray<bool> untagged_spill_slots_;
 
+  // For every used spill slot contains the live ranges allocated to it, so
+  // that ranges can share the slot if they are not live at the same time.
+  // NULL if the slot is not tracked and can't be shared.
+  GrowableArray<ZoneGrowableArray<LiveRange*>*> spill_slot_ranges_;
+  static const intptr_t kMaxRangesPerSpillSlot = 16;
+
   intptr_t cpu_spill_slot_count_;
 
   const bool intrinsic_mode_;
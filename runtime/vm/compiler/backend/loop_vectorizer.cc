@@ -0,0 +1,642 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+
+#include "vm/bit_vector.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/compiler/backend/range_analysis.h"
+#include "vm/hash_map.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            loop_vectorization,
+            true,
+            "Vectorize simple loops over typed data.");
+DEFINE_FLAG(bool, trace_loop_vectorization, false, "Trace loop vectorization.");
+
+// Number of bytes processed per array in one iteration of a vector loop.
+static const intptr_t kVectorSizeInBytes = 16;
+
+// Returns true if elements of the given typed data class can be moved
+// around as raw bits without changing the values a scalar loop would see.
+static bool IsCopyableElementCid(intptr_t cid) {
+  switch (cid) {
+    case kTypedDataInt8ArrayCid:
+    case kTypedDataUint8ArrayCid:
+    case kTypedDataUint8ClampedArrayCid:
+    case kTypedDataInt16ArrayCid:
+    case kTypedDataUint16ArrayCid:
+    case kTypedDataInt32ArrayCid:
+    case kTypedDataUint32ArrayCid:
+    case kTypedDataInt64ArrayCid:
+    case kTypedDataUint64ArrayCid:
+    case kTypedDataFloat64ArrayCid:
+      return true;
+    default:
+      // Float32 loads widen to double, which does not preserve all NaN
+      // payloads, and the SIMD element lists are already vectors.
+      return false;
+  }
+}
+
+// Analysis and rewriting of a single candidate loop.
+class VectorizableLoop : public ZoneAllocated {
+ public:
+  VectorizableLoop(FlowGraph* flow_graph, LoopInfo* loop)
+      : flow_graph_(flow_graph),
+        zone_(flow_graph->zone()),
+        loop_(loop),
+        header_(nullptr),
+        preheader_(nullptr),
+        index_(nullptr),
+        increment_(nullptr),
+        body_entry_(nullptr),
+        exit_(nullptr),
+        back_edge_(nullptr),
+        element_size_(0),
+        has_arithmetic_(false),
+        bounds_(),
+        arrays_(),
+        array_cids_(),
+        body_(),
+        source_cids_(),
+        vectors_(),
+        splats_() {}
+
+  // Returns true if the loop has the supported shape.
+  bool CanVectorize();
+
+  // Inserts the vector loop in front of the (unchanged) scalar loop.
+  // Block order and dominators must be recomputed afterwards.
+  void Vectorize();
+
+ private:
+  typedef RawPointerKeyValueTrait<Definition, Definition*> DefinitionKV;
+  typedef RawPointerKeyValueTrait<Definition, intptr_t> CidKV;
+
+  bool IsInvariant(Definition* def) const {
+    return !loop_->Contains(def->GetBlock());
+  }
+
+  // Returns true if [value] is the loop index, possibly through bounds checks.
+  bool IsIndex(Value* value) const {
+    return value->definition()->OriginalDefinition() == index_;
+  }
+
+  bool IsVector(Definition* def) const {
+    return source_cids_.Lookup(def) != nullptr;
+  }
+
+  bool IsInvariantDouble(Definition* def) const {
+    return IsInvariant(def) && (def->representation() == kUnboxedDouble);
+  }
+
+  void AddBound(Definition* def);
+  bool AddArray(Value* array, intptr_t cid, intptr_t index_scale);
+
+  bool AnalyzeHeader();
+  bool AnalyzeBody();
+  bool AnalyzeInstruction(Instruction* instr);
+
+  Definition* VectorFor(Definition* def, Instruction* pre_goto);
+  Instruction* EmitVector(Instruction* cursor,
+                          Instruction* instr,
+                          Definition* vector_index,
+                          Instruction* pre_goto);
+
+  intptr_t VectorCid() const {
+    return (array_cids_[0] == kTypedDataFloat64ArrayCid)
+               ? kTypedDataFloat64x2ArrayCid
+               : kTypedDataInt32x4ArrayCid;
+  }
+
+  FlowGraph* flow_graph_;
+  Zone* zone_;
+  LoopInfo* loop_;
+
+  JoinEntryInstr* header_;
+  BlockEntryInstr* preheader_;
+  PhiInstr* index_;
+  Definition* increment_;
+  TargetEntryInstr* body_entry_;
+  TargetEntryInstr* exit_;
+  GotoInstr* back_edge_;
+
+  // Size of the elements of all accessed arrays.
+  intptr_t element_size_;
+
+  // True if the body computes on Float64 elements rather than copying them.
+  bool has_arithmetic_;
+
+  // Loop invariant upper bounds of the index.
+  GrowableArray<Definition*> bounds_;
+
+  // Accessed arrays and their class ids.
+  GrowableArray<Definition*> arrays_;
+  GrowableArray<intptr_t> array_cids_;
+
+  // Instructions of the body that are rewritten, in order.
+  GrowableArray<Instruction*> body_;
+
+  // Definitions computing element values, mapped to the class id of the
+  // array the value was loaded from (or kDoubleCid for computed values).
+  DirectChainedHashMap<CidKV> source_cids_;
+
+  // Scalar definitions mapped to their vector replacements.
+  DirectChainedHashMap<DefinitionKV> vectors_;
+
+  // Invariant doubles mapped to their splat in the preheader.
+  DirectChainedHashMap<DefinitionKV> splats_;
+
+  DISALLOW_COPY_AND_ASSIGN(VectorizableLoop);
+};
+
+void VectorizableLoop::AddBound(Definition* def) {
+  for (intptr_t i = 0; i < bounds_.length(); i++) {
+    if (bounds_[i] == def) return;
+  }
+  bounds_.Add(def);
+}
+
+bool VectorizableLoop::AddArray(Value* array, intptr_t cid, intptr_t scale) {
+  Definition* def = array->definition();
+  if (!IsInvariant(def) || (def->representation() != kTagged) ||
+      !RawObject::IsTypedDataClassId(cid) || !IsCopyableElementCid(cid) ||
+      (scale != TypedData::ElementSizeInBytes(cid))) {
+    return false;
+  }
+  if (element_size_ == 0) {
+    element_size_ = scale;
+  } else if (element_size_ != scale) {
+    return false;
+  }
+  for (intptr_t i = 0; i < arrays_.length(); i++) {
+    if (arrays_[i] == def) {
+      return array_cids_[i] == cid;
+    }
+  }
+  arrays_.Add(def);
+  array_cids_.Add(cid);
+  return true;
+}
+
+bool VectorizableLoop::CanVectorize() {
+  if (loop_->inner() != nullptr) return false;  // innermost only
+  header_ = loop_->header()->AsJoinEntry();
+  if ((header_ == nullptr) || (header_->PredecessorCount() != 2) ||
+      (loop_->back_edges().length() != 1)) {
+    return false;
+  }
+  // The scalar loop becomes the successor of the vector loop, which is
+  // discovered before the back edge, so the entry must be the first input.
+  preheader_ = header_->PredecessorAt(0);
+  if (loop_->Contains(preheader_) ||
+      (header_->PredecessorAt(1) != loop_->back_edges()[0]) ||
+      !preheader_->last_instruction()->IsGoto()) {
+    return false;
+  }
+  return AnalyzeHeader() && AnalyzeBody();
+}
+
+bool VectorizableLoop::AnalyzeHeader() {
+  // A single Smi index phi.
+  PhiIterator phis(header_);
+  if (phis.Done()) return false;
+  index_ = phis.Current();
+  phis.Advance();
+  if (!phis.Done()) return false;
+  if ((index_->representation() != kTagged) ||
+      (index_->Type()->ToCid() != kSmiCid)) {
+    return false;
+  }
+
+  // Incremented by one per iteration.
+  BinarySmiOpInstr* add =
+      index_->InputAt(1)->definition()->AsBinarySmiOp();
+  if ((add == nullptr) || (add->op_kind() != Token::kADD) ||
+      !loop_->Contains(add->GetBlock())) {
+    return false;
+  }
+  Value* step = nullptr;
+  if (add->left()->definition() == index_) {
+    step = add->right();
+  } else if (add->right()->definition() == index_) {
+    step = add->left();
+  } else {
+    return false;
+  }
+  if (!step->BindsToConstant() || !step->BoundConstant().IsSmi() ||
+      (Smi::Cast(step->BoundConstant()).Value() != 1)) {
+    return false;
+  }
+  Value* use = add->input_use_list();
+  if ((use == nullptr) || (use->next_use() != nullptr) ||
+      (use->instruction() != index_)) {
+    return false;
+  }
+  increment_ = add;
+
+  // The vector loop accesses elements from the initial index on before the
+  // scalar loop checks any bounds, and its index update is emitted without
+  // an overflow check. Both are only safe for a small non-negative start.
+  Value* init = index_->InputAt(0);
+  const int64_t kMaxStart = compiler::target::kSmiMax - kVectorSizeInBytes;
+  if (init->BindsToConstant()) {
+    const Object& start = init->BoundConstant();
+    if (!start.IsSmi() || (Smi::Cast(start).Value() < 0) ||
+        (Smi::Cast(start).Value() > kMaxStart)) {
+      return false;
+    }
+  } else if (!RangeUtils::IsWithin(init->definition()->range(), 0,
+                                   kMaxStart)) {
+    return false;
+  }
+
+  // Only a stack overflow check before the exit test.
+  Instruction* current = header_->next();
+  while (current->IsCheckStackOverflow()) {
+    current = current->next();
+  }
+  BranchInstr* branch = current->AsBranch();
+  if (branch == nullptr) return false;
+  RelationalOpInstr* compare = branch->comparison()->AsRelationalOp();
+  if ((compare == nullptr) || (compare->operation_cid() != kSmiCid)) {
+    return false;
+  }
+  Definition* limit = nullptr;
+  if ((compare->kind() == Token::kLT) &&
+      (compare->left()->definition() == index_)) {
+    limit = compare->right()->definition();
+  } else if ((compare->kind() == Token::kGT) &&
+             (compare->right()->definition() == index_)) {
+    limit = compare->left()->definition();
+  } else {
+    return false;
+  }
+  if (!IsInvariant(limit)) return false;
+  AddBound(limit);
+
+  body_entry_ = branch->true_successor();
+  exit_ = branch->false_successor();
+  return loop_->Contains(body_entry_) && !loop_->Contains(exit_);
+}
+
+bool VectorizableLoop::AnalyzeBody() {
+  intptr_t num_blocks = 1;  // header
+  BlockEntryInstr* block = body_entry_;
+  while (true) {
+    if (block->try_index() != header_->try_index()) return false;
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      Instruction* current = it.Current();
+      if (current == block->last_instruction()) break;
+      if (!AnalyzeInstruction(current)) {
+        if (FLAG_trace_loop_vectorization) {
+          THR_Print("Not vectorizing B%" Pd ": %s\n", header_->block_id(),
+                    current->ToCString());
+        }
+        return false;
+      }
+    }
+    num_blocks++;
+    GotoInstr* last = block->last_instruction()->AsGoto();
+    if (last == nullptr) return false;
+    JoinEntryInstr* successor = last->successor();
+    if (successor == header_) {
+      back_edge_ = last;
+      break;
+    }
+    // Straight-line continuation, e.g. a join left by a 'continue' target.
+    if (!loop_->Contains(successor) || (successor->PredecessorCount() != 1) ||
+        (successor->phis() != nullptr && successor->phis()->length() > 0)) {
+      return false;
+    }
+    block = successor;
+  }
+
+  intptr_t num_loop_blocks = 0;
+  for (BitVector::Iterator it(loop_->blocks()); !it.Done(); it.Advance()) {
+    num_loop_blocks++;
+  }
+  if (num_loop_blocks != num_blocks) return false;
+
+  // Something must be stored, and arithmetic is only done on doubles.
+  bool has_store = false;
+  for (intptr_t i = 0; i < body_.length(); i++) {
+    if (body_[i]->IsStoreIndexed()) has_store = true;
+  }
+  if (!has_store) return false;
+  if (has_arithmetic_) {
+    for (intptr_t i = 0; i < array_cids_.length(); i++) {
+      if (array_cids_[i] != kTypedDataFloat64ArrayCid) return false;
+    }
+  }
+  return true;
+}
+
+bool VectorizableLoop::AnalyzeInstruction(Instruction* instr) {
+  if (instr == increment_) {
+    return true;  // Replaced by the vector index update.
+  }
+
+  if (CheckBoundBase* check = instr->AsCheckBoundBase()) {
+    // Subsumed by the vector loop bound; the scalar loop keeps it.
+    Definition* length = check->length()->definition();
+    if (!IsIndex(check->index()) || !IsInvariant(length)) return false;
+    AddBound(length);
+    return true;
+  }
+
+  if (LoadIndexedInstr* load = instr->AsLoadIndexed()) {
+    if (!IsIndex(load->index()) ||
+        !AddArray(load->array(), load->class_id(), load->index_scale())) {
+      return false;
+    }
+    source_cids_.Insert(CidKV::Pair(load, load->class_id()));
+    body_.Add(load);
+    return true;
+  }
+
+  if (StoreIndexedInstr* store = instr->AsStoreIndexed()) {
+    if (!IsIndex(store->index()) ||
+        !AddArray(store->array(), store->class_id(), store->index_scale())) {
+      return false;
+    }
+    CidKV::Pair* source = source_cids_.Lookup(store->value()->definition());
+    if (source == nullptr) return false;
+    // Storing into a clamped array clamps signed values.
+    if ((store->class_id() == kTypedDataUint8ClampedArrayCid) &&
+        (source->value != kTypedDataUint8ArrayCid) &&
+        (source->value != kTypedDataUint8ClampedArrayCid)) {
+      return false;
+    }
+    body_.Add(store);
+    return true;
+  }
+
+  if (IntConverterInstr* convert = instr->AsIntConverter()) {
+    // Reinterprets the same bits, which a store then truncates.
+    CidKV::Pair* source = source_cids_.Lookup(convert->value()->definition());
+    if ((source == nullptr) || convert->ComputeCanDeoptimize()) return false;
+    source_cids_.Insert(CidKV::Pair(convert, source->value));
+    body_.Add(convert);
+    return true;
+  }
+
+  // Element-wise double arithmetic.
+  bool is_arithmetic = false;
+  if (BinaryDoubleOpInstr* op = instr->AsBinaryDoubleOp()) {
+    switch (op->op_kind()) {
+      case Token::kADD:
+      case Token::kSUB:
+      case Token::kMUL:
+      case Token::kDIV:
+        break;
+      default:
+        return false;
+    }
+    Definition* left = op->left()->definition();
+    Definition* right = op->right()->definition();
+    is_arithmetic = (IsVector(left) || IsVector(right)) &&
+                    (IsVector(left) || IsInvariantDouble(left)) &&
+                    (IsVector(right) || IsInvariantDouble(right));
+  } else if (UnaryDoubleOpInstr* op = instr->AsUnaryDoubleOp()) {
+    is_arithmetic = IsVector(op->value()->definition());
+  } else if (MathUnaryInstr* op = instr->AsMathUnary()) {
+    is_arithmetic = IsVector(op->value()->definition());
+  }
+  if (is_arithmetic) {
+    has_arithmetic_ = true;
+    source_cids_.Insert(CidKV::Pair(instr->AsDefinition(), kDoubleCid));
+    body_.Add(instr);
+    return true;
+  }
+
+  return false;
+}
+
+Definition* VectorizableLoop::VectorFor(Definition* def,
+                                        Instruction* pre_goto) {
+  DefinitionKV::Pair* vector = vectors_.Lookup(def);
+  if (vector != nullptr) {
+    return vector->value;
+  }
+  // Invariant operands are broadcast once in the preheader.
+  ASSERT(IsInvariantDouble(def));
+  DefinitionKV::Pair* splat = splats_.Lookup(def);
+  if (splat != nullptr) {
+    return splat->value;
+  }
+  SimdOpInstr* result = SimdOpInstr::Create(
+      SimdOpInstr::kFloat64x2Splat, new (zone_) Value(def), DeoptId::kNone);
+  flow_graph_->InsertBefore(pre_goto, result, nullptr, FlowGraph::kValue);
+  splats_.Insert(DefinitionKV::Pair(def, result));
+  return result;
+}
+
+Instruction* VectorizableLoop::EmitVector(Instruction* cursor,
+                                          Instruction* instr,
+                                          Definition* vector_index,
+                                          Instruction* pre_goto) {
+  const intptr_t vector_cid = VectorCid();
+  Definition* result = nullptr;
+  if (LoadIndexedInstr* load = instr->AsLoadIndexed()) {
+    result = new (zone_) LoadIndexedInstr(
+        new (zone_) Value(load->array()->definition()),
+        new (zone_) Value(vector_index), element_size_, vector_cid,
+        kAlignedAccess, DeoptId::kNone, load->token_pos());
+  } else if (StoreIndexedInstr* store = instr->AsStoreIndexed()) {
+    Definition* value = VectorFor(store->value()->definition(), pre_goto);
+    StoreIndexedInstr* vector_store = new (zone_) StoreIndexedInstr(
+        new (zone_) Value(store->array()->definition()),
+        new (zone_) Value(vector_index), new (zone_) Value(value),
+        kNoStoreBarrier, element_size_, vector_cid, kAlignedAccess,
+        DeoptId::kNone, store->token_pos(), Instruction::kNotSpeculative);
+    return flow_graph_->AppendTo(cursor, vector_store, nullptr,
+                                 FlowGraph::kEffect);
+  } else if (IntConverterInstr* convert = instr->AsIntConverter()) {
+    vectors_.Insert(DefinitionKV::Pair(
+        convert, VectorFor(convert->value()->definition(), pre_goto)));
+    return cursor;
+  } else if (BinaryDoubleOpInstr* op = instr->AsBinaryDoubleOp()) {
+    Definition* left = VectorFor(op->left()->definition(), pre_goto);
+    Definition* right = VectorFor(op->right()->definition(), pre_goto);
+    result = SimdOpInstr::Create(
+        SimdOpInstr::KindForOperator(kFloat64x2Cid, op->op_kind()),
+        new (zone_) Value(left), new (zone_) Value(right), DeoptId::kNone);
+  } else if (UnaryDoubleOpInstr* op = instr->AsUnaryDoubleOp()) {
+    ASSERT(op->op_kind() == Token::kNEGATE);
+    result = SimdOpInstr::Create(
+        SimdOpInstr::kFloat64x2Negate,
+        new (zone_) Value(VectorFor(op->value()->definition(), pre_goto)),
+        DeoptId::kNone);
+  } else if (MathUnaryInstr* op = instr->AsMathUnary()) {
+    Definition* value = VectorFor(op->value()->definition(), pre_goto);
+    if (op->kind() == MathUnaryInstr::kSqrt) {
+      result = SimdOpInstr::Create(SimdOpInstr::kFloat64x2Sqrt,
+                                   new (zone_) Value(value), DeoptId::kNone);
+    } else {
+      ASSERT(op->kind() == MathUnaryInstr::kDoubleSquare);
+      result = SimdOpInstr::Create(SimdOpInstr::kFloat64x2Mul,
+                                   new (zone_) Value(value),
+                                   new (zone_) Value(value), DeoptId::kNone);
+    }
+  } else {
+    UNREACHABLE();
+  }
+  vectors_.Insert(DefinitionKV::Pair(instr->AsDefinition(), result));
+  return flow_graph_->AppendTo(cursor, result, nullptr, FlowGraph::kValue);
+}
+
+//
+// Rewrites
+//
+//     preheader:  goto header
+//     header:     i = phi(init, i + 1); if (i < n) body else exit
+//
+// into
+//
+//     preheader:  limit = min(n, lengths...); goto vheader
+//     vheader:    vi = phi(init, vnext); vnext = vi + W;
+//                 if (vnext <= limit) vbody else vexit
+//     vbody:      <vector body at vi>; goto vheader
+//     vexit:      goto header
+//     header:     i = phi(vi, i + 1); if (i < n) body else exit
+//
+void VectorizableLoop::Vectorize() {
+  GotoInstr* pre_goto = preheader_->last_instruction()->AsGoto();
+  const intptr_t try_index = header_->try_index();
+  const intptr_t width = kVectorSizeInBytes / element_size_;
+
+  // The vector loop stops before any lane would be out of bounds of any
+  // array, whatever bounds checks the scalar body still performs.
+  for (intptr_t i = 0; i < arrays_.length(); i++) {
+    LoadFieldInstr* length = new (zone_) LoadFieldInstr(
+        new (zone_) Value(arrays_[i]),
+        Slot::GetLengthFieldForArrayCid(array_cids_[i]),
+        pre_goto->token_pos());
+    flow_graph_->InsertBefore(pre_goto, length, nullptr, FlowGraph::kValue);
+    AddBound(length);
+  }
+  Definition* limit = bounds_[0];
+  for (intptr_t i = 1; i < bounds_.length(); i++) {
+    MathMinMaxInstr* min = new (zone_) MathMinMaxInstr(
+        MethodRecognizer::kMathMin, new (zone_) Value(limit),
+        new (zone_) Value(bounds_[i]), DeoptId::kNone, kSmiCid);
+    flow_graph_->InsertBefore(pre_goto, min, nullptr, FlowGraph::kValue);
+    limit = min;
+  }
+
+  // Vector loop header.
+  JoinEntryInstr* vheader = new (zone_) JoinEntryInstr(
+      flow_graph_->allocate_block_id(), try_index, DeoptId::kNone);
+  PhiInstr* vindex = new (zone_) PhiInstr(vheader, 2);
+  flow_graph_->AllocateSSAIndexes(vindex);
+  vindex->mark_alive();
+  vindex->UpdateType(CompileType::FromCid(kSmiCid));
+  vheader->InsertPhi(vindex);
+
+  const Smi& width_smi = Smi::ZoneHandle(zone_, Smi::New(width));
+  BinarySmiOpInstr* vnext = new (zone_) BinarySmiOpInstr(
+      Token::kADD, new (zone_) Value(vindex),
+      new (zone_) Value(flow_graph_->GetConstant(width_smi)), DeoptId::kNone);
+  // Cannot overflow: vindex is either the initial index, which is at most
+  // kSmiMax - kVectorSizeInBytes, or at most the length of an array.
+  vnext->set_can_overflow(false);
+  flow_graph_->AppendTo(vheader, vnext, nullptr, FlowGraph::kValue);
+
+  Value* init = index_->InputAt(0);
+  Value* input = new (zone_) Value(init->definition());
+  vindex->SetInputAt(0, input);
+  input->definition()->AddInputUse(input);
+  input = new (zone_) Value(vnext);
+  vindex->SetInputAt(1, input);
+  vnext->AddInputUse(input);
+
+  RelationalOpInstr* compare = new (zone_) RelationalOpInstr(
+      header_->token_pos(), Token::kLTE, new (zone_) Value(vnext),
+      new (zone_) Value(limit), kSmiCid, DeoptId::kNone,
+      Instruction::kNotSpeculative);
+  BranchInstr* branch = new (zone_) BranchInstr(compare, DeoptId::kNone);
+  vnext->AppendInstruction(branch);
+  vheader->set_last_instruction(branch);
+
+  // Vector loop body.
+  TargetEntryInstr* vbody = new (zone_) TargetEntryInstr(
+      flow_graph_->allocate_block_id(), try_index, DeoptId::kNone);
+  vbody->set_edge_weight(body_entry_->edge_weight());
+  Instruction* cursor = vbody;
+  for (intptr_t i = 0; i < body_.length(); i++) {
+    cursor = EmitVector(cursor, body_[i], vindex, pre_goto);
+  }
+  GotoInstr* vback = new (zone_) GotoInstr(vheader, DeoptId::kNone);
+  vback->set_edge_weight(back_edge_->edge_weight());
+  cursor->AppendInstruction(vback);
+  vbody->set_last_instruction(vback);
+
+  // Vector loop exit continues with the scalar loop.
+  TargetEntryInstr* vexit = new (zone_) TargetEntryInstr(
+      flow_graph_->allocate_block_id(), try_index, DeoptId::kNone);
+  vexit->set_edge_weight(exit_->edge_weight());
+  GotoInstr* vdone = new (zone_) GotoInstr(header_, DeoptId::kNone);
+  vdone->set_edge_weight(pre_goto->edge_weight());
+  vexit->AppendInstruction(vdone);
+  vexit->set_last_instruction(vdone);
+
+  *branch->true_successor_address() = vbody;
+  *branch->false_successor_address() = vexit;
+
+  pre_goto->set_successor(vheader);
+  init->BindTo(vindex);
+
+  if (FLAG_trace_loop_vectorization) {
+    THR_Print("Vectorized loop B%" Pd " by %" Pd " in B%" Pd "\n",
+              header_->block_id(), width, vheader->block_id());
+  }
+}
+
+void LoopVectorizer::Optimize(FlowGraph* flow_graph) {
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+  if (!FLAG_loop_vectorization ||
+      !FlowGraphCompiler::SupportsUnboxedSimd128() ||
+      flow_graph->IsCompiledForOsr()) {
+    return;
+  }
+
+  // Find all candidates before changing the graph. Rewriting one loop only
+  // touches its own preheader edge, so the others stay valid.
+  const LoopHierarchy& loop_hierarchy = flow_graph->GetLoopHierarchy();
+  const ZoneGrowableArray<BlockEntryInstr*>& headers =
+      loop_hierarchy.headers();
+  GrowableArray<VectorizableLoop*> candidates;
+  for (intptr_t i = 0; i < headers.length(); i++) {
+    VectorizableLoop* loop = new (flow_graph->zone())
+        VectorizableLoop(flow_graph, headers[i]->loop_info());
+    if (loop->CanVectorize()) {
+      candidates.Add(loop);
+    }
+  }
+  if (candidates.is_empty()) {
+    return;
+  }
+
+  for (intptr_t i = 0; i < candidates.length(); i++) {
+    candidates[i]->Vectorize();
+  }
+
+  flow_graph->DiscoverBlocks();
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph->ComputeDominators(&dominance_frontier);
+#endif  // defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+}
+
+}  // namespace dart
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
@@ -0,0 +1,40 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+class FlowGraph;
+
+// Vectorizes simple counted loops over typed data.
+//
+// An innermost loop of the form
+//
+//     for (int i = init; i < n; i++) {
+//       c[i] = a[i] op b[i];   // or any expression tree of such accesses
+//     }
+//
+// where every typed data access uses exactly the loop index is preceded by a
+// SIMD loop that handles 16 bytes of every array per iteration. The original
+// loop is kept unchanged as the scalar epilogue and starts where the vector
+// loop stopped. The vector loop only runs while all lanes are in bounds of
+// every array, so out-of-bounds behavior (and any deoptimization) is left to
+// the scalar loop.
+//
+// Supported are Float64 element-wise +, -, *, /, negation and sqrt, which
+// have the same IEEE semantics per lane, and copies between integer or
+// Float64 arrays with the same element size. Reductions are not vectorized
+// since reassociating floating point sums would change their results.
+class LoopVectorizer : public AllStatic {
+ public:
+  static void Optimize(FlowGraph* flow_graph);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
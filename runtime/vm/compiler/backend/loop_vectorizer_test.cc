@@ -0,0 +1,124 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Unit tests for the vectorization of loops over typed data.
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il_printer.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+// Runs the full JIT pipeline on 'foo' and counts the vector accesses and
+// SIMD operations in the resulting graph.
+static void CountVectorInstructions(Thread* thread,
+                                    const char* script_chars,
+                                    intptr_t* vector_accesses,
+                                    intptr_t* simd_ops) {
+  const auto& root_library = Library::Handle(LoadTestScript(script_chars));
+  Invoke(root_library, "main");
+
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  *vector_accesses = 0;
+  *simd_ops = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      Instruction* current = it.Current();
+      intptr_t cid = kIllegalCid;
+      if (LoadIndexedInstr* load = current->AsLoadIndexed()) {
+        cid = load->class_id();
+      } else if (StoreIndexedInstr* store = current->AsStoreIndexed()) {
+        cid = store->class_id();
+      } else if (current->IsSimdOp()) {
+        (*simd_ops)++;
+      }
+      if ((cid == kTypedDataFloat64x2ArrayCid) ||
+          (cid == kTypedDataInt32x4ArrayCid)) {
+        (*vector_accesses)++;
+      }
+    }
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorizer_Float64Arithmetic) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+  const char* script_chars =
+      R"(
+      import 'dart:typed_data';
+      foo(Float64List a, Float64List b, Float64List c, double s) {
+        for (int i = 0; i < c.length; i++) {
+          c[i] = (a[i] + b[i]) * s;
+        }
+      }
+      main() {
+        final list = new Float64List(10);
+        foo(list, list, list, 2.0);
+      }
+    )";
+  intptr_t vector_accesses = 0;
+  intptr_t simd_ops = 0;
+  CountVectorInstructions(thread, script_chars, &vector_accesses, &simd_ops);
+  EXPECT_EQ(3, vector_accesses);  // two loads, one store
+  EXPECT_EQ(3, simd_ops);         // add, splat, mul
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorizer_Uint8Copy) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+  const char* script_chars =
+      R"(
+      import 'dart:typed_data';
+      foo(Uint8List from, Uint8List to) {
+        for (int i = 0; i < to.length; i++) {
+          to[i] = from[i];
+        }
+      }
+      main() {
+        foo(new Uint8List(10), new Uint8List(10));
+      }
+    )";
+  intptr_t vector_accesses = 0;
+  intptr_t simd_ops = 0;
+  CountVectorInstructions(thread, script_chars, &vector_accesses, &simd_ops);
+  EXPECT_EQ(2, vector_accesses);
+  EXPECT_EQ(0, simd_ops);
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorizer_NoReduction) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) return;
+  // Summing in a different order would change the result.
+  const char* script_chars =
+      R"(
+      import 'dart:typed_data';
+      foo(Float64List a) {
+        double sum = 0.0;
+        for (int i = 0; i < a.length; i++) {
+          sum += a[i];
+        }
+        return sum;
+      }
+      main() {
+        foo(new Float64List(10));
+      }
+    )";
+  intptr_t vector_accesses = 0;
+  intptr_t simd_ops = 0;
+  CountVectorInstructions(thread, script_chars, &vector_accesses, &simd_ops);
+  EXPECT_EQ(0, vector_accesses);
+  EXPECT_EQ(0, simd_ops);
+}
+
+#endif  // defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+}  // namespace dart
@@ -816,6 +816,10 @@ class BoundsCheckGeneralizer {
     // AOT should only see non-deopting GenericCheckBound.
     ASSERT(!FLAG_precompiled_mode);
 
+    // Number of new checks in preheaders, the scheduler reuses equivalent
+    // checks that it emitted for earlier generalizations.
+    intptr_t num_hoisted = 0;
+
     ConstantInstr* max_smi = flow_graph_->GetConstant(
         Smi::Handle(Smi::New(compiler::target::kSmiMax)));
     for (intptr_t i = 0; i < non_positive_symbols.length(); i++) {
@@ -823,14 +827,17 @@ class BoundsCheckGeneralizer {
           new Value(max_smi), new Value(non_positive_symbols[i]),
           DeoptId::kNone);
       precondition->mark_generalized();
-      precondition = scheduler_.Emit(precondition, check);
-      if (precondition == NULL) {
+      CheckArrayBoundInstr* emitted = scheduler_.Emit(precondition, check);
+      if (emitted == NULL) {
         if (FLAG_trace_range_analysis) {
           THR_Print("  => failed to insert positivity constraint\n");
         }
         scheduler_.Rollback();
         return;
       }
+      if (emitted == precondition) {
+        num_hoisted++;
+      }
     }
 
     CheckArrayBoundInstr* new_check = new CheckArrayBoundInstr(
@@ -842,16 +849,21 @@ class BoundsCheckGeneralizer {
         THR_Print("  => generalized check is redundant\n");
       }
       RemoveGeneralizedCheck(check);
+      flow_graph_->RecordEliminatedBoundsChecks(1, num_hoisted);
       return;
     }
 
-    new_check = scheduler_.Emit(new_check, check);
-    if (new_check != NULL) {
+    CheckArrayBoundInstr* emitted = scheduler_.Emit(new_check, check);
+    if (emitted != NULL) {
       if (FLAG_trace_range_analysis) {
         THR_Print("  => generalized check was hoisted into B%" Pd "\n",
-                  new_check->GetBlock()->block_id());
+                  emitted->GetBlock()->block_id());
+      }
+      if (emitted == new_check) {
+        num_hoisted++;
       }
       RemoveGeneralizedCheck(check);
+      flow_graph_->RecordEliminatedBoundsChecks(1, num_hoisted);
     } else {
       if (FLAG_trace_range_analysis) {
         THR_Print("  => generalized check can't be hoisted\n");
@@ -1326,6 +1338,7 @@ void RangeAnalysis::EliminateRedundantBoundsChecks() {
         if (aot_check->IsRedundant(array_length)) {
           aot_check->ReplaceUsesWith(aot_check->index()->definition());
           aot_check->RemoveFromGraph();
+          flow_graph_->RecordEliminatedBoundsChecks(1, 0);
         }
         continue;
       }
@@ -1337,6 +1350,7 @@ void RangeAnalysis::EliminateRedundantBoundsChecks() {
       if (check->IsRedundant(array_length)) {
         check->ReplaceUsesWith(check->index()->definition());
         check->RemoveFromGraph();
+        flow_graph_->RecordEliminatedBoundsChecks(1, 0);
       } else if (try_generalization) {
         generalizer.TryGeneralize(check, array_length);
       }
@@ -7,12 +7,14 @@
 #ifndef DART_PRECOMPILED_RUNTIME
 
 #include "vm/compiler/backend/block_scheduler.h"
+#include "vm/compiler/backend/bounds_check_hoisting.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/constant_propagator.h"
 #include "vm/compiler/backend/flow_graph_checker.h"
 #include "vm/compiler/backend/il_printer.h"
 #include "vm/compiler/backend/inliner.h"
 #include "vm/compiler/backend/linearscan.h"
+#include "vm/compiler/backend/loop_vectorizer.h"
 #include "vm/compiler/backend/range_analysis.h"
 #include "vm/compiler/backend/redundancy_elimination.h"
 #include "vm/compiler/backend/type_propagator.h"
@@ -272,7 +274,9 @@ void CompilerPass::RunPipeline(PipelineMode mode,
   INVOKE_PASS(TypePropagation);
   INVOKE_PASS(RangeAnalysis);
   INVOKE_PASS(OptimizeBranches);
+  INVOKE_PASS(HoistBoundsChecks);
   INVOKE_PASS(TypePropagation);
+  INVOKE_PASS(VectorizeLoops);
   INVOKE_PASS(TryCatchOptimization);
   INVOKE_PASS(EliminateEnvironments);
   INVOKE_PASS(EliminateDeadPhis);
@@ -392,6 +396,19 @@ COMPILER_PASS(OptimizeBranches, {
   ConstantPropagator::OptimizeBranches(flow_graph);
 });
 
+COMPILER_PASS(HoistBoundsChecks, {
+  // Runs after range analysis removed the checks that are redundant, so
+  // only the remaining ones are replaced by speculative checks.
+  BoundsCheckHoisting::Optimize(flow_graph);
+});
+
+COMPILER_PASS(VectorizeLoops, {
+  // Runs after range analysis so that the scalar loop it keeps as the
+  // epilogue is already optimized, and before the final representation
+  // selection which unboxes the new vector values.
+  LoopVectorizer::Optimize(flow_graph);
+});
+
 COMPILER_PASS(OptimizeTypedDataAccesses,
               { TypedDataSpecializer::Optimize(flow_graph); });
 
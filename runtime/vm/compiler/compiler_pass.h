@@ -32,6 +32,7 @@ namespace dart {
   V(EliminateEnvironments)                                                     \
   V(EliminateStackOverflowChecks)                                              \
   V(FinalizeGraph)                                                             \
+  V(HoistBoundsChecks)                                                         \
   V(IfConvert)                                                                 \
   V(Inlining)                                                                  \
   V(LICM)                                                                      \
@@ -45,6 +46,7 @@ namespace dart {
   V(TryCatchOptimization)                                                      \
   V(TryOptimizePatterns)                                                       \
   V(TypePropagation)                                                           \
+  V(VectorizeLoops)                                                            \
   V(WidenSmiToInt32)                                                           \
   V(WriteBarrierElimination)
 
@@ -50,6 +50,10 @@
 
 namespace dart {
 
+DEFINE_FLAG(int,
+            background_compiler_threads,
+            1,
+            "Number of threads each background compiler uses.");
 DEFINE_FLAG(
     int,
     max_deoptimization_counter_threshold,
@@ -1126,7 +1130,7 @@ void Compiler::AbortBackgroundCompilation(intptr_t deopt_id, const char* msg) {
 class QueueElement {
  public:
   explicit QueueElement(const Function& function)
-      : next_(NULL), function_(function.raw()) {}
+      : next_(NULL), function_(function.raw()), is_compiling_(false) {}
 
   virtual ~QueueElement() {
     next_ = NULL;
@@ -1138,6 +1142,10 @@ class QueueElement {
   void set_next(QueueElement* elem) { next_ = elem; }
   QueueElement* next() const { return next_; }
 
+  // True while a background compiler thread is compiling the function.
+  bool is_compiling() const { return is_compiling_; }
+  void set_is_compiling(bool value) { is_compiling_ = value; }
+
   RawObject* function() const { return function_; }
   RawObject** function_ptr() {
     return reinterpret_cast<RawObject**>(&function_);
@@ -1146,12 +1154,15 @@ class QueueElement {
  private:
   QueueElement* next_;
   RawFunction* function_;
+  bool is_compiling_;
 
   DISALLOW_COPY_AND_ASSIGN(QueueElement);
 };
 
 // Allocated in C-heap. Handles both input and output of background compilation.
-// It implements a FIFO queue, using Peek, Add, Remove operations.
+// Functions are added at the end and taken hottest first. A taken function
+// stays in the queue until its compilation is done, so that it is not
+// queued again in the meantime.
 class BackgroundCompilationQueue {
  public:
   BackgroundCompilationQueue() : first_(NULL), last_(NULL) {}
@@ -1184,13 +1195,57 @@ class BackgroundCompilationQueue {
 
   QueueElement* Peek() const { return first_; }
 
-  RawFunction* PeekFunction() const {
-    QueueElement* e = Peek();
-    if (e == NULL) {
-      return Function::null();
+  // Whether some function in the queue is not being compiled yet.
+  bool HasWaiting() const {
+    for (QueueElement* p = first_; p != NULL; p = p->next()) {
+      if (!p->is_compiling()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Marks the waiting function with the highest usage counter as being
+  // compiled and returns it, or returns NULL if there is none. The mutator
+  // sets the usage counter to INT_MIN when queueing a function, so this picks
+  // the function that ran most often while waiting. Ties go to the function
+  // queued first. [function] is used as a scratch handle.
+  QueueElement* TakeHottest(Function* function) {
+    QueueElement* hottest = NULL;
+    int32_t hottest_count = 0;
+    for (QueueElement* p = first_; p != NULL; p = p->next()) {
+      if (p->is_compiling()) continue;
+      *function = p->Function();
+      const int32_t count = function->usage_counter();
+      if ((hottest == NULL) || (count > hottest_count)) {
+        hottest = p;
+        hottest_count = count;
+      }
+    }
+    if (hottest != NULL) {
+      hottest->set_is_compiling(true);
+    }
+    return hottest;
+  }
+
+  // Unlinks [value], which must be in the queue.
+  void Remove(QueueElement* value) {
+    QueueElement* previous = NULL;
+    QueueElement* p = first_;
+    while (p != value) {
+      ASSERT(p != NULL);
+      previous = p;
+      p = p->next();
+    }
+    if (previous == NULL) {
+      first_ = value->next();
     } else {
-      return e->Function();
+      previous->set_next(value->next());
+    }
+    if (last_ == value) {
+      last_ = previous;
     }
+    value->set_next(NULL);
   }
 
   QueueElement* Remove() {
@@ -1235,7 +1290,7 @@ BackgroundCompiler::BackgroundCompiler(Isolate* isolate)
       function_queue_(new BackgroundCompilationQueue()),
       done_monitor_(),
       running_(false),
-      done_(true),
+      threads_(0),
       disabled_depth_(0) {}
 
 // Fields all deleted in ::Stop; here clear them.
@@ -1255,11 +1310,17 @@ void BackgroundCompiler::Run() {
       Zone* zone = stack_zone.GetZone();
       HANDLESCOPE(thread);
       Function& function = Function::Handle(zone);
+      QueueElement* qelem = NULL;
       {
         MonitorLocker ml(&queue_monitor_);
-        function = function_queue()->PeekFunction();
+        if (running_) {
+          qelem = function_queue()->TakeHottest(&function);
+          if (qelem != NULL) {
+            function = qelem->Function();
+          }
+        }
       }
-      while (running_ && !function.IsNull()) {
+      while (running_ && (qelem != NULL)) {
         // This is false if we are compiling bytecode -> unoptimized code.
         const bool optimizing = function.ShouldCompilerOptimize();
         ASSERT(FLAG_enable_interpreter || optimizing);
@@ -1271,14 +1332,15 @@ void BackgroundCompiler::Run() {
           Compiler::CompileFunction(thread, function);
         }
 
-        QueueElement* qelem = NULL;
+        QueueElement* done_qelem = NULL;
         {
           MonitorLocker ml(&queue_monitor_);
-          if (function_queue()->IsEmpty()) {
+          if (!running_) {
             // We are shutting down, queue was cleared.
-            function = Function::null();
+            qelem = NULL;
           } else {
-            qelem = function_queue()->Remove();
+            function_queue()->Remove(qelem);
+            done_qelem = qelem;
             const Function& old = Function::Handle(qelem->Function());
             // If an optimizable method is not optimized, put it back on
             // the background queue (unless it was passed to foreground).
@@ -1289,21 +1351,25 @@ void BackgroundCompiler::Run() {
                   Compiler::CanOptimizeFunction(thread, old)) {
                 QueueElement* repeat_qelem = new QueueElement(old);
                 function_queue()->Add(repeat_qelem);
+                ml.Notify();
               }
             }
-            function = function_queue()->PeekFunction();
+            qelem = function_queue()->TakeHottest(&function);
+            if (qelem != NULL) {
+              function = qelem->Function();
+            }
           }
         }
-        if (qelem != NULL) {
-          delete qelem;
+        if (done_qelem != NULL) {
+          delete done_qelem;
         }
       }
     }
     Thread::ExitIsolateAsHelper();
     {
-      // Wait to be notified when the work queue is not empty.
+      // Wait to be notified when there is work that no other thread is doing.
       MonitorLocker ml(&queue_monitor_);
-      while (function_queue()->IsEmpty() && running_) {
+      while (!function_queue()->HasWaiting() && running_) {
         ml.Wait();
       }
     }
@@ -1312,8 +1378,10 @@ void BackgroundCompiler::Run() {
   {
     // Notify that the thread is done.
     MonitorLocker ml_done(&done_monitor_);
-    done_ = true;
-    ml_done.Notify();
+    threads_--;
+    if (threads_ == 0) {
+      ml_done.Notify();
+    }
   }
 }
 
@@ -1360,13 +1428,20 @@ void BackgroundCompiler::Start() {
   ASSERT(!thread->IsAtSafepoint());
 
   MonitorLocker ml(&done_monitor_);
-  if (running_ || !done_) return;
+  if (running_ || (threads_ > 0)) return;
   running_ = true;
-  done_ = false;
-  bool task_started = Dart::thread_pool()->Run<BackgroundCompilerTask>(this);
-  if (!task_started) {
+  const intptr_t num_threads =
+      Utils::Maximum(1, FLAG_background_compiler_threads);
+  for (intptr_t i = 0; i < num_threads; i++) {
+    // Count the thread before it can start running and finish.
+    threads_++;
+    if (!Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+      threads_--;
+      break;
+    }
+  }
+  if (threads_ == 0) {
     running_ = false;
-    done_ = true;
   }
 }
 
@@ -1379,12 +1454,12 @@ void BackgroundCompiler::Stop() {
     MonitorLocker ml(&queue_monitor_);
     running_ = false;
     function_queue_->Clear();
-    ml.Notify();  // Stop waiting for the queue.
+    ml.NotifyAll();  // Stop waiting for the queue.
   }
 
   {
     MonitorLocker ml_done(&done_monitor_);
-    while (!done_) {
+    while (threads_ > 0) {
       ml_done.WaitWithSafepointCheck(thread);
     }
   }
@@ -124,8 +124,9 @@ class Compiler : public AllStatic {
   static void AbortBackgroundCompilation(intptr_t deopt_id, const char* msg);
 };
 
-// Class to run optimizing compilation in a background thread.
-// Current implementation: one task per isolate, it dies with the owning
+// Class to run optimizing compilation in background threads.
+// Current implementation: --background_compiler_threads tasks per isolate
+// draining a shared queue, hottest function first; they die with the owning
 // isolate.
 // No OSR compilation in the background compiler.
 class BackgroundCompiler {
@@ -200,16 +201,16 @@ class BackgroundCompiler {
   void Enable();
   void Disable();
   bool IsDisabled();
-  bool IsRunning() { return !done_; }
+  bool IsRunning() { return threads_ > 0; }
 
   Isolate* isolate_;
 
   Monitor queue_monitor_;  // Controls access to the queue.
   BackgroundCompilationQueue* function_queue_;
 
-  Monitor done_monitor_;    // Notify/wait that the thread is done.
+  Monitor done_monitor_;    // Notify/wait that the threads are done.
   bool running_;            // While true, will try to read queue and compile.
-  bool done_;               // True if the thread is done.
+  intptr_t threads_;        // Number of threads that are not done yet.
 
   int16_t disabled_depth_;
 
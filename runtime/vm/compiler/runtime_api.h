@@ -767,6 +767,7 @@ class ClassTable : public AllStatic {
 #if !defined(PRODUCT)
 class ClassHeapStats : public AllStatic {
  public:
+  static word SlowPathAllocationMask();
   static word TraceAllocationMask();
   static word state_offset();
   static word allocated_since_gc_new_space_offset();
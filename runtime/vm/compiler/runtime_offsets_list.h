@@ -66,6 +66,7 @@
   FIELD(Class, num_type_arguments_offset)                                      \
   FIELD(Class, super_type_offset)                                              \
   FIELD(Class, type_arguments_field_offset_in_words_offset)                    \
+  NOT_IN_PRODUCT(FIELD(ClassHeapStats, SlowPathAllocationMask))                \
   NOT_IN_PRODUCT(FIELD(ClassHeapStats, TraceAllocationMask))                   \
   NOT_IN_PRODUCT(FIELD(ClassHeapStats, allocated_since_gc_new_space_offset))   \
   NOT_IN_PRODUCT(                                                              \
@@ -1707,6 +1707,13 @@ void StubCodeCompiler::GenerateAllocationStubForClass(Assembler* assembler,
       !target::Class::TraceAllocation(cls)) {
     Label slow_case;
 
+    // Load the address of the allocation stats table. Pretenured classes are
+    // allocated in old space by the runtime.
+    NOT_IN_PRODUCT(static Register kAllocationStatsReg = R4);
+    NOT_IN_PRODUCT(__ LoadAllocationStatsAddress(kAllocationStatsReg,
+                                                 target::Class::GetId(cls)));
+    NOT_IN_PRODUCT(__ MaybeTraceAllocation(kAllocationStatsReg, &slow_case));
+
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
 
@@ -1722,12 +1729,6 @@ void StubCodeCompiler::GenerateAllocationStubForClass(Assembler* assembler,
     }
     __ str(kEndOfInstanceReg, Address(THR, target::Thread::top_offset()));
 
-    // Load the address of the allocation stats table. We split up the load
-    // and the increment so that the dependent load is not too nearby.
-    NOT_IN_PRODUCT(static Register kAllocationStatsReg = R4);
-    NOT_IN_PRODUCT(__ LoadAllocationStatsAddress(kAllocationStatsReg,
-                                                 target::Class::GetId(cls)));
-
     // Set the tags.
     ASSERT(target::Class::GetId(cls) != kIllegalCid);
     const uint32_t tags = target::MakeTagWordForNewSpaceObject(
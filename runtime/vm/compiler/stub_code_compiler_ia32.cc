@@ -1412,6 +1412,9 @@ void StubCodeCompiler::GenerateAllocationStubForClass(Assembler* assembler,
       target::Heap::IsAllocatableInNewSpace(instance_size) &&
       !target::Class::TraceAllocation(cls)) {
     Label slow_case;
+    // Pretenured classes are allocated in old space by the runtime.
+    NOT_IN_PRODUCT(__ MaybeTraceAllocation(target::Class::GetId(cls), EAX,
+                                           &slow_case, Assembler::kFarJump));
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
     // EDX: instantiated type arguments (if is_cls_parameterized).
@@ -1222,9 +1222,17 @@ void StubCodeCompiler::GenerateInvokeDartCodeStub(Assembler* assembler) {
 // Input parameters:
 //   RSP : points to return address.
 //   RDI : target raw code
-//   RSI : arguments raw descriptor array.
+//   RSI : arguments raw descriptor array, or null for OSR code (see below).
 //   RDX : address of first argument.
 //   RCX : current thread.
+//
+// With a null arguments descriptor, RDI is optimized code compiled for
+// on-stack replacement of an interpreted frame, and RDX points to the state
+// of that frame (see Interpreter::InvokeOsrCode):
+//   | Smi number of arguments n | n arguments |
+//   | Smi number of stack slots m | m stack slots, starting with local 0 |
+// The stub calls a helper which sets up the frame that the unoptimized code
+// of the function would have at the OSR entry and jumps into the OSR code.
 void StubCodeCompiler::GenerateInvokeDartCodeFromBytecodeStub(
     Assembler* assembler) {
 #if defined(DART_PRECOMPILED_RUNTIME)
@@ -1304,6 +1312,10 @@ void StubCodeCompiler::GenerateInvokeDartCodeFromBytecodeStub(
   // Push arguments. At this point we only need to preserve kTargetCodeReg.
   ASSERT(kTargetCodeReg != RDX);
 
+  Label invoke_osr_code;
+  __ CompareObject(R10, NullObject());
+  __ j(EQUAL, &invoke_osr_code);
+
   // Load number of arguments into RBX and adjust count for type arguments.
   __ movq(RBX, FieldAddress(R10, target::ArgumentsDescriptor::count_offset()));
   __ cmpq(
@@ -1341,6 +1353,9 @@ void StubCodeCompiler::GenerateInvokeDartCodeFromBytecodeStub(
           FieldAddress(CODE_REG, target::Code::entry_point_offset()));
   __ call(kTargetCodeReg);  // R10 is the arguments descriptor array.
 
+  Label done_call;
+  __ Bind(&done_call);
+
   // Read the saved number of passed arguments as Smi.
   __ movq(RDX, Address(RBP, kArgumentsDescOffset));
 
@@ -1365,6 +1380,59 @@ void StubCodeCompiler::GenerateInvokeDartCodeFromBytecodeStub(
   __ popq(RCX);
 
   __ ret();
+
+  __ Bind(&invoke_osr_code);
+  if (kArg0Reg != RDX) {  // Different registers on WIN64.
+    __ movq(RDX, kArg0Reg);
+  }
+
+  // Save number of arguments as Smi on stack, replacing saved ArgumentsDesc.
+  __ movq(RBX, Address(RDX, 0));
+  __ addq(RDX, Immediate(target::kWordSize));
+  __ movq(Address(RBP, kArgumentsDescOffset), RBX);
+  __ SmiUntag(RBX);
+
+  // Push arguments of the interpreted frame.
+  Label push_osr_arguments;
+  Label done_push_osr_arguments;
+  __ j(ZERO, &done_push_osr_arguments, Assembler::kNearJump);
+  __ LoadImmediate(RAX, Immediate(0));
+  __ Bind(&push_osr_arguments);
+  __ pushq(Address(RDX, RAX, TIMES_8, 0));
+  __ incq(RAX);
+  __ cmpq(RAX, RBX);
+  __ j(LESS, &push_osr_arguments, Assembler::kNearJump);
+  __ Bind(&done_push_osr_arguments);
+
+  // RDX: address of the number of stack slots, following the arguments.
+  __ leaq(RDX, Address(RDX, RBX, TIMES_8, 0));
+  __ xorq(PP, PP);  // GC-safe value into PP.
+  __ movq(CODE_REG, kTargetCodeReg);
+  Label enter_osr_code;
+  __ call(&enter_osr_code);
+  __ jmp(&done_call);
+
+  // Set up the Dart frame expected at the OSR entry, i.e. a Dart frame with
+  // the locals and the empty expression stack of the unoptimized code. The
+  // OSR code restores its own pool pointer and reserves its spill slots.
+  __ Bind(&enter_osr_code);
+  __ EnterFrame(0);
+  __ pushq(CODE_REG);  // PC marker.
+  __ pushq(PP);        // Caller's PP.
+  __ movq(RBX, Address(RDX, 0));
+  __ addq(RDX, Immediate(target::kWordSize));
+  __ SmiUntag(RBX);
+  Label push_osr_locals;
+  Label done_push_osr_locals;
+  __ j(ZERO, &done_push_osr_locals, Assembler::kNearJump);
+  __ LoadImmediate(RAX, Immediate(0));
+  __ Bind(&push_osr_locals);
+  __ pushq(Address(RDX, RAX, TIMES_8, 0));
+  __ incq(RAX);
+  __ cmpq(RAX, RBX);
+  __ j(LESS, &push_osr_locals, Assembler::kNearJump);
+  __ Bind(&done_push_osr_locals);
+  __ jmp(FieldAddress(CODE_REG, target::Code::entry_point_offset()));
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 }
 
@@ -1718,6 +1786,9 @@ void StubCodeCompiler::GenerateAllocationStubForClass(Assembler* assembler,
       target::Heap::IsAllocatableInNewSpace(instance_size) &&
       !target::Class::TraceAllocation(cls)) {
     Label slow_case;
+    // Pretenured classes are allocated in old space by the runtime.
+    NOT_IN_PRODUCT(__ MaybeTraceAllocation(target::Class::GetId(cls),
+                                           &slow_case, Assembler::kFarJump));
     // Allocate the object and update top to point to
     // next object start and initialize the allocated object.
     // RDX: instantiated type arguments (if is_cls_parameterized).
@@ -16,6 +16,8 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, background_compiler_threads);
+
 ISOLATE_UNIT_TEST_CASE(CompileFunction) {
   const char* kScriptChars =
       "class A {\n"
@@ -98,6 +100,61 @@ ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionOnHelperThread) {
   BackgroundCompiler::Stop(isolate);
 }
 
+ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionsOnHelperThreads) {
+  // Create a few simple functions and compile them without optimization.
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo() { return 42; }\n"
+      "  static bar() { return 43; }\n"
+      "  static baz() { return 44; }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, NULL);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const char* kNames[] = {"foo", "bar", "baz"};
+  const intptr_t kNumFunctions = ARRAY_SIZE(kNames);
+  Function* functions[kNumFunctions];
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    functions[i] = &Function::Handle(
+        cls.LookupStaticFunction(String::Handle(String::New(kNames[i]))));
+    EXPECT(!functions[i]->HasCode());
+    CompilerTest::TestCompileFunction(*functions[i]);
+    EXPECT(functions[i]->HasCode());
+    EXPECT(!functions[i]->HasOptimizedCode());
+  }
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  const int saved_threads = FLAG_background_compiler_threads;
+  FLAG_background_compiler_threads = 2;
+  Isolate* isolate = thread->isolate();
+  BackgroundCompiler::Start(isolate);
+  // Queue the functions with increasing hotness.
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    functions[i]->SetUsageCounter(i);
+    isolate->optimizing_background_compiler()->Compile(*functions[i]);
+  }
+  Monitor* m = new Monitor();
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    MonitorLocker ml(m);
+    while (!functions[i]->HasOptimizedCode()) {
+      ml.WaitWithSafepointCheck(thread, 1);
+    }
+  }
+  delete m;
+  BackgroundCompiler::Stop(isolate);
+  FLAG_background_compiler_threads = saved_threads;
+}
+
 ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   // Create a simple function and compile it without optimization.
   const char* kScriptChars =
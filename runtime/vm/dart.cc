@@ -211,6 +211,8 @@ char* Dart::Init(const uint8_t* vm_isolate_snapshot,
   NativeSymbolResolver::Init();
   NOT_IN_PRODUCT(Profiler::Init());
   SemiSpace::Init();
+  HeapPage::Init();
+  ReversePcLookupCache::Init();
   NOT_IN_PRODUCT(Metric::Init());
   StoreBuffer::Init();
   MarkingStack::Init();
@@ -223,7 +225,7 @@ char* Dart::Init(const uint8_t* vm_isolate_snapshot,
   predefined_handles_ = new ReadOnlyHandles();
   // Create the VM isolate and finish the VM initialization.
   ASSERT(thread_pool_ == NULL);
-  thread_pool_ = new ThreadPool();
+  thread_pool_ = ThreadPool::New();
   {
     ASSERT(vm_isolate_ == NULL);
     ASSERT(Flags::Initialized());
@@ -562,6 +564,8 @@ char* Dart::Cleanup() {
   StoreBuffer::Cleanup();
   Object::Cleanup();
   SemiSpace::Cleanup();
+  HeapPage::Cleanup();
+  ReversePcLookupCache::Cleanup();
   StubCode::Cleanup();
   // Delete the current thread's TLS and set it's TLS to null.
   // If it is the last thread then the destructor would call
@@ -38,6 +38,9 @@ class ReadStream : public ValueObject {
     end_ = buffer + size;
   }
 
+  const uint8_t* buffer() const { return buffer_; }
+  intptr_t size() const { return end_ - buffer_; }
+
   template <int N, typename T>
   class Raw {};
 
@@ -141,6 +141,8 @@ constexpr bool kDartUseBytecode = false;
   P(old_gen_heap_size, int, kDefaultMaxOldGenHeapSize,                         \
     "Max size of old gen heap size in MB, or 0 for unlimited,"                 \
     "e.g: --old_gen_heap_size=1024 allows up to 1024MB old gen heap")          \
+  P(parallel_snapshot_fill, bool, false,                                       \
+    "Fill independent snapshot clusters on the thread pool.")                  \
   R(pause_isolates_on_start, false, bool, false,                               \
     "Pause isolates before starting.")                                         \
   R(pause_isolates_on_exit, false, bool, false, "Pause isolates exiting.")     \
@@ -152,8 +154,12 @@ constexpr bool kDartUseBytecode = false;
   P(print_snapshot_sizes, bool, false, "Print sizes of generated snapshots.")  \
   P(print_snapshot_sizes_verbose, bool, false,                                 \
     "Print cluster sizes of generated snapshots.")                             \
+  P(print_snapshot_load_times, bool, false,                                    \
+    "Print time spent in each phase of snapshot loading.")                     \
   P(print_benchmarking_metrics, bool, false,                                   \
     "Print additional memory and latency metrics for benchmarking.")           \
+  R(print_register_allocation_stats, false, bool, false,                       \
+    "Print the number of spills and reloads of every optimized function.")     \
   R(print_ssa_liveranges, false, bool, false,                                  \
     "Print live ranges after allocation.")                                     \
   R(print_stacktrace_at_api_error, false, bool, false,                         \
@@ -164,6 +170,9 @@ constexpr bool kDartUseBytecode = false;
   R(profiler_native_memory, false, bool, false,                                \
     "Enable native memory statistic collection.")                              \
   P(reorder_basic_blocks, bool, true, "Reorder basic blocks")                  \
+  P(scavenger_tasks, int, 0,                                                   \
+    "The number of tasks to spawn during new gen GC scavenging (0 means "      \
+    "perform all scavenging on main thread).")                                 \
   C(stress_async_stacks, false, false, bool, false,                            \
     "Stress test async stack traces")                                          \
   P(use_bare_instructions, bool, true, "Enable bare instructions mode.")       \
@@ -199,11 +208,15 @@ constexpr bool kDartUseBytecode = false;
     "Optimize left shift to truncate if possible")                             \
   P(use_bytecode_compiler, bool, kDartUseBytecode, "Compile from bytecode")    \
   P(use_compactor, bool, false, "Compact the heap during old-space GC.")       \
+  P(use_evacuation, bool, false,                                               \
+    "Evacuate the most fragmented pages during old-space GC.")                 \
   P(use_cha_deopt, bool, true,                                                 \
     "Use class hierarchy analysis even if it can cause deoptimization.")       \
   P(use_field_guards, bool, !USING_DBC,                                        \
     "Use field guards and track field types")                                  \
   C(use_osr, false, true, bool, true, "Use OSR")                               \
+  R(use_pretenuring, false, bool, false,                                       \
+    "Allocate classes whose instances survive new GCs directly in old space.") \
   P(use_strong_mode_types, bool, true, "Optimize based on strong mode types.") \
   R(verbose_gc, false, bool, false, "Enables verbose GC.")                     \
   R(verbose_gc_hdr, 40, int, 40, "Print verbose GC header interval.")          \
@@ -105,6 +105,32 @@ class ForwardingPage {
   DISALLOW_COPY_AND_ASSIGN(ForwardingPage);
 };
 
+// Records the allocation units of the marked objects that start in the block
+// containing first_object. Returns the first object in the next block and
+// stores the total size of the marked objects in *live_size.
+static uword RecordLiveBlock(uword first_object,
+                             ForwardingBlock* forwarding_block,
+                             intptr_t* live_size) {
+  uword block_start = first_object & kBlockMask;
+  uword block_end = block_start + kBlockSize;
+
+  intptr_t block_live_size = 0;
+  uword current = first_object;
+  while (current < block_end) {
+    RawObject* obj = RawObject::FromAddr(current);
+    intptr_t size = obj->HeapSize();
+    if (obj->IsMarked()) {
+      forwarding_block->RecordLive(current, size);
+      ASSERT(static_cast<intptr_t>(forwarding_block->Lookup(current)) ==
+             block_live_size);
+      block_live_size += size;
+    }
+    current += size;
+  }
+  *live_size = block_live_size;
+  return current;
+}
+
 ForwardingPage* HeapPage::AllocateForwardingPage() {
   ASSERT(forwarding_page_ == NULL);
   forwarding_page_ = new ForwardingPage();
@@ -159,6 +185,34 @@ class CompactorTask : public ThreadPool::Task {
   DISALLOW_COPY_AND_ASSIGN(CompactorTask);
 };
 
+class EvacuatorTask : public ThreadPool::Task {
+ public:
+  EvacuatorTask(Isolate* isolate,
+                GCCompactor* compactor,
+                ThreadBarrier* barrier,
+                intptr_t* next_forwarding_task,
+                MallocGrowableArray<HeapPage*>* pages,
+                intptr_t* next_page)
+      : isolate_(isolate),
+        compactor_(compactor),
+        barrier_(barrier),
+        next_forwarding_task_(next_forwarding_task),
+        pages_(pages),
+        next_page_(next_page) {}
+
+ private:
+  void Run();
+
+  Isolate* isolate_;
+  GCCompactor* compactor_;
+  ThreadBarrier* barrier_;
+  intptr_t* next_forwarding_task_;
+  MallocGrowableArray<HeapPage*>* pages_;
+  intptr_t* next_page_;
+
+  DISALLOW_COPY_AND_ASSIGN(EvacuatorTask);
+};
+
 // Slides live objects down past free gaps, updates pointers and frees empty
 // pages. Keeps cursors pointing to the next free and next live chunks, and
 // repeatedly moves the next live chunk to the next free chunk, one block at a
@@ -255,24 +309,7 @@ void GCCompactor::Compact(HeapPage* pages,
   // looking at the already-slided-object or the not-yet-slided object. Though
   // with parallel sliding there is no safe way to access the backing store
   // object header.)
-  {
-    TIMELINE_FUNCTION_GC_DURATION(thread(),
-                                  "ForwardTypedDataViewInternalPointers");
-    const intptr_t length = typed_data_views_.length();
-    for (intptr_t i = 0; i < length; ++i) {
-      auto raw_view = typed_data_views_[i];
-      const classid_t cid = raw_view->ptr()->typed_data_->GetClassIdMayBeSmi();
-
-      // If we have external typed data we can simply return, since the backing
-      // store lives in C-heap and will not move. Otherwise we have to update
-      // the inner pointer.
-      if (RawObject::IsTypedDataClassId(cid)) {
-        raw_view->RecomputeDataFieldForInternalTypedData();
-      } else {
-        ASSERT(RawObject::IsExternalTypedDataClassId(cid));
-      }
-    }
-  }
+  ForwardTypedDataViewInternalPointers();
 
   for (intptr_t task_index = 0; task_index < num_tasks; task_index++) {
     ASSERT(tails[task_index] != NULL);
@@ -317,6 +354,185 @@ void GCCompactor::Compact(HeapPage* pages,
   }
 }
 
+// Copies the live objects of the candidate pages into fresh pages, using the
+// same block-wise forwarding information as sliding, so that the new address
+// of an object can be found from its old address alone. Unlike sliding, the
+// objects on all other pages stay in place, so every remaining page is
+// visited to forward pointers, but only the candidate pages are copied and
+// mark bits are left for the sweeper. The amount of work is bounded by the
+// live bytes of the candidates, which the caller chooses.
+bool GCCompactor::Evacuate(MallocGrowableArray<HeapPage*>* candidates) {
+  SetupImagePageBoundaries();
+  PageSpace* old_space = heap_->old_space();
+  const intptr_t num_candidates = candidates->length();
+
+  HeapPage* fresh_head = NULL;
+  HeapPage* fresh_tail = NULL;
+  intptr_t num_fresh = 0;
+  bool planned = true;
+  {
+    TIMELINE_FUNCTION_GC_DURATION(thread(), "Plan");
+    uword free_current = 0;
+    uword free_end = 0;
+    for (intptr_t i = 0; planned && (i < num_candidates); i++) {
+      HeapPage* page = (*candidates)[i];
+      ForwardingPage* forwarding_page = page->AllocateForwardingPage();
+      uword current = page->object_start();
+      uword end = page->object_end();
+      while (current < end) {
+        ForwardingBlock* forwarding_block = forwarding_page->BlockFor(current);
+        intptr_t block_live_size = 0;
+        current = RecordLiveBlock(current, forwarding_block, &block_live_size);
+        if ((free_end - free_current) <
+            static_cast<uword>(block_live_size)) {
+          if (num_fresh == num_candidates - 1) {
+            // Moving would not release any page.
+            planned = false;
+            break;
+          }
+          HeapPage* fresh = old_space->AllocatePage(HeapPage::kData,
+                                                    /* link */ false);
+          if (fresh == NULL) {
+            planned = false;
+            break;
+          }
+          // Seal the unused end of the previous fresh page so that it stays
+          // walkable; the sweeper adds it to the freelist.
+          if (free_end != free_current) {
+            FreeListElement::AsElement(free_current, free_end - free_current);
+          }
+          if (fresh_head == NULL) {
+            fresh_head = fresh;
+          } else {
+            fresh_tail->set_next(fresh);
+          }
+          fresh_tail = fresh;
+          num_fresh++;
+          free_current = fresh->object_start();
+          free_end = fresh->object_end();
+        }
+        forwarding_block->set_new_address(free_current);
+        free_current += block_live_size;
+      }
+    }
+    if (free_end != free_current) {
+      FreeListElement::AsElement(free_current, free_end - free_current);
+    }
+  }
+
+  if (!planned) {
+    // Nothing has moved yet; drop the plan.
+    for (intptr_t i = 0; i < num_candidates; i++) {
+      HeapPage* page = (*candidates)[i];
+      if (page->forwarding_page() != NULL) {
+        page->FreeForwardingPage();
+      }
+    }
+    MutexLocker ml(&old_space->pages_lock_);
+    while (fresh_head != NULL) {
+      HeapPage* next = fresh_head->next();
+      old_space->IncreaseCapacityInWordsLocked(
+          -(fresh_head->memory_->size() >> kWordSizeLog2));
+      fresh_head->Deallocate();
+      fresh_head = next;
+    }
+    return false;
+  }
+
+  {
+    TIMELINE_FUNCTION_GC_DURATION(thread(), "Copy");
+    for (intptr_t i = 0; i < num_candidates; i++) {
+      HeapPage* page = (*candidates)[i];
+      ForwardingPage* forwarding_page = page->forwarding_page();
+      uword old_addr = page->object_start();
+      uword end = page->object_end();
+      while (old_addr < end) {
+        RawObject* old_obj = RawObject::FromAddr(old_addr);
+        intptr_t size = old_obj->HeapSize();
+        if (old_obj->IsMarked()) {
+          uword new_addr = forwarding_page->Lookup(old_addr);
+          memmove(reinterpret_cast<void*>(new_addr),
+                  reinterpret_cast<void*>(old_addr), size);
+          RawObject* new_obj = RawObject::FromAddr(new_addr);
+          if (RawObject::IsTypedDataClassId(new_obj->GetClassId())) {
+            reinterpret_cast<RawTypedData*>(new_obj)->RecomputeDataField();
+          }
+        }
+        old_addr += size;
+      }
+    }
+  }
+
+  // Forward pointers in every page that was not evacuated, including the
+  // fresh pages, and in the rest of the heap.
+  MallocGrowableArray<HeapPage*> pages;
+  for (HeapPage* page = old_space->pages_; page != NULL; page = page->next()) {
+    if (page->forwarding_page() == NULL) {
+      pages.Add(page);
+    }
+  }
+  for (HeapPage* page = fresh_head; page != NULL; page = page->next()) {
+    pages.Add(page);
+  }
+
+  {
+    intptr_t num_tasks = FLAG_compactor_tasks;
+    RELEASE_ASSERT(num_tasks >= 1);
+    ThreadBarrier barrier(num_tasks + 1, heap_->barrier(),
+                          heap_->barrier_done());
+    intptr_t next_forwarding_task = 0;
+    intptr_t next_page = 0;
+    for (intptr_t task_index = 0; task_index < num_tasks; task_index++) {
+      Dart::thread_pool()->Run<EvacuatorTask>(thread()->isolate(), this,
+                                              &barrier, &next_forwarding_task,
+                                              &pages, &next_page);
+    }
+    // Forward pages, new space, etc.
+    barrier.Sync();
+    barrier.Exit();
+  }
+
+  ForwardTypedDataViewInternalPointers();
+
+  {
+    TIMELINE_FUNCTION_GC_DURATION(thread(), "ForwardStackPointers");
+    ForwardStackPointers();
+  }
+
+  {
+    MutexLocker ml(&old_space->pages_lock_);
+
+    // Replace the evacuated pages with the fresh pages.
+    HeapPage* prev = NULL;
+    HeapPage* page = old_space->pages_;
+    while (page != NULL) {
+      HeapPage* next = page->next();
+      if (page->forwarding_page() != NULL) {
+        if (prev == NULL) {
+          old_space->pages_ = next;
+        } else {
+          prev->set_next(next);
+        }
+        old_space->IncreaseCapacityInWordsLocked(
+            -(page->memory_->size() >> kWordSizeLog2));
+        page->FreeForwardingPage();
+        page->Deallocate();
+      } else {
+        prev = page;
+      }
+      page = next;
+    }
+    if (prev == NULL) {
+      old_space->pages_ = fresh_head;
+    } else {
+      prev->set_next(fresh_head);
+    }
+    old_space->pages_tail_ = fresh_tail;
+  }
+
+  return true;
+}
+
 void CompactorTask::Run() {
   bool result =
       Thread::EnterIsolateAsHelper(isolate_, Thread::kCompactorTask, true);
@@ -362,54 +578,39 @@ void CompactorTask::Run() {
     // Heap: Regular pages already visited during sliding. Code and image pages
     // have no pointers to forward. Visit large pages and new-space.
 
-    bool more_forwarding_tasks = true;
-    while (more_forwarding_tasks) {
-      intptr_t forwarding_task =
-          AtomicOperations::FetchAndIncrement(next_forwarding_task_);
-      switch (forwarding_task) {
-        case 0: {
-          TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardLargePages");
-          for (HeapPage* large_page =
-                   isolate_->heap()->old_space()->large_pages_;
-               large_page != NULL; large_page = large_page->next()) {
-            large_page->VisitObjectPointers(compactor_);
-          }
-          break;
-        }
-        case 1: {
-          TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardNewSpace");
-          isolate_->heap()->new_space()->VisitObjectPointers(compactor_);
-          break;
-        }
-        case 2: {
-          TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardRememberedSet");
-          isolate_->store_buffer()->VisitObjectPointers(compactor_);
-          break;
-        }
-        case 3: {
-          TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardWeakTables");
-          isolate_->heap()->ForwardWeakTables(compactor_);
-          break;
-        }
-        case 4: {
-          TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardWeakHandles");
-          isolate_->VisitWeakPersistentHandles(compactor_);
-          break;
-        }
-#ifndef PRODUCT
-        case 5: {
-          if (FLAG_support_service) {
-            TIMELINE_FUNCTION_GC_DURATION(thread, "ForwardObjectIdRing");
-            isolate_->object_id_ring()->VisitPointers(compactor_);
-          }
+    while (compactor_->ForwardUnmovedSlice(
+        AtomicOperations::FetchAndIncrement(next_forwarding_task_))) {
+    }
+
+    barrier_->Sync();
+  }
+  Thread::ExitIsolateAsHelper(true);
+
+  // This task is done. Notify the original thread.
+  barrier_->Exit();
+}
+
+void EvacuatorTask::Run() {
+  bool result =
+      Thread::EnterIsolateAsHelper(isolate_, Thread::kCompactorTask, true);
+  ASSERT(result);
+  {
+    {
+      TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ForwardPages");
+      const intptr_t num_pages = pages_->length();
+      for (;;) {
+        intptr_t index = AtomicOperations::FetchAndIncrement(next_page_);
+        if (index >= num_pages) {
           break;
         }
-#endif  // !PRODUCT
-        default:
-          more_forwarding_tasks = false;
+        compactor_->ForwardMarkedObjects((*pages_)[index]);
       }
     }
 
+    while (compactor_->ForwardUnmovedSlice(
+        AtomicOperations::FetchAndIncrement(next_forwarding_task_))) {
+    }
+
     barrier_->Sync();
   }
   Thread::ExitIsolateAsHelper(true);
@@ -443,27 +644,12 @@ void CompactorTask::SlidePage(HeapPage* page) {
 // object that starts in that block.
 uword CompactorTask::PlanBlock(uword first_object,
                                ForwardingPage* forwarding_page) {
-  uword block_start = first_object & kBlockMask;
-  uword block_end = block_start + kBlockSize;
   ForwardingBlock* forwarding_block = forwarding_page->BlockFor(first_object);
 
   // 1. Compute bitvector of surviving allocation units in the block.
   intptr_t block_live_size = 0;
-  intptr_t block_dead_size = 0;
-  uword current = first_object;
-  while (current < block_end) {
-    RawObject* obj = RawObject::FromAddr(current);
-    intptr_t size = obj->HeapSize();
-    if (obj->IsMarked()) {
-      forwarding_block->RecordLive(current, size);
-      ASSERT(static_cast<intptr_t>(forwarding_block->Lookup(current)) ==
-             block_live_size);
-      block_live_size += size;
-    } else {
-      block_dead_size += size;
-    }
-    current += size;
-  }
+  uword current =
+      RecordLiveBlock(first_object, forwarding_block, &block_live_size);
 
   // 2. Find the next contiguous space that can fit the live objects that
   // start in the block.
@@ -646,6 +832,89 @@ void GCCompactor::VisitHandle(uword addr) {
   ForwardPointer(handle->raw_addr());
 }
 
+// Forwards the pointers in one of the parts of the heap that are not visited
+// while moving objects: large pages, new space, the remembered set, weak
+// tables, weak handles and the object id ring. Returns false once all slices
+// have been claimed.
+bool GCCompactor::ForwardUnmovedSlice(intptr_t slice) {
+  Isolate* isolate = heap_->isolate();
+  switch (slice) {
+    case 0: {
+      TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ForwardLargePages");
+      for (HeapPage* large_page = heap_->old_space()->large_pages_;
+           large_page != NULL; large_page = large_page->next()) {
+        large_page->VisitObjectPointers(this);
+      }
+      return true;
+    }
+    case 1: {
+      TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ForwardNewSpace");
+      heap_->new_space()->VisitObjectPointers(this);
+      return true;
+    }
+    case 2: {
+      TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ForwardRememberedSet");
+      isolate->store_buffer()->VisitObjectPointers(this);
+      return true;
+    }
+    case 3: {
+      TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ForwardWeakTables");
+      heap_->ForwardWeakTables(this);
+      return true;
+    }
+    case 4: {
+      TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ForwardWeakHandles");
+      isolate->VisitWeakPersistentHandles(this);
+      return true;
+    }
+#ifndef PRODUCT
+    case 5: {
+      if (FLAG_support_service) {
+        TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ForwardObjectIdRing");
+        isolate->object_id_ring()->VisitPointers(this);
+      }
+      return true;
+    }
+#endif  // !PRODUCT
+    default:
+      return false;
+  }
+}
+
+// Dead objects are skipped: they may refer to evacuated objects that were not
+// copied, and the sweeper only needs their headers.
+void GCCompactor::ForwardMarkedObjects(HeapPage* page) {
+  uword current = page->object_start();
+  uword end = page->object_end();
+  while (current < end) {
+    RawObject* obj = RawObject::FromAddr(current);
+    intptr_t size = obj->HeapSize();
+    if (obj->IsMarked()) {
+      obj->VisitPointers(this);
+    }
+    current += size;
+  }
+}
+
+void GCCompactor::ForwardTypedDataViewInternalPointers() {
+  TIMELINE_FUNCTION_GC_DURATION(thread(),
+                                "ForwardTypedDataViewInternalPointers");
+  const intptr_t length = typed_data_views_.length();
+  for (intptr_t i = 0; i < length; ++i) {
+    auto raw_view = typed_data_views_[i];
+    const classid_t cid = raw_view->ptr()->typed_data_->GetClassIdMayBeSmi();
+
+    // If we have external typed data we can simply return, since the backing
+    // store lives in C-heap and will not move. Otherwise we have to update
+    // the inner pointer.
+    if (RawObject::IsTypedDataClassId(cid)) {
+      raw_view->RecomputeDataFieldForInternalTypedData();
+    } else {
+      ASSERT(RawObject::IsExternalTypedDataClassId(cid));
+    }
+  }
+}
+
 void GCCompactor::ForwardStackPointers() {
   // N.B.: Heap pointers have already been forwarded. We forward the heap before
   // forwarding the stack to limit the number of places that need to be aware of
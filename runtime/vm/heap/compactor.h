@@ -33,10 +33,21 @@ class GCCompactor : public ValueObject,
 
   void Compact(HeapPage* pages, FreeList* freelist, Mutex* mutex);
 
+  // Moves the marked objects of the given data pages to fresh pages, forwards
+  // all pointers to them and releases the given pages. The rest of the heap
+  // stays in place and is left for the sweeper. Returns false without moving
+  // anything if the fresh pages cannot be allocated or would not be fewer
+  // than the given pages.
+  bool Evacuate(MallocGrowableArray<HeapPage*>* candidates);
+
  private:
   friend class CompactorTask;
+  friend class EvacuatorTask;
 
   void SetupImagePageBoundaries();
+  bool ForwardUnmovedSlice(intptr_t slice);
+  void ForwardMarkedObjects(HeapPage* page);
+  void ForwardTypedDataViewInternalPointers();
   void ForwardStackPointers();
   void ForwardPointer(RawObject** ptr);
   void VisitTypedDataViewPointers(RawTypedDataView* view,
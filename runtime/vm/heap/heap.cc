@@ -126,15 +126,27 @@ uword Heap::AllocateNew(intptr_t size) {
 }
 
 uword Heap::AllocateOld(intptr_t size, HeapPage::PageType type) {
-  ASSERT(Thread::Current()->no_safepoint_scope_depth() == 0);
+  Thread* thread = Thread::Current();
+  ASSERT(thread->no_safepoint_scope_depth() == 0);
   CollectForDebugging();
-  uword addr = old_space_.TryAllocate(size, type);
+  uword addr;
+  if ((type == HeapPage::kData) && (size <= PageSpace::kMaxTLABObjectSize) &&
+      (thread->heap() == this)) {
+    addr = old_space_.TryAllocateInTLAB(thread, size);
+    if (addr != 0) {
+      return addr;
+    }
+    addr = old_space_.TryAllocateNewTLAB(thread, size);
+    if (addr != 0) {
+      return addr;
+    }
+  }
+  addr = old_space_.TryAllocate(size, type);
   if (addr != 0) {
     return addr;
   }
   // If we are in the process of running a sweep, wait for the sweeper to free
   // memory.
-  Thread* thread = Thread::Current();
   if (thread->CanCollectGarbage()) {
     // Wait for any GC tasks that are in progress.
     WaitForSweeperTasks(thread);
@@ -425,8 +437,12 @@ void Heap::NotifyIdle(int64_t deadline) {
   // time used up by a scavenge into account when deciding if we can complete
   // a mark-sweep on time.
   if (old_space_.ShouldPerformIdleMarkCompact(deadline)) {
+    // With evacuation, each mark-sweep defragments a bounded number of pages,
+    // so fragmentation is recovered over several idle notifications instead
+    // of with one full compaction.
     TIMELINE_FUNCTION_GC_DURATION(thread, "IdleGC");
-    CollectOldSpaceGarbage(thread, kMarkCompact, kIdle);
+    CollectOldSpaceGarbage(
+        thread, FLAG_use_evacuation ? kMarkSweep : kMarkCompact, kIdle);
   } else if (old_space_.ShouldPerformIdleMarkSweep(deadline)) {
     TIMELINE_FUNCTION_GC_DURATION(thread, "IdleGC");
     CollectOldSpaceGarbage(thread, kMarkSweep, kIdle);
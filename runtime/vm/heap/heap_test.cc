@@ -14,6 +14,9 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, pretenure_min_count);
+DECLARE_FLAG(bool, use_huge_pages);
+
 TEST_CASE(OldGC) {
   const char* kScriptChars =
       "main() {\n"
@@ -662,6 +665,207 @@ ISOLATE_UNIT_TEST_CASE(CollectAllGarbage_LiveOldToNewChain) {
   EXPECT(size_before < size_after);
 }
 
+ISOLATE_UNIT_TEST_CASE(ParallelScavenge) {
+  const intptr_t saved_scavenger_tasks = FLAG_scavenger_tasks;
+  FLAG_scavenger_tasks = 4;
+  Heap* heap = thread->isolate()->heap();
+
+  const intptr_t kNumChains = 512;
+  const intptr_t kChainLength = 8;
+  const Array& roots = Array::Handle(Array::New(kNumChains, Heap::kOld));
+  const Array& shared = Array::Handle(Array::New(1, Heap::kNew));
+  const WeakProperty& live_weak = WeakProperty::Handle(WeakProperty::New());
+  const WeakProperty& dead_weak = WeakProperty::Handle(WeakProperty::New());
+  {
+    HANDLESCOPE(thread);
+    Array& link = Array::Handle();
+    for (intptr_t i = 0; i < kNumChains; i++) {
+      Array& head = Array::Handle(Array::New(2, Heap::kNew));
+      head.SetAt(1, shared);
+      link = head.raw();
+      for (intptr_t j = 1; j < kChainLength; j++) {
+        Array& next = Array::Handle(Array::New(2, Heap::kNew));
+        next.SetAt(1, shared);
+        link.SetAt(0, next);
+        link = next.raw();
+      }
+      link.SetAt(0, Smi::Handle(Smi::New(i)));
+      roots.SetAt(i, head);
+    }
+    live_weak.set_key(shared);
+    live_weak.set_value(roots);
+    dead_weak.set_key(Array::Handle(Array::New(1, Heap::kNew)));
+    dead_weak.set_value(roots);
+  }
+
+  // The first scavenge copies the chains within new space and the second one
+  // promotes them.
+  heap->CollectGarbage(Heap::kNew);
+  heap->CollectGarbage(Heap::kNew);
+
+  Object& obj = Object::Handle();
+  for (intptr_t i = 0; i < kNumChains; i++) {
+    obj = roots.At(i);
+    for (intptr_t j = 0; j < kChainLength; j++) {
+      EXPECT(obj.IsArray());
+      EXPECT_EQ(shared.raw(), Array::Cast(obj).At(1));
+      obj = Array::Cast(obj).At(0);
+    }
+    EXPECT(obj.IsSmi());
+    EXPECT_EQ(i, Smi::Cast(obj).Value());
+  }
+  EXPECT_EQ(shared.raw(), live_weak.key());
+  EXPECT_EQ(roots.raw(), live_weak.value());
+  EXPECT_EQ(Object::null(), dead_weak.key());
+  EXPECT_EQ(Object::null(), dead_weak.value());
+
+  FLAG_scavenger_tasks = saved_scavenger_tasks;
+}
+
+ISOLATE_UNIT_TEST_CASE(EvacuateFragmentedPages) {
+  const bool saved_use_evacuation = FLAG_use_evacuation;
+  FLAG_use_evacuation = true;
+  Heap* heap = thread->isolate()->heap();
+  heap->CollectAllGarbage();
+
+  // Fill a few pages with small arrays and keep only every eighth one, so the
+  // pages are sparsely populated after the next GC. Each survivor refers to
+  // the previous survivor and to its own typed data.
+  const intptr_t kNumArrays = 16 * 1024;
+  const intptr_t kKeepEvery = 8;
+  const intptr_t kNumKept = kNumArrays / kKeepEvery;
+  const Array& kept = Array::Handle(Array::New(kNumKept, Heap::kOld));
+  const Array& from_new = Array::Handle(Array::New(1, Heap::kNew));
+  {
+    HANDLESCOPE(thread);
+    Array& array = Array::Handle();
+    Array& previous = Array::Handle();
+    TypedData& data = TypedData::Handle();
+    for (intptr_t i = 0; i < kNumArrays; i++) {
+      array = Array::New(3, Heap::kOld);
+      if ((i % kKeepEvery) == 0) {
+        data = TypedData::New(kTypedDataUint8ArrayCid, 8, Heap::kOld);
+        data.SetUint8(0, static_cast<uint8_t>(i / kKeepEvery));
+        array.SetAt(0, previous);
+        array.SetAt(1, data);
+        array.SetAt(2, Smi::Handle(Smi::New(i / kKeepEvery)));
+        kept.SetAt(i / kKeepEvery, array);
+        previous = array.raw();
+      }
+    }
+    from_new.SetAt(0, previous);
+  }
+
+  const int64_t capacity_before = heap->CapacityInWords(Heap::kOld);
+  heap->CollectGarbage(Heap::kOld);
+  heap->WaitForSweeperTasks(thread);
+  EXPECT(heap->CapacityInWords(Heap::kOld) < capacity_before);
+
+  Array& array = Array::Handle();
+  Object& obj = Object::Handle();
+  for (intptr_t i = 0; i < kNumKept; i++) {
+    array ^= kept.At(i);
+    obj = array.At(0);
+    if (i == 0) {
+      EXPECT(obj.IsNull());
+    } else {
+      EXPECT_EQ(kept.At(i - 1), obj.raw());
+    }
+    obj = array.At(1);
+    EXPECT(obj.IsTypedData());
+    EXPECT_EQ(static_cast<uint8_t>(i), TypedData::Cast(obj).GetUint8(0));
+    obj = array.At(2);
+    EXPECT_EQ(i, Smi::Cast(obj).Value());
+  }
+  EXPECT_EQ(kept.At(kNumKept - 1), from_new.At(0));
+  EXPECT(heap->Verify());
+
+  FLAG_use_evacuation = saved_use_evacuation;
+}
+
+ISOLATE_UNIT_TEST_CASE(OldSpaceTLAB) {
+  Heap* heap = thread->isolate()->heap();
+  heap->CollectAllGarbage();
+  EXPECT(!thread->HasActiveOldTLAB());
+
+  // Once the freelist hands out a buffer, small old-space objects are bump
+  // allocated next to each other.
+  const intptr_t kNumArrays = 4 * 1024;
+  const Array& arrays = Array::Handle(Array::New(kNumArrays, Heap::kOld));
+  intptr_t adjacent = 0;
+  {
+    HANDLESCOPE(thread);
+    Array& previous = Array::Handle();
+    Array& array = Array::Handle();
+    for (intptr_t i = 0; i < kNumArrays; i++) {
+      array = Array::New(1, Heap::kOld);
+      arrays.SetAt(i, array);
+      if (!previous.IsNull() &&
+          (RawObject::ToAddr(previous.raw()) + Array::InstanceSize(1) ==
+           RawObject::ToAddr(array.raw()))) {
+        adjacent++;
+      }
+      previous = array.raw();
+    }
+  }
+  EXPECT(thread->HasActiveOldTLAB());
+  EXPECT(adjacent > kNumArrays / 2);
+
+  // The unused part of the buffer is walkable while the thread owns it.
+  EXPECT(heap->Verify(kForbidMarked));
+
+  // Old-space GC returns the buffer to the freelist.
+  heap->CollectAllGarbage();
+  EXPECT(!thread->HasActiveOldTLAB());
+  for (intptr_t i = 0; i < kNumArrays; i++) {
+    EXPECT(Object::Handle(arrays.At(i)).IsArray());
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(HugePageRegions) {
+  const bool saved_use_huge_pages = FLAG_use_huge_pages;
+  FLAG_use_huge_pages = true;
+  Heap* heap = thread->heap();
+  heap->CollectAllGarbage();
+
+  // Fill several regions' worth of pages, half of which become garbage.
+  const intptr_t kNumArrays = 64;
+  const intptr_t kArrayLength = 16 * KB;
+  const Array& arrays = Array::Handle(Array::New(kNumArrays, Heap::kOld));
+  {
+    HANDLESCOPE(thread);
+    Array& array = Array::Handle();
+    for (intptr_t i = 0; i < kNumArrays; i++) {
+      array = Array::New(kArrayLength, Heap::kOld);
+      if ((i % 2) == 0) {
+        arrays.SetAt(i, array);
+      }
+    }
+  }
+  EXPECT(heap->Verify());
+
+  // Freed pages go back to their regions and are reused.
+  heap->CollectAllGarbage();
+  EXPECT(heap->Verify());
+  {
+    HANDLESCOPE(thread);
+    Array& array = Array::Handle();
+    for (intptr_t i = 1; i < kNumArrays; i += 2) {
+      array = Array::New(kArrayLength, Heap::kOld);
+      arrays.SetAt(i, array);
+    }
+  }
+  heap->CollectAllGarbage();
+  EXPECT(heap->Verify());
+  Array& array = Array::Handle();
+  for (intptr_t i = 0; i < kNumArrays; i++) {
+    array ^= arrays.At(i);
+    EXPECT_EQ(kArrayLength, array.Length());
+  }
+
+  FLAG_use_huge_pages = saved_use_huge_pages;
+}
+
 static void NoopFinalizer(void* isolate_callback_data,
                           Dart_WeakPersistentHandle handle,
                           void* peer) {}
@@ -738,6 +942,38 @@ ISOLATE_UNIT_TEST_CASE(ExternalAllocationStats) {
         heap->new_space()->ExternalInWords() * kWordSize);
   }
 }
+
+ISOLATE_UNIT_TEST_CASE(PretenureSurvivingClasses) {
+  const bool saved_use_pretenuring = FLAG_use_pretenuring;
+  FLAG_use_pretenuring = true;
+  ClassTable* class_table = thread->isolate()->class_table();
+  thread->heap()->CollectAllGarbage();
+  EXPECT(!class_table->ShouldPretenure(kArrayCid));
+  EXPECT(!class_table->ShouldPretenure(kContextCid));
+
+  // Arrays all survive, contexts all die.
+  const intptr_t kNumObjects = 2 * FLAG_pretenure_min_count;
+  const Array& arrays = Array::Handle(Array::New(kNumObjects, Heap::kOld));
+  {
+    HANDLESCOPE(thread);
+    Array& array = Array::Handle();
+    Context& context = Context::Handle();
+    for (intptr_t i = 0; i < kNumObjects; i++) {
+      array = Array::New(1, Heap::kNew);
+      arrays.SetAt(i, array);
+      context = Context::New(1, Heap::kNew);
+    }
+  }
+  HeapTestHelper::Scavenge(thread);
+  EXPECT(class_table->ShouldPretenure(kArrayCid));
+  EXPECT(!class_table->ShouldPretenure(kContextCid));
+
+  // Old-space GC forgets the decision until the next new-space GC.
+  HeapTestHelper::MarkSweep(thread);
+  EXPECT(!class_table->ShouldPretenure(kArrayCid));
+
+  FLAG_use_pretenuring = saved_use_pretenuring;
+}
 #endif  // !defined(PRODUCT)
 
 ISOLATE_UNIT_TEST_CASE(ArrayTruncationRaces) {
@@ -98,6 +98,8 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
         work_list_(marking_stack),
         deferred_work_list_(deferred_marking_stack),
         delayed_weak_properties_(NULL),
+        live_page_(NULL),
+        live_page_bytes_(0),
         marked_bytes_(0),
         marked_micros_(0) {
     ASSERT(thread_->isolate() == isolate);
@@ -178,6 +180,11 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
         }
         marked_bytes_ += size;
         NOT_IN_PRODUCT(UpdateLiveOld(class_id, size));
+        if (class_id != kInstructionsCid) {
+          // Instructions may be referenced through their executable alias and
+          // are never evacuated; don't attribute them to a page.
+          UpdateLivePage(raw_obj, size);
+        }
 
         raw_obj = work_list_.Pop();
       } while (raw_obj != NULL);
@@ -189,6 +196,8 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
       // by the handling of weak properties.
       raw_obj = work_list_.Pop();
     } while (raw_obj != NULL);
+
+    FlushLivePage();
   }
 
   void VisitPointers(RawObject** first, RawObject** last) {
@@ -329,6 +338,26 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
     PushMarked(raw_obj);
   }
 
+  // Live bytes are accumulated locally while consecutive objects come from the
+  // same page, which is common for objects allocated together, and published
+  // to the page with a single atomic add.
+  void UpdateLivePage(RawObject* raw_obj, intptr_t size) {
+    HeapPage* page = HeapPage::Of(raw_obj);
+    if (page != live_page_) {
+      FlushLivePage();
+      live_page_ = page;
+    }
+    live_page_bytes_ += size;
+  }
+
+  void FlushLivePage() {
+    if (live_page_ != NULL) {
+      live_page_->AddLiveBytes(live_page_bytes_);
+      live_page_ = NULL;
+      live_page_bytes_ = 0;
+    }
+  }
+
 #ifndef PRODUCT
   void UpdateLiveOld(intptr_t class_id, intptr_t size) {
     ASSERT(class_id < num_classes_);
@@ -347,6 +376,8 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
   MarkerWorkList work_list_;
   MarkerWorkList deferred_work_list_;
   RawWeakProperty* delayed_weak_properties_;
+  HeapPage* live_page_;
+  intptr_t live_page_bytes_;
   uintptr_t marked_bytes_;
   int64_t marked_micros_;
 
@@ -403,12 +434,9 @@ void GCMarker::Prologue() {
   isolate_->ReleaseStoreBuffers();
 
 #ifndef DART_PRECOMPILED_RUNTIME
-  Thread* mutator_thread = isolate_->mutator_thread();
-  if (mutator_thread != NULL) {
-    Interpreter* interpreter = mutator_thread->interpreter();
-    if (interpreter != NULL) {
-      interpreter->MajorGC();
-    }
+  LookupCache* lookup_cache = isolate_->interpreter_lookup_cache();
+  if (lookup_cache != NULL) {
+    lookup_cache->Clear();
   }
 #endif
 }
@@ -16,6 +16,7 @@
 #include "vm/object.h"
 #include "vm/object_set.h"
 #include "vm/os_thread.h"
+#include "vm/thread_registry.h"
 #include "vm/virtual_memory.h"
 
 namespace dart {
@@ -41,6 +42,140 @@ DEFINE_FLAG(bool,
             false,
             "Print free list statistics after a GC");
 DEFINE_FLAG(bool, log_growth, false, "Log PageSpace growth policy decisions.");
+DEFINE_FLAG(int,
+            evacuation_threshold,
+            50,
+            "Old gen pages with at most this percentage of live bytes are "
+            "candidates for evacuation");
+DEFINE_FLAG(int,
+            evacuation_budget,
+            2048,
+            "The maximum number of live KB moved by evacuation in one old gen "
+            "GC");
+
+DEFINE_FLAG(bool,
+            use_huge_pages,
+            false,
+            "Carve old gen pages and semi-spaces from 2MB regions backed by "
+            "transparent huge pages");
+DEFINE_FLAG(bool,
+            numa_local_heap,
+            false,
+            "With --use_huge_pages, place heap regions on the NUMA node of "
+            "the thread that allocates them");
+
+// A kHugePageSize region that regular data pages are carved from under
+// --use_huge_pages. Freed pages go back to their region rather than to the OS,
+// so that the kernel can keep backing the region with a single huge page, and
+// the region is unmapped once all of its pages are free.
+class HugePageRegion {
+ public:
+  static const intptr_t kSize = VirtualMemory::kHugePageSize;
+  static const intptr_t kNumPages = kSize / kPageSize;
+  static const uint32_t kAllFree = (1u << kNumPages) - 1;
+  COMPILE_ASSERT(kNumPages <= 32);
+
+  static void Init() {
+    if (mutex_ == NULL) {
+      mutex_ = new Mutex();
+    }
+    ASSERT(mutex_ != NULL);
+  }
+
+  static void Cleanup() {
+    MutexLocker ml(mutex_);
+    HugePageRegion* region = regions_;
+    regions_ = NULL;
+    while (region != NULL) {
+      HugePageRegion* next = region->next_;
+      // Regions whose pages are still in use are leaked rather than unmapped
+      // under their pages.
+      if (region->free_pages_ == kAllFree) {
+        delete region;
+      }
+      region = next;
+    }
+  }
+
+  // Returns the memory of a free page, or NULL if no region can be reserved.
+  static VirtualMemory* AllocatePage(const char* name,
+                                     HugePageRegion** result) {
+    const intptr_t numa_node =
+        FLAG_numa_local_heap ? VirtualMemory::CurrentNumaNode() : -1;
+    MutexLocker ml(mutex_);
+    HugePageRegion* region = regions_;
+    while ((region != NULL) &&
+           ((region->free_pages_ == 0) ||
+            (FLAG_numa_local_heap && (region->numa_node_ != numa_node)))) {
+      region = region->next_;
+    }
+    if (region == NULL) {
+      VirtualMemory* memory =
+          VirtualMemory::AllocateAligned(kSize, kSize, false, name);
+      if (memory == NULL) {
+        return NULL;
+      }
+      memory->AdviseHugePages();
+      if (numa_node >= 0) {
+        memory->BindToNumaNode(numa_node);
+      }
+      region = new HugePageRegion(memory, numa_node);
+      region->next_ = regions_;
+      regions_ = region;
+    }
+    const intptr_t index = Utils::CountTrailingZeros(region->free_pages_);
+    region->free_pages_ &= ~(1u << index);
+    *result = region;
+    return region->memory_->Slice(index * kPageSize, kPageSize);
+  }
+
+  static void FreePage(HugePageRegion* region, VirtualMemory* page) {
+    const intptr_t index =
+        (page->start() - region->memory_->start()) / kPageSize;
+    delete page;
+    MutexLocker ml(mutex_);
+    ASSERT((region->free_pages_ & (1u << index)) == 0);
+    region->free_pages_ |= (1u << index);
+    if (region->free_pages_ != kAllFree) {
+      return;
+    }
+    HugePageRegion** prev = &regions_;
+    while (*prev != region) {
+      prev = &(*prev)->next_;
+    }
+    *prev = region->next_;
+    delete region;
+  }
+
+ private:
+  HugePageRegion(VirtualMemory* memory, intptr_t numa_node)
+      : memory_(memory),
+        numa_node_(numa_node),
+        free_pages_(kAllFree),
+        next_(NULL) {}
+  ~HugePageRegion() { delete memory_; }
+
+  VirtualMemory* memory_;
+  intptr_t numa_node_;
+  uint32_t free_pages_;  // Bit i is set if the i-th page is free.
+  HugePageRegion* next_;
+
+  static Mutex* mutex_;
+  static HugePageRegion* regions_;
+
+  DISALLOW_COPY_AND_ASSIGN(HugePageRegion);
+};
+
+Mutex* HugePageRegion::mutex_ = NULL;
+HugePageRegion* HugePageRegion::regions_ = NULL;
+
+void HeapPage::Init() {
+  HugePageRegion::Init();
+}
+
+void HeapPage::Cleanup() {
+  HugePageRegion::Cleanup();
+}
 
 HeapPage* HeapPage::Allocate(intptr_t size_in_words,
                              PageType type,
@@ -51,8 +186,16 @@ HeapPage* HeapPage::Allocate(intptr_t size_in_words,
   bool executable = type == kExecutable;
 #endif
 
-  VirtualMemory* memory = VirtualMemory::AllocateAligned(
-      size_in_words << kWordSizeLog2, kPageSize, executable, name);
+  VirtualMemory* memory = NULL;
+  HugePageRegion* region = NULL;
+  if (FLAG_use_huge_pages && !executable &&
+      (size_in_words == kPageSizeInWords)) {
+    memory = HugePageRegion::AllocatePage(name, &region);
+  }
+  if (memory == NULL) {
+    memory = VirtualMemory::AllocateAligned(size_in_words << kWordSizeLog2,
+                                            kPageSize, executable, name);
+  }
   if (memory == NULL) {
     return NULL;
   }
@@ -62,9 +205,11 @@ HeapPage* HeapPage::Allocate(intptr_t size_in_words,
   result->memory_ = memory;
   result->next_ = NULL;
   result->used_in_bytes_ = 0;
+  result->live_bytes_ = 0;
   result->forwarding_page_ = NULL;
   result->card_table_ = NULL;
   result->type_ = type;
+  result->region_ = region;
 
   LSAN_REGISTER_ROOT_REGION(result, sizeof(*result));
 
@@ -85,6 +230,12 @@ void HeapPage::Deallocate() {
     LSAN_UNREGISTER_ROOT_REGION(this, sizeof(*this));
   }
 
+  if (region_ != NULL) {
+    // The memory for this object is reused by later pages.
+    HugePageRegion::FreePage(region_, memory_);
+    return;
+  }
+
   // For a regular heap pages, the memory for this object will become
   // unavailable after the delete below.
   delete memory_;
@@ -123,7 +274,8 @@ void HeapPage::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
 }
 
 void HeapPage::VisitRememberedCards(ObjectPointerVisitor* visitor) {
-  ASSERT(Thread::Current()->IsAtSafepoint());
+  ASSERT(Thread::Current()->IsAtSafepoint() ||
+         (Thread::Current()->task_kind() == Thread::kScavengerTask));
   NoSafepointScope no_safepoint;
 
   if (card_table_ == NULL) {
@@ -650,6 +802,95 @@ void PageSpace::MakeIterable() const {
   if (bump_top_ < bump_end_) {
     FreeListElement::AsElement(bump_top_, bump_end_ - bump_top_);
   }
+  // The owners of the allocation buffers may only be stopped at a safepoint.
+  if ((heap_ != NULL) && Thread::Current()->IsAtSafepoint()) {
+    MakeTLABsIterable();
+  }
+}
+
+static void MakeTLABIterable(Thread* thread) {
+  const uword top = thread->old_top();
+  const uword end = thread->old_end();
+  ASSERT(end >= top);
+  if (top < end) {
+    // The owner resumes allocating at top, overwriting the filler.
+    FreeListElement::AsElement(top, end - top);
+  }
+}
+
+void PageSpace::MakeTLABsIterable() const {
+  Isolate* isolate = heap_->isolate();
+  MonitorLocker ml(isolate->threads_lock(), false);
+  Thread* current = isolate->thread_registry()->active_list();
+  while (current != NULL) {
+    MakeTLABIterable(current);
+    current = current->next();
+  }
+  Thread* mutator_thread = isolate->mutator_thread();
+  if (mutator_thread != NULL) {
+    MakeTLABIterable(mutator_thread);
+  }
+}
+
+uword PageSpace::TryAllocateNewTLAB(Thread* thread, intptr_t size) {
+  ASSERT(size <= kMaxTLABObjectSize);
+  FreeList* freelist = &freelist_[HeapPage::kData];
+  MutexLocker ml(freelist->mutex());
+  AbandonTLABLocked(thread);
+  FreeListElement* block = freelist->TryAllocateLargeLocked(kTLABSize);
+  if (block == NULL) {
+    return 0;
+  }
+  const uword start = reinterpret_cast<uword>(block);
+  intptr_t block_size = block->HeapSize();
+  if (block_size >= 2 * kTLABSize) {
+    // Leave the rest of a large element for other threads and large objects.
+    freelist->FreeLocked(start + kTLABSize, block_size - kTLABSize);
+    block_size = kTLABSize;
+  }
+  AtomicOperations::IncrementBy(&(usage_.used_in_words),
+                                (block_size >> kWordSizeLog2));
+  thread->set_old_top(start + size);
+  thread->set_old_end(start + block_size);
+  return start;
+}
+
+void PageSpace::AbandonTLAB(Thread* thread) {
+  if (!thread->HasActiveOldTLAB()) {
+    return;
+  }
+  MutexLocker ml(freelist_[HeapPage::kData].mutex());
+  AbandonTLABLocked(thread);
+}
+
+void PageSpace::AbandonTLABLocked(Thread* thread) {
+  const uword top = thread->old_top();
+  const uword end = thread->old_end();
+  ASSERT(end >= top);
+  if (top < end) {
+    const intptr_t remaining = end - top;
+    freelist_[HeapPage::kData].FreeLocked(top, remaining);
+    AtomicOperations::DecrementBy(&(usage_.used_in_words),
+                                  (remaining >> kWordSizeLog2));
+  }
+  thread->set_old_top(0);
+  thread->set_old_end(0);
+}
+
+void PageSpace::AbandonTLABs() {
+  ASSERT(Thread::Current()->IsAtSafepoint());
+  Isolate* isolate = heap_->isolate();
+  MonitorLocker ml(isolate->threads_lock(), false);
+  MutexLocker ml_data(freelist_[HeapPage::kData].mutex());
+  Thread* current = isolate->thread_registry()->active_list();
+  while (current != NULL) {
+    AbandonTLABLocked(current);
+    current = current->next();
+  }
+  Thread* mutator_thread = isolate->mutator_thread();
+  if (mutator_thread != NULL) {
+    AbandonTLABLocked(mutator_thread);
+  }
 }
 
 void PageSpace::AbandonBumpAllocation() {
@@ -978,8 +1219,10 @@ bool PageSpace::ShouldPerformIdleMarkCompact(int64_t deadline) {
     }
   }
 
-  // Assuming compaction takes as long as marking.
-  intptr_t mark_compact_words_per_micro = mark_words_per_micro_ / 2;
+  // Assuming compaction takes as long as marking. Evacuation is bounded by
+  // --evacuation_budget and not accounted for.
+  intptr_t mark_compact_words_per_micro =
+      FLAG_use_evacuation ? mark_words_per_micro_ : mark_words_per_micro_ / 2;
   if (mark_compact_words_per_micro == 0) {
     mark_compact_words_per_micro = 1;  // Prevent division by zero.
   }
@@ -1054,6 +1297,10 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
   // Perform various cleanup that relies on no tasks interfering.
   isolate->class_table()->FreeOldTables();
 
+  // Return the threads' allocation buffers before the heap is verified or
+  // marked, so that pages are walkable and usage is exact.
+  AbandonTLABs();
+
   NoSafepointScope no_safepoints;
 
   if (FLAG_print_free_list_before_gc) {
@@ -1078,6 +1325,7 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
   // Mark all reachable old-gen objects.
   if (marker_ == NULL) {
     ASSERT(phase() == kDone);
+    ResetLiveBytes();
     marker_ = new GCMarker(isolate, heap_);
   } else {
     ASSERT(phase() == kAwaitingFinalization);
@@ -1157,6 +1405,10 @@ void PageSpace::CollectGarbageAtSafepoint(bool compact,
     mid3 = OS::GetCurrentMonotonicMicros();
   }
 
+  if (!compact && FLAG_use_evacuation) {
+    Evacuate(thread);
+  }
+
   if (compact) {
     Compact(thread);
     set_phase(kDone);
@@ -1244,6 +1496,78 @@ void PageSpace::Compact(Thread* thread) {
   }
 }
 
+void PageSpace::ResetLiveBytes() {
+  MutexLocker ml(&pages_lock_);
+  for (HeapPage* page = pages_; page != NULL; page = page->next()) {
+    page->ResetLiveBytes();
+  }
+  for (HeapPage* page = exec_pages_; page != NULL; page = page->next()) {
+    page->ResetLiveBytes();
+  }
+  for (HeapPage* page = large_pages_; page != NULL; page = page->next()) {
+    page->ResetLiveBytes();
+  }
+}
+
+static int CompareLiveBytes(HeapPage* const* a, HeapPage* const* b) {
+  const intptr_t a_live = (*a)->live_bytes();
+  const intptr_t b_live = (*b)->live_bytes();
+  if (a_live < b_live) {
+    return -1;
+  } else if (a_live > b_live) {
+    return 1;
+  }
+  return 0;
+}
+
+void PageSpace::Evacuate(Thread* thread) {
+  TIMELINE_FUNCTION_GC_DURATION(thread, "Evacuate");
+
+  // Pick the data pages with the lowest occupancy, up to the budget of live
+  // bytes that may be moved in this pause. Pages without live objects are
+  // released by the sweeper, and pages with remembered cards would need their
+  // card tables moved as well.
+  const intptr_t page_bytes = kPageSize - HeapPage::ObjectStartOffset();
+  const intptr_t threshold = page_bytes * FLAG_evacuation_threshold / 100;
+  MallocGrowableArray<HeapPage*> candidates;
+  for (HeapPage* page = pages_; page != NULL; page = page->next()) {
+    const intptr_t live = page->live_bytes();
+    if ((live > 0) && (live <= threshold) && (page->card_table_ == NULL)) {
+      candidates.Add(page);
+    }
+  }
+  candidates.Sort(CompareLiveBytes);
+
+  const intptr_t budget = FLAG_evacuation_budget * KB;
+  intptr_t live_bytes = 0;
+  intptr_t num_candidates = 0;
+  while (num_candidates < candidates.length()) {
+    const intptr_t live = candidates[num_candidates]->live_bytes();
+    if (live_bytes + live > budget) {
+      break;
+    }
+    live_bytes += live;
+    num_candidates++;
+  }
+
+  // Moving the survivors of n pages is only worthwhile if they fit into fewer
+  // than n pages.
+  if (num_candidates < 2) {
+    return;
+  }
+  if (Utils::RoundUp(live_bytes, page_bytes) / page_bytes >= num_candidates) {
+    return;
+  }
+  candidates.SetLength(num_candidates);
+
+  // Unlike after compaction, the heap cannot be verified until the sweeper has
+  // freed the dead objects, which may still refer to the evacuated pages.
+  thread->isolate()->set_compaction_in_progress(true);
+  GCCompactor compactor(thread, heap_);
+  compactor.Evacuate(&candidates);
+  thread->isolate()->set_compaction_in_progress(false);
+}
+
 uword PageSpace::TryAllocateDataBumpLocked(intptr_t size) {
   ASSERT(size >= kObjectAlignment);
   ASSERT(Utils::IsAligned(size, kObjectAlignment));
@@ -1303,6 +1627,18 @@ uword PageSpace::TryAllocatePromoLocked(intptr_t size) {
   return TryAllocateDataLocked(size, PageSpace::kForceGrowth);
 }
 
+void PageSpace::UnallocatePromoLocked(uword addr, intptr_t size) {
+  if (size >= kAllocatablePageSize) {
+    // The object owns a large page. Leave it to the sweeper, which releases
+    // large pages whose object is not marked.
+    FreeListElement::AsElement(addr, size);
+    return;
+  }
+  freelist_[HeapPage::kData].FreeLocked(addr, size);
+  // No need for atomic operation: we're at a safepoint.
+  usage_.used_in_words -= (size >> kWordSizeLog2);
+}
+
 void PageSpace::SetupImagePage(void* pointer, uword size, bool is_executable) {
   // Setup a HeapPage so precompiled Instructions can be traversed.
   // Instructions are contiguous at [pointer, pointer + size). HeapPage
@@ -1319,8 +1655,10 @@ void PageSpace::SetupImagePage(void* pointer, uword size, bool is_executable) {
   page->next_ = NULL;
   page->object_end_ = memory->end();
   page->used_in_bytes_ = page->object_end_ - page->object_start();
+  page->live_bytes_ = page->used_in_bytes_;
   page->forwarding_page_ = NULL;
   page->card_table_ = NULL;
+  page->region_ = NULL;
   if (is_executable) {
     ASSERT(Utils::IsAligned(pointer, OS::PreferredCodeAlignment()));
     page->type_ = HeapPage::kExecutable;
@@ -24,6 +24,7 @@ class ObjectPointerVisitor;
 class ObjectSet;
 class ForwardingPage;
 class GCMarker;
+class HugePageRegion;
 
 // TODO(iposva): Determine heap sizes and tune the page size accordingly.
 static const intptr_t kPageSize = 256 * KB;
@@ -53,9 +54,20 @@ class HeapPage {
   ForwardingPage* AllocateForwardingPage();
   void FreeForwardingPage();
 
+  // Bytes of the objects on this page found live by the last marking,
+  // including objects allocated black while marking was in progress. Only
+  // meaningful between the end of marking and the start of sweeping.
+  intptr_t live_bytes() const { return live_bytes_; }
+  void AddLiveBytes(intptr_t bytes) {
+    AtomicOperations::IncrementBy(&live_bytes_, bytes);
+  }
+  void ResetLiveBytes() { live_bytes_ = 0; }
+
   PageType type() const { return type_; }
 
-  bool is_image_page() const { return !memory_->vm_owns_region(); }
+  bool is_image_page() const {
+    return !memory_->vm_owns_region() && (region_ == NULL);
+  }
 
   void VisitObjects(ObjectVisitor* visitor) const;
   void VisitObjectPointers(ObjectPointerVisitor* visitor) const;
@@ -143,6 +155,11 @@ class HeapPage {
   }
   void VisitRememberedCards(ObjectPointerVisitor* visitor);
 
+  // Set up and tear down the process-wide pool of huge page regions that
+  // regular data pages are carved from under --use_huge_pages.
+  static void Init();
+  static void Cleanup();
+
  private:
   void set_object_end(uword value) {
     ASSERT((value & kObjectAlignmentMask) == kOldObjectAlignmentOffset);
@@ -165,6 +182,10 @@ class HeapPage {
   ForwardingPage* forwarding_page_;
   uint8_t* card_table_;  // Remembered set, not marking.
   PageType type_;
+  intptr_t live_bytes_;
+  // The region this page was carved from, or NULL if the page has a mapping
+  // of its own.
+  HugePageRegion* region_;
 
   friend class PageSpace;
   friend class GCCompactor;
@@ -286,6 +307,29 @@ class PageSpace {
                                is_locked);
   }
 
+  // Thread-local allocation buffers for small data objects. A buffer is
+  // counted as used in its entirety while a thread owns it, so the growth
+  // policy never sees more free space than the freelist can hand out.
+  static const intptr_t kTLABSize = 32 * KB;
+  static const intptr_t kMaxTLABObjectSize = 1 * KB;
+
+  uword TryAllocateInTLAB(Thread* thread, intptr_t size) {
+    ASSERT(Utils::IsAligned(size, kObjectAlignment));
+    ASSERT(size <= kMaxTLABObjectSize);
+    const uword top = thread->old_top();
+    if (static_cast<intptr_t>(thread->old_end() - top) < size) {
+      return 0;
+    }
+    thread->set_old_top(top + size);
+    return top;
+  }
+  // Replaces the thread's buffer with a large freelist element and allocates
+  // 'size' bytes from it. Returns 0 without growing the heap if the freelist
+  // has no element large enough for a buffer.
+  uword TryAllocateNewTLAB(Thread* thread, intptr_t size);
+  // Returns the unused part of the thread's buffer to the freelist.
+  void AbandonTLAB(Thread* thread);
+
   bool NeedsGarbageCollection() const {
     return page_space_controller_.NeedsGarbageCollection(usage_);
   }
@@ -376,9 +420,10 @@ class PageSpace {
   void PrintHeapMapToJSONStream(Isolate* isolate, JSONStream* stream) const;
 #endif  // PRODUCT
 
-  void AllocateBlack(intptr_t size) {
+  void AllocateBlack(uword addr, intptr_t size) {
     AtomicOperations::IncrementBy(&allocated_black_in_words_,
                                   size >> kWordSizeLog2);
+    HeapPage::Of(addr)->AddLiveBytes(size);
   }
 
   void AllocateExternal(intptr_t cid, intptr_t size);
@@ -417,6 +462,9 @@ class PageSpace {
   uword TryAllocateDataBumpLocked(intptr_t size);
   // Prefer small freelist blocks, then chip away at the bump block.
   uword TryAllocatePromoLocked(intptr_t size);
+  // Return memory obtained from TryAllocatePromoLocked that ended up unused,
+  // e.g., the tail of a parallel scavenger worker's promotion buffer.
+  void UnallocatePromoLocked(uword addr, intptr_t size);
 
   void SetupImagePage(void* pointer, uword size, bool is_executable);
 
@@ -462,6 +510,9 @@ class PageSpace {
                                bool is_locked);
   // Makes bump block walkable; do not call concurrently with mutator.
   void MakeIterable() const;
+  void MakeTLABsIterable() const;
+  void AbandonTLABs();
+  void AbandonTLABLocked(Thread* thread);
   HeapPage* AllocatePage(HeapPage::PageType type, bool link = true);
   void FreePage(HeapPage* page, HeapPage* previous_page);
   HeapPage* AllocateLargePage(intptr_t size, HeapPage::PageType type);
@@ -476,6 +527,8 @@ class PageSpace {
   void BlockingSweep();
   void ConcurrentSweep(Isolate* isolate);
   void Compact(Thread* thread);
+  void ResetLiveBytes();
+  void Evacuate(Thread* thread);
 
   static intptr_t LargePageSizeInWordsFor(intptr_t size);
 
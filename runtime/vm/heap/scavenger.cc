@@ -7,6 +7,7 @@
 #include "vm/dart.h"
 #include "vm/dart_api_state.h"
 #include "vm/flag_list.h"
+#include "vm/heap/become.h"
 #include "vm/heap/pointer_block.h"
 #include "vm/heap/safepoint.h"
 #include "vm/heap/verifier.h"
@@ -17,6 +18,8 @@
 #include "vm/object_id_ring.h"
 #include "vm/object_set.h"
 #include "vm/stack_frame.h"
+#include "vm/thread_barrier.h"
+#include "vm/thread_pool.h"
 #include "vm/thread_registry.h"
 #include "vm/timeline.h"
 #include "vm/visitor.h"
@@ -34,6 +37,9 @@ DEFINE_FLAG(int,
             "Grow new gen when less than this percentage is garbage.");
 DEFINE_FLAG(int, new_gen_growth_factor, 2, "Grow new gen by this factor.");
 
+DECLARE_FLAG(bool, use_huge_pages);
+DECLARE_FLAG(bool, numa_local_heap);
+
 // Scavenger uses RawObject::kMarkBit to distinguish forwarded and non-forwarded
 // objects. The kMarkBit does not intersect with the target address because of
 // object alignment.
@@ -85,19 +91,55 @@ static inline void objcpy(void* dst, const void* src, size_t size) {
   } while (size > 0);
 }
 
-class ScavengerVisitor : public ObjectPointerVisitor {
+// Size of the to_ space chunks that parallel scavenger workers copy surviving
+// objects into, and of the old space chunks they promote objects into.
+// Objects larger than a quarter of a chunk get an allocation of their own.
+static const intptr_t kScavengerCopyBufferSize = 64 * KB;
+static const intptr_t kScavengerPromoBufferSize = 32 * KB;
+
+template <bool parallel>
+class ScavengerVisitorBase : public ObjectPointerVisitor {
  public:
-  explicit ScavengerVisitor(Isolate* isolate,
-                            Scavenger* scavenger,
-                            SemiSpace* from)
+  explicit ScavengerVisitorBase(Isolate* isolate,
+                                Scavenger* scavenger,
+                                SemiSpace* from,
+                                MarkingStack* work_stack)
       : ObjectPointerVisitor(isolate),
         thread_(Thread::Current()),
         scavenger_(scavenger),
         from_(from),
         heap_(scavenger->heap_),
         page_space_(scavenger->heap_->old_space()),
+        work_stack_(work_stack),
+        work_(NULL),
+        delayed_weak_properties_(NULL),
         bytes_promoted_(0),
-        visiting_old_object_(NULL) {}
+        visiting_old_object_(NULL),
+        copy_top_(0),
+        copy_end_(0),
+        promo_top_(0),
+        promo_end_(0)
+#ifndef PRODUCT
+        ,
+        num_classes_(parallel ? isolate->class_table()->NumCids() : 0),
+        class_stats_(parallel ? new ClassStats[num_classes_] : NULL)
+#endif  // !PRODUCT
+  {
+    ASSERT(parallel == (work_stack != NULL));
+    if (parallel) {
+      work_ = work_stack_->PopEmptyBlock();
+#ifndef PRODUCT
+      memset(class_stats_, 0, num_classes_ * sizeof(ClassStats));
+#endif  // !PRODUCT
+    }
+  }
+
+  ~ScavengerVisitorBase() {
+    ASSERT(work_ == NULL);
+#ifndef PRODUCT
+    delete[] class_stats_;
+#endif  // !PRODUCT
+  }
 
   virtual void VisitTypedDataViewPointers(RawTypedDataView* view,
                                           RawObject** first,
@@ -161,7 +203,78 @@ class ScavengerVisitor : public ObjectPointerVisitor {
 
   intptr_t bytes_promoted() const { return bytes_promoted_; }
 
+  // Parallel only: scavenges the slots of the objects on the work list,
+  // including blocks published by other workers, until no work can be found.
+  void ProcessWorkList() {
+    ASSERT(parallel);
+    RawObject* raw_obj = PopWork();
+    while (raw_obj != NULL) {
+      intptr_t class_id = raw_obj->GetClassId();
+      intptr_t size;
+      if (raw_obj->IsNewObject()) {
+        if (class_id != kWeakPropertyCid) {
+          size = raw_obj->VisitPointersNonvirtual(this);
+        } else {
+          RawWeakProperty* raw_weak =
+              reinterpret_cast<RawWeakProperty*>(raw_obj);
+          size = ProcessWeakProperty(raw_weak);
+        }
+#ifndef PRODUCT
+        class_stats_[class_id].new_count++;
+        class_stats_[class_id].new_size += size;
+#endif  // !PRODUCT
+      } else {
+        ASSERT(!raw_obj->IsRemembered());
+        VisitingOldObject(raw_obj);
+        size = raw_obj->VisitPointersNonvirtual(this);
+        VisitingOldObject(NULL);
+#if defined(PRODUCT)
+        USE(size);
+#else
+        class_stats_[class_id].promoted_count++;
+        class_stats_[class_id].promoted_size += size;
+#endif
+        if (raw_obj->IsMarked()) {
+          // Complete our promise from ScavengePointer. See the corresponding
+          // comment in Scavenger::ProcessToSpace.
+          thread_->MarkingStackAddObject(raw_obj);
+        }
+      }
+      raw_obj = PopWork();
+    }
+  }
+
+  // Parallel only: returns the unused parts of the allocation buffers and the
+  // work block. Results are merged by Scavenger::FinalizeResultsFrom.
+  void Finalize() {
+    ASSERT(parallel);
+    ASSERT(work_->IsEmpty());
+    work_stack_->PushBlock(work_);
+    work_ = NULL;
+    // Fail fast on attempts to scavenge after finalizing.
+    work_stack_ = NULL;
+
+    AbandonCopyBuffer();
+    if (promo_top_ < promo_end_) {
+      page_space_->AcquireDataLock();
+      page_space_->UnallocatePromoLocked(promo_top_, promo_end_ - promo_top_);
+      page_space_->ReleaseDataLock();
+    }
+    promo_top_ = promo_end_ = 0;
+  }
+
  private:
+#ifndef PRODUCT
+  // Class heap stats are not thread-safe, so parallel workers accumulate them
+  // privately and merge them at the end of the scavenge.
+  struct ClassStats {
+    intptr_t new_count;
+    intptr_t new_size;
+    intptr_t promoted_count;
+    intptr_t promoted_size;
+  };
+#endif  // !PRODUCT
+
   void UpdateStoreBuffer(RawObject** p, RawObject* obj) {
     ASSERT(obj->IsHeapObject());
     if (FLAG_verify_gc_contains) {
@@ -191,18 +304,24 @@ class ScavengerVisitor : public ObjectPointerVisitor {
     ASSERT(from_->Contains(raw_addr));
     // Read the header word of the object and determine if the object has
     // already been copied.
-    uword header = *reinterpret_cast<uword*>(raw_addr);
+    uword header = parallel ? AtomicOperations::LoadAcquire(
+                                  reinterpret_cast<uword*>(raw_addr))
+                            : *reinterpret_cast<uword*>(raw_addr);
     uword new_addr = 0;
     if (IsForwarding(header)) {
       // Get the new location of the object.
       new_addr = ForwardedAddr(header);
     } else {
-      intptr_t size = raw_obj->HeapSize();
+      // Compute the size from the header we read rather than reloading it: a
+      // parallel worker may replace it with a forwarding pointer at any time.
+      // The tags are the low half of the header word.
+      intptr_t size = raw_obj->HeapSize(static_cast<uint32_t>(header));
+      bool promoted = false;
       // Check whether object should be promoted.
       if (scavenger_->survivor_end_ <= raw_addr) {
         // Not a survivor of a previous scavenge. Just copy the object into the
         // to space.
-        new_addr = scavenger_->AllocateGC(size);
+        new_addr = TryAllocateCopy(size);
       } else {
         // TODO(iposva): Experiment with less aggressive promotion. For example
         // a coin toss determines if an object is promoted or whether it should
@@ -210,24 +329,36 @@ class ScavengerVisitor : public ObjectPointerVisitor {
         //
         // This object is a survivor of a previous scavenge. Attempt to promote
         // the object.
-        new_addr = page_space_->TryAllocatePromoLocked(size);
+        new_addr = TryAllocatePromo(size);
         if (new_addr != 0) {
-          // If promotion succeeded then we need to remember it so that it can
-          // be traversed later.
-          scavenger_->PushToPromotedStack(new_addr);
-          bytes_promoted_ += size;
+          promoted = true;
         } else {
           // Promotion did not succeed. Copy into the to space instead.
           scavenger_->failed_to_promote_ = true;
-          new_addr = scavenger_->AllocateGC(size);
+          new_addr = TryAllocateCopy(size);
         }
       }
+      if (parallel && (new_addr == 0)) {
+        // Unlike the serial scavenger, parallel workers leave gaps at the end
+        // of their buffers, so copying may fail when almost everything
+        // survives. Promote the object instead.
+        new_addr = TryAllocatePromo(size);
+        if (new_addr == 0) {
+          FATAL("Out of memory during parallel scavenge");
+        }
+        promoted = true;
+      }
       // During a scavenge we always succeed to at least copy all of the
       // current objects to the to space.
       ASSERT(new_addr != 0);
       // Copy the object to the new location.
       objcpy(reinterpret_cast<void*>(new_addr),
              reinterpret_cast<void*>(raw_addr), size);
+      if (parallel) {
+        // The copy may have picked up a forwarding pointer installed by a
+        // competing worker in the meantime.
+        *reinterpret_cast<uword*>(new_addr) = header;
+      }
 
       RawObject* new_obj = RawObject::FromAddr(new_addr);
       if (new_obj->IsOldObject()) {
@@ -250,8 +381,34 @@ class ScavengerVisitor : public ObjectPointerVisitor {
         reinterpret_cast<RawTypedData*>(new_obj)->RecomputeDataField();
       }
 
-      // Remember forwarding address.
-      ForwardTo(raw_addr, new_addr);
+      if (parallel) {
+        // Publish the copy. If another worker copied the object first, use
+        // its copy and give back our allocation.
+        uword old_header = AtomicOperations::CompareAndSwapWord(
+            reinterpret_cast<uword*>(raw_addr), header, new_addr | kForwarded);
+        if (old_header == header) {
+          PushWork(new_obj);
+          if (promoted) {
+            bytes_promoted_ += size;
+          }
+        } else {
+          if (promoted) {
+            UnallocatePromo(new_addr, size);
+          } else {
+            UnallocateCopy(new_addr, size);
+          }
+          new_addr = ForwardedAddr(old_header);
+        }
+      } else {
+        if (promoted) {
+          // If promotion succeeded then we need to remember it so that it can
+          // be traversed later.
+          scavenger_->PushToPromotedStack(new_addr);
+          bytes_promoted_ += size;
+        }
+        // Remember forwarding address.
+        ForwardTo(raw_addr, new_addr);
+      }
     }
     // Update the reference.
     RawObject* new_obj = RawObject::FromAddr(new_addr);
@@ -262,18 +419,238 @@ class ScavengerVisitor : public ObjectPointerVisitor {
     }
   }
 
+  DART_FORCE_INLINE
+  uword TryAllocateCopy(intptr_t size) {
+    if (!parallel) {
+      return scavenger_->AllocateGC(size);
+    }
+    if (static_cast<intptr_t>(copy_end_ - copy_top_) >= size) {
+      uword result = copy_top_;
+      copy_top_ += size;
+      return result;
+    }
+    return TryAllocateCopySlow(size);
+  }
+
+  uword TryAllocateCopySlow(intptr_t size) {
+    if (size > (kScavengerCopyBufferSize / 4)) {
+      // Don't throw away the rest of the current buffer for a large object.
+      return scavenger_->TryAllocateGCChunk(size);
+    }
+    AbandonCopyBuffer();
+    uword chunk = scavenger_->TryAllocateGCChunk(kScavengerCopyBufferSize);
+    if (chunk == 0) {
+      // The to space is nearly exhausted; take only what we need.
+      return scavenger_->TryAllocateGCChunk(size);
+    }
+    copy_top_ = chunk + size;
+    copy_end_ = chunk + kScavengerCopyBufferSize;
+    return chunk;
+  }
+
+  void UnallocateCopy(uword addr, intptr_t size) {
+    ASSERT(parallel);
+    if (addr + size == copy_top_) {
+      copy_top_ = addr;
+    } else {
+      // A dedicated chunk for a large object. Keep the to space iterable.
+      ForwardingCorpse::AsForwarder(addr, size);
+    }
+  }
+
+  // Fills the unused end of the copy buffer so the to space stays iterable.
+  void AbandonCopyBuffer() {
+    intptr_t remaining = copy_end_ - copy_top_;
+    if (remaining >= kObjectAlignment) {
+      ForwardingCorpse::AsForwarder(copy_top_, remaining);
+    }
+    copy_top_ = copy_end_ = 0;
+  }
+
+  DART_FORCE_INLINE
+  uword TryAllocatePromo(intptr_t size) {
+    if (!parallel) {
+      return page_space_->TryAllocatePromoLocked(size);
+    }
+    if (static_cast<intptr_t>(promo_end_ - promo_top_) >= size) {
+      uword result = promo_top_;
+      promo_top_ += size;
+      return result;
+    }
+    return TryAllocatePromoSlow(size);
+  }
+
+  uword TryAllocatePromoSlow(intptr_t size) {
+    // Parallel workers take the data lock only to refill their buffers.
+    page_space_->AcquireDataLock();
+    uword result;
+    if (size > (kScavengerPromoBufferSize / 4)) {
+      // Don't throw away the rest of the current buffer for a large object.
+      result = page_space_->TryAllocatePromoLocked(size);
+    } else {
+      if (promo_top_ < promo_end_) {
+        page_space_->UnallocatePromoLocked(promo_top_,
+                                           promo_end_ - promo_top_);
+      }
+      promo_top_ = promo_end_ = 0;
+      result = page_space_->TryAllocatePromoLocked(kScavengerPromoBufferSize);
+      if (result != 0) {
+        promo_top_ = result + size;
+        promo_end_ = result + kScavengerPromoBufferSize;
+      } else {
+        result = page_space_->TryAllocatePromoLocked(size);
+      }
+    }
+    page_space_->ReleaseDataLock();
+    return result;
+  }
+
+  void UnallocatePromo(uword addr, intptr_t size) {
+    ASSERT(parallel);
+    if (addr + size == promo_top_) {
+      promo_top_ = addr;
+    } else {
+      page_space_->AcquireDataLock();
+      page_space_->UnallocatePromoLocked(addr, size);
+      page_space_->ReleaseDataLock();
+    }
+  }
+
+  void PushWork(RawObject* raw_obj) {
+    ASSERT(parallel);
+    if (work_->IsFull()) {
+      work_stack_->PushBlock(work_);
+      work_ = work_stack_->PopEmptyBlock();
+    }
+    work_->Push(raw_obj);
+  }
+
+  // Returns NULL if no more work was found.
+  RawObject* PopWork() {
+    ASSERT(parallel);
+    if (work_->IsEmpty()) {
+      MarkingStackBlock* new_work = work_stack_->PopNonEmptyBlock();
+      if (new_work == NULL) {
+        return NULL;
+      }
+      work_stack_->PushBlock(work_);
+      work_ = new_work;
+    }
+    return work_->Pop();
+  }
+
+  // Parallel counterpart of Scavenger::ProcessWeakProperty. Weak properties
+  // whose keys are not yet reachable are kept on a private list, which the
+  // scavenger finishes on the main thread once all workers are done.
+  intptr_t ProcessWeakProperty(RawWeakProperty* raw_weak) {
+    ASSERT(parallel);
+    // The fate of the weak property is determined by its key.
+    RawObject* raw_key = raw_weak->ptr()->key_;
+    if (raw_key->IsHeapObject() && raw_key->IsNewObject()) {
+      uword raw_addr = RawObject::ToAddr(raw_key);
+      uword header =
+          AtomicOperations::LoadAcquire(reinterpret_cast<uword*>(raw_addr));
+      if (!IsForwarding(header)) {
+        // Key is white.  Delay the weak property.
+        ASSERT(raw_weak->ptr()->next_ == 0);
+        raw_weak->ptr()->next_ =
+            reinterpret_cast<uword>(delayed_weak_properties_);
+        delayed_weak_properties_ = raw_weak;
+        return raw_weak->HeapSize();
+      }
+    }
+    // Key is gray or black.  Make the weak property black.
+    return raw_weak->VisitPointersNonvirtual(this);
+  }
+
   Thread* thread_;
   Scavenger* scavenger_;
   SemiSpace* from_;
   Heap* heap_;
   PageSpace* page_space_;
+  // Parallel only: objects whose slots still need to be scavenged.
+  MarkingStack* work_stack_;
+  MarkingStackBlock* work_;
   RawWeakProperty* delayed_weak_properties_;
   intptr_t bytes_promoted_;
   RawObject* visiting_old_object_;
+  // Parallel only: private allocation buffers in to space and old space.
+  uword copy_top_;
+  uword copy_end_;
+  uword promo_top_;
+  uword promo_end_;
+#ifndef PRODUCT
+  intptr_t num_classes_;
+  ClassStats* class_stats_;
+#endif  // !PRODUCT
 
   friend class Scavenger;
 
-  DISALLOW_COPY_AND_ASSIGN(ScavengerVisitor);
+  DISALLOW_COPY_AND_ASSIGN(ScavengerVisitorBase);
+};
+
+class ParallelScavengerTask : public ThreadPool::Task {
+ public:
+  ParallelScavengerTask(Isolate* isolate,
+                        Scavenger* scavenger,
+                        SemiSpace* from,
+                        MarkingStack* work_stack,
+                        ThreadBarrier* barrier,
+                        uintptr_t* num_busy)
+      : isolate_(isolate),
+        scavenger_(scavenger),
+        from_(from),
+        work_stack_(work_stack),
+        barrier_(barrier),
+        num_busy_(num_busy) {}
+
+  virtual void Run() {
+    bool result =
+        Thread::EnterIsolateAsHelper(isolate_, Thread::kScavengerTask, true);
+    ASSERT(result);
+    {
+      TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ParallelScavenge");
+      ParallelScavengerVisitor visitor(isolate_, scavenger_, from_,
+                                       work_stack_);
+      scavenger_->IterateRootSlices(isolate_, &visitor);
+      scavenger_->IterateStoreBufferBlocks(isolate_, &visitor);
+
+      do {
+        visitor.ProcessWorkList();
+
+        // I can't find more work right now. If no other task is busy,
+        // then there will never be more work (NB: 1 is *before* decrement).
+        if (AtomicOperations::FetchAndDecrement(num_busy_) == 1) break;
+
+        // Wait for some work to appear.
+        while (work_stack_->IsEmpty() &&
+               AtomicOperations::LoadRelaxed(num_busy_) > 0) {
+        }
+
+        // If no tasks are busy, there will never be more work.
+        if (AtomicOperations::LoadRelaxed(num_busy_) == 0) break;
+
+        // I saw some work; get busy and compete for it.
+        AtomicOperations::FetchAndIncrement(num_busy_);
+      } while (true);
+
+      scavenger_->FinalizeResultsFrom(&visitor);
+    }
+    Thread::ExitIsolateAsHelper(true);
+
+    // This task is done. Notify the original thread.
+    barrier_->Exit();
+  }
+
+ private:
+  Isolate* isolate_;
+  Scavenger* scavenger_;
+  SemiSpace* from_;
+  MarkingStack* work_stack_;
+  ThreadBarrier* barrier_;
+  uintptr_t* num_busy_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelScavengerTask);
 };
 
 class ScavengerWeakVisitor : public HandleVisitor {
@@ -383,8 +760,19 @@ SemiSpace* SemiSpace::New(intptr_t size_in_words, const char* name) {
   } else {
     intptr_t size_in_bytes = size_in_words << kWordSizeLog2;
     const bool kExecutable = false;
-    VirtualMemory* memory =
-        VirtualMemory::Allocate(size_in_bytes, kExecutable, name);
+    VirtualMemory* memory = nullptr;
+    if (FLAG_use_huge_pages) {
+      memory = VirtualMemory::AllocateAligned(
+          size_in_bytes, VirtualMemory::kHugePageSize, kExecutable, name);
+      if (memory != nullptr) {
+        memory->AdviseHugePages();
+        if (FLAG_numa_local_heap) {
+          memory->BindToNumaNode(VirtualMemory::CurrentNumaNode());
+        }
+      }
+    } else {
+      memory = VirtualMemory::Allocate(size_in_bytes, kExecutable, name);
+    }
     if (memory == nullptr) {
       // TODO(koda): If cache_ is not empty, we could try to delete it.
       return nullptr;
@@ -439,7 +827,11 @@ Scavenger::Scavenger(Heap* heap,
       scavenge_words_per_micro_(kConservativeInitialScavengeSpeed),
       idle_scavenge_threshold_in_words_(0),
       external_size_(0),
-      failed_to_promote_(false) {
+      failed_to_promote_(false),
+      root_slices_not_started_(0),
+      pending_store_buffer_blocks_(NULL),
+      store_buffer_entries_(0),
+      parallel_bytes_promoted_(0) {
   // Verify assumptions about the first word in objects which the scavenger is
   // going to use for forwarding pointers.
   ASSERT(Object::tags_offset() == 0);
@@ -594,6 +986,7 @@ void Scavenger::Epilogue(Isolate* isolate, SemiSpace* from) {
   }
 
   NOT_IN_PRODUCT(isolate->class_table()->UpdatePromoted());
+  NOT_IN_PRODUCT(isolate->class_table()->UpdatePretenuring());
 }
 
 bool Scavenger::ShouldPerformIdleScavenge(int64_t deadline) {
@@ -613,7 +1006,7 @@ bool Scavenger::ShouldPerformIdleScavenge(int64_t deadline) {
 }
 
 void Scavenger::IterateStoreBuffers(Isolate* isolate,
-                                    ScavengerVisitor* visitor) {
+                                    SerialScavengerVisitor* visitor) {
   // Iterating through the store buffers.
   // Grab the deduplication sets out of the isolate's consolidated store buffer.
   StoreBufferBlock* pending = isolate->store_buffer()->Blocks();
@@ -649,7 +1042,7 @@ void Scavenger::IterateStoreBuffers(Isolate* isolate,
 }
 
 void Scavenger::IterateObjectIdTable(Isolate* isolate,
-                                     ScavengerVisitor* visitor) {
+                                     ObjectPointerVisitor* visitor) {
 #ifndef PRODUCT
   if (!FLAG_support_service) {
     return;
@@ -658,7 +1051,8 @@ void Scavenger::IterateObjectIdTable(Isolate* isolate,
 #endif  // !PRODUCT
 }
 
-void Scavenger::IterateRoots(Isolate* isolate, ScavengerVisitor* visitor) {
+void Scavenger::IterateRoots(Isolate* isolate,
+                             SerialScavengerVisitor* visitor) {
 #ifdef SUPPORT_TIMELINE
   Thread* thread = Thread::Current();
 #endif
@@ -681,6 +1075,153 @@ void Scavenger::IterateRoots(Isolate* isolate, ScavengerVisitor* visitor) {
   heap_->RecordTime(kDummyScavengeTime, 0);
 }
 
+void Scavenger::IterateRootSlices(Isolate* isolate,
+                                  ParallelScavengerVisitor* visitor) {
+  for (;;) {
+    intptr_t slice =
+        AtomicOperations::FetchAndDecrement(&root_slices_not_started_) - 1;
+    if (slice < 0) {
+      return;  // No more slices.
+    }
+
+    switch (slice) {
+      case kIsolate: {
+        TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ProcessRoots");
+        isolate->VisitObjectPointers(visitor,
+                                     ValidationPolicy::kDontValidateFrames);
+        break;
+      }
+      case kRememberedCards: {
+        TIMELINE_FUNCTION_GC_DURATION(Thread::Current(),
+                                      "ProcessRememberedCards");
+        heap_->old_space()->VisitRememberedCards(visitor);
+        visitor->VisitingOldObject(NULL);
+        break;
+      }
+      case kObjectIdRing: {
+        IterateObjectIdTable(isolate, visitor);
+        break;
+      }
+      default:
+        UNREACHABLE();
+    }
+  }
+}
+
+StoreBufferBlock* Scavenger::PopPendingStoreBufferBlock() {
+  MutexLocker ml(&parallel_lock_);
+  StoreBufferBlock* block = pending_store_buffer_blocks_;
+  if (block != NULL) {
+    pending_store_buffer_blocks_ = block->next();
+  }
+  return block;
+}
+
+void Scavenger::IterateStoreBufferBlocks(Isolate* isolate,
+                                         ParallelScavengerVisitor* visitor) {
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "ProcessRememberedSet");
+  intptr_t total_count = 0;
+  StoreBufferBlock* pending = PopPendingStoreBufferBlock();
+  while (pending != NULL) {
+    // Generated code appends to store buffers; tell MemorySanitizer.
+    MSAN_UNPOISON(pending, sizeof(*pending));
+    total_count += pending->Count();
+    while (!pending->IsEmpty()) {
+      RawObject* raw_object = pending->Pop();
+      ASSERT(!raw_object->IsForwardingCorpse());
+      ASSERT(raw_object->IsRemembered());
+      raw_object->ClearRememberedBit();
+      visitor->VisitingOldObject(raw_object);
+      raw_object->VisitPointersNonvirtual(visitor);
+    }
+    pending->Reset();
+    // Return the emptied block for recycling (no need to check threshold).
+    isolate->store_buffer()->PushBlock(pending, StoreBuffer::kIgnoreThreshold);
+    pending = PopPendingStoreBufferBlock();
+  }
+  visitor->VisitingOldObject(NULL);
+  AtomicOperations::IncrementBy(&store_buffer_entries_, total_count);
+}
+
+void Scavenger::FinalizeResultsFrom(ParallelScavengerVisitor* visitor) {
+  visitor->Finalize();
+
+  MutexLocker ml(&parallel_lock_);
+  parallel_bytes_promoted_ += visitor->bytes_promoted();
+
+  // Hand the delayed weak properties over to the main thread.
+  RawWeakProperty* cur_weak = visitor->delayed_weak_properties_;
+  visitor->delayed_weak_properties_ = NULL;
+  while (cur_weak != NULL) {
+    uword next_weak = cur_weak->ptr()->next_;
+    cur_weak->ptr()->next_ = 0;
+    EnqueueWeakProperty(cur_weak);
+    cur_weak = reinterpret_cast<RawWeakProperty*>(next_weak);
+  }
+
+#ifndef PRODUCT
+  // Class heap stats are not themselves thread-safe yet, so we update the
+  // stats while holding parallel_lock_.
+  ClassTable* table = heap_->isolate()->class_table();
+  for (intptr_t i = 0; i < visitor->num_classes_; i++) {
+    const ParallelScavengerVisitor::ClassStats& stats =
+        visitor->class_stats_[i];
+    if (stats.new_count > 0) {
+      table->UpdateLiveNewGC(i, stats.new_size, stats.new_count);
+    }
+    if (stats.promoted_count > 0) {
+      table->UpdateAllocatedOldGC(i, stats.promoted_size,
+                                  stats.promoted_count);
+    }
+  }
+#endif  // !PRODUCT
+}
+
+intptr_t Scavenger::ParallelScavenge(Isolate* isolate, SemiSpace* from) {
+  const intptr_t num_tasks = FLAG_scavenger_tasks;
+  ASSERT(num_tasks > 0);
+  int64_t start = OS::GetCurrentMonotonicMicros();
+
+  // The tasks claim root slices and store buffer blocks one at a time.
+  root_slices_not_started_ = kNumRootSlices;
+  pending_store_buffer_blocks_ = isolate->store_buffer()->Blocks();
+  store_buffer_entries_ = 0;
+  parallel_bytes_promoted_ = 0;
+
+  MarkingStack work_stack;
+  {
+    ThreadBarrier barrier(num_tasks + 1, heap_->barrier(),
+                          heap_->barrier_done());
+    // Used to coordinate draining among tasks; all start out as 'busy'.
+    uintptr_t num_busy = num_tasks;
+    for (intptr_t i = 0; i < num_tasks; i++) {
+      bool result = Dart::thread_pool()->Run<ParallelScavengerTask>(
+          isolate, this, from, &work_stack, &barrier, &num_busy);
+      ASSERT(result);
+    }
+    // Wait for all tasks to finish.
+    barrier.Exit();
+  }
+  ASSERT(work_stack.IsEmpty());
+  ASSERT(pending_store_buffer_blocks_ == NULL);
+
+  // Every task has filled the unused end of its copy buffer, so the to space
+  // is iterable up to top_, and everything below top_ has been scanned.
+  resolved_top_ = top_;
+
+  int64_t end = OS::GetCurrentMonotonicMicros();
+  heap_->RecordData(kStoreBufferEntries, store_buffer_entries_);
+  heap_->RecordData(kDataUnused1, 0);
+  heap_->RecordData(kDataUnused2, 0);
+  heap_->RecordData(kToKBAfterStoreBuffer, RoundWordsToKB(UsedInWords()));
+  // Roots and store buffers are processed together with the to space, so
+  // the whole parallel phase is attributed to visiting roots.
+  heap_->RecordTime(kVisitIsolateRoots, end - start);
+  heap_->RecordTime(kIterateStoreBuffers, 0);
+  heap_->RecordTime(kDummyScavengeTime, 0);
+  return parallel_bytes_promoted_;
+}
+
 bool Scavenger::IsUnreachable(RawObject** p) {
   RawObject* raw_obj = *p;
   if (!raw_obj->IsHeapObject()) {
@@ -706,12 +1247,13 @@ void Scavenger::IterateWeakRoots(Isolate* isolate, HandleVisitor* visitor) {
   isolate->VisitWeakPersistentHandles(visitor);
 }
 
-void Scavenger::ProcessToSpace(ScavengerVisitor* visitor) {
+void Scavenger::ProcessToSpace(SerialScavengerVisitor* visitor) {
   Thread* thread = Thread::Current();
   NOT_IN_PRODUCT(ClassTable* class_table = thread->isolate()->class_table());
 
-  // Iterate until all work has been drained.
-  while ((resolved_top_ < top_) || PromotedStackHasMore()) {
+  // Iterate until all work has been drained. After a parallel scavenge, the
+  // only work left may be the weak properties delayed by the workers.
+  do {
     while (resolved_top_ < top_) {
       RawObject* raw_obj = RawObject::FromAddr(resolved_top_);
       intptr_t class_id = raw_obj->GetClassId();
@@ -783,7 +1325,7 @@ void Scavenger::ProcessToSpace(ScavengerVisitor* visitor) {
         cur_weak = reinterpret_cast<RawWeakProperty*>(next_weak);
       }
     }
-  }
+  } while ((resolved_top_ < top_) || PromotedStackHasMore());
 }
 
 void Scavenger::UpdateMaxHeapCapacity() {
@@ -830,7 +1372,7 @@ void Scavenger::EnqueueWeakProperty(RawWeakProperty* raw_weak) {
 }
 
 uword Scavenger::ProcessWeakProperty(RawWeakProperty* raw_weak,
-                                     ScavengerVisitor* visitor) {
+                                     SerialScavengerVisitor* visitor) {
   // The fate of the weak property is determined by its key.
   RawObject* raw_key = raw_weak->ptr()->key_;
   if (raw_key->IsHeapObject() && raw_key->IsNewObject()) {
@@ -1051,9 +1593,16 @@ void Scavenger::Scavenge() {
   {
     StackZone zone(thread);
     // Setup the visitor and run the scavenge.
-    ScavengerVisitor visitor(isolate, this, from);
-    page_space->AcquireDataLock();
-    IterateRoots(isolate, &visitor);
+    SerialScavengerVisitor visitor(isolate, this, from, NULL);
+    intptr_t bytes_promoted = 0;
+    if (FLAG_scavenger_tasks > 0) {
+      // The tasks take the data lock when refilling their promotion buffers.
+      bytes_promoted = ParallelScavenge(isolate, from);
+      page_space->AcquireDataLock();
+    } else {
+      page_space->AcquireDataLock();
+      IterateRoots(isolate, &visitor);
+    }
     int64_t iterate_roots = OS::GetCurrentMonotonicMicros();
     {
       TIMELINE_FUNCTION_GC_DURATION(thread, "ProcessToSpace");
@@ -1074,7 +1623,7 @@ void Scavenger::Scavenge() {
     heap_->RecordTime(kIterateWeaks, end - process_to_space);
     stats_history_.Add(ScavengeStats(
         start, end, usage_before, GetCurrentUsage(), promo_candidate_words,
-        visitor.bytes_promoted() >> kWordSizeLog2));
+        (bytes_promoted + visitor.bytes_promoted()) >> kWordSizeLog2));
   }
   Epilogue(isolate, from);
 
@@ -6,10 +6,12 @@
 #define RUNTIME_VM_HEAP_SCAVENGER_H_
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
 #include "platform/utils.h"
 #include "vm/dart.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
+#include "vm/heap/pointer_block.h"
 #include "vm/heap/spaces.h"
 #include "vm/lockers.h"
 #include "vm/raw_object.h"
@@ -24,7 +26,10 @@ class Heap;
 class Isolate;
 class JSONObject;
 class ObjectSet;
-class ScavengerVisitor;
+template <bool parallel>
+class ScavengerVisitorBase;
+typedef ScavengerVisitorBase<false> SerialScavengerVisitor;
+typedef ScavengerVisitorBase<true> ParallelScavengerVisitor;
 
 // Wrapper around VirtualMemory that adds caching and handles the empty case.
 class SemiSpace {
@@ -129,6 +134,28 @@ class Scavenger {
 
   uword TryAllocateNewTLAB(Thread* thread, intptr_t size);
 
+  // Claims a chunk of the to_ space for a parallel scavenger worker. Returns 0
+  // if the to_ space cannot accommodate the chunk.
+  uword TryAllocateGCChunk(intptr_t size) {
+    ASSERT(Utils::IsAligned(size, kObjectAlignment));
+    ASSERT(scavenging_);
+    uword top = AtomicOperations::LoadRelaxed(&top_);
+    for (;;) {
+      intptr_t remaining = end_ - top;
+      if (remaining < size) {
+        return 0;
+      }
+      uword old_top = AtomicOperations::CompareAndSwapWord(&top_, top,
+                                                           top + size);
+      if (old_top == top) {
+        ASSERT(to_->Contains(top));
+        ASSERT((top & kObjectAlignmentMask) == object_alignment_);
+        return top;
+      }
+      top = old_top;
+    }
+  }
+
   uword AllocateGC(intptr_t size) {
     ASSERT(Utils::IsAligned(size, kObjectAlignment));
     ASSERT(heap_ != Dart::vm_isolate()->heap());
@@ -237,18 +264,35 @@ class Scavenger {
     kToKBAfterStoreBuffer = 3
   };
 
+  // Roots that are split among parallel scavenger tasks, in addition to the
+  // blocks of the store buffer.
+  enum RootSlices {
+    kIsolate = 0,
+    kRememberedCards = 1,
+    kObjectIdRing = 2,
+    kNumRootSlices = 3,
+  };
+
   uword FirstObjectStart() const { return to_->start() | object_alignment_; }
   SemiSpace* Prologue(Isolate* isolate);
-  void IterateStoreBuffers(Isolate* isolate, ScavengerVisitor* visitor);
-  void IterateObjectIdTable(Isolate* isolate, ScavengerVisitor* visitor);
-  void IterateRoots(Isolate* isolate, ScavengerVisitor* visitor);
-  void IterateWeakProperties(Isolate* isolate, ScavengerVisitor* visitor);
-  void IterateWeakReferences(Isolate* isolate, ScavengerVisitor* visitor);
+  void IterateStoreBuffers(Isolate* isolate, SerialScavengerVisitor* visitor);
+  void IterateObjectIdTable(Isolate* isolate, ObjectPointerVisitor* visitor);
+  void IterateRoots(Isolate* isolate, SerialScavengerVisitor* visitor);
   void IterateWeakRoots(Isolate* isolate, HandleVisitor* visitor);
-  void ProcessToSpace(ScavengerVisitor* visitor);
+  void ProcessToSpace(SerialScavengerVisitor* visitor);
   void EnqueueWeakProperty(RawWeakProperty* raw_weak);
   uword ProcessWeakProperty(RawWeakProperty* raw_weak,
-                            ScavengerVisitor* visitor);
+                            SerialScavengerVisitor* visitor);
+
+  // Parallel scavenge: FLAG_scavenger_tasks workers scavenge the roots and
+  // the transitive closure of to_ space and promoted objects. Returns the
+  // number of bytes promoted by the workers.
+  intptr_t ParallelScavenge(Isolate* isolate, SemiSpace* from);
+  void IterateRootSlices(Isolate* isolate, ParallelScavengerVisitor* visitor);
+  void IterateStoreBufferBlocks(Isolate* isolate,
+                                ParallelScavengerVisitor* visitor);
+  StoreBufferBlock* PopPendingStoreBufferBlock();
+  void FinalizeResultsFrom(ParallelScavengerVisitor* visitor);
   void Epilogue(Isolate* isolate, SemiSpace* from);
 
   bool IsUnreachable(RawObject** p);
@@ -323,8 +367,18 @@ class Scavenger {
   // Protects new space during the allocation of new TLABs
   Mutex space_lock_;
 
-  friend class ScavengerVisitor;
+  // State shared by the tasks of a parallel scavenge.
+  intptr_t root_slices_not_started_;
+  StoreBufferBlock* pending_store_buffer_blocks_;
+  intptr_t store_buffer_entries_;
+  intptr_t parallel_bytes_promoted_;
+  // Protects the pending store buffer blocks and the merging of results.
+  Mutex parallel_lock_;
+
+  template <bool>
+  friend class ScavengerVisitorBase;
   friend class ScavengerWeakVisitor;
+  friend class ParallelScavengerTask;
 
   DISALLOW_COPY_AND_ASSIGN(Scavenger);
 };
@@ -22,6 +22,7 @@
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
+#include "vm/os.h"
 #include "vm/os_thread.h"
 #include "vm/stack_frame_kbc.h"
 #include "vm/symbols.h"
@@ -40,6 +41,18 @@ DEFINE_FLAG(uint64_t,
             interpreter_trace_file_max_bytes,
             100 * MB,
             "Maximum size in bytes of the interpreter trace file");
+DEFINE_FLAG(int,
+            interpreter_lookup_cache_size,
+            4096,
+            "Number of entries in the per-isolate cache of interface call "
+            "targets of the interpreter (rounded up to a power of two).");
+#if defined(DEBUG)
+DEFINE_FLAG(bool,
+            interpreter_bytecode_profile,
+            false,
+            "Count executed bytecodes and pairs of adjacent bytecodes, and "
+            "print the most frequent ones when the interpreter is destroyed.");
+#endif  // defined(DEBUG)
 
 // InterpreterSetjmpBuffer are linked together, and the last created one
 // is referenced by the Interpreter. When an exception is thrown, the exception
@@ -256,33 +269,60 @@ DART_FORCE_INLINE static RawObject* InitializeHeader(uword addr,
   return RawObject::FromAddr(addr);
 }
 
+LookupCache::LookupCache(intptr_t num_entries)
+    : sets_(NULL), set_mask_(0), num_hits_(0), num_misses_(0) {
+  ASSERT(Utils::IsPowerOfTwo(sizeof(Entry)));
+  const intptr_t num_sets = Utils::RoundUpToPowerOfTwo(
+      Utils::Maximum<intptr_t>(num_entries / kAssociativity, 1));
+  sets_ = new Set[num_sets];
+  set_mask_ = num_sets - 1;
+  Clear();
+}
+
+LookupCache::~LookupCache() {
+  delete[] sets_;
+}
+
+DART_FORCE_INLINE LookupCache::Set* LookupCache::SetFor(
+    intptr_t receiver_cid,
+    RawString* function_name) const {
+  const uword hash =
+      (reinterpret_cast<uword>(function_name) >> kObjectAlignmentLog2) ^
+      static_cast<uword>(receiver_cid);
+  return &sets_[hash & set_mask_];
+}
+
 void LookupCache::Clear() {
-  for (intptr_t i = 0; i < kNumEntries; i++) {
-    entries_[i].receiver_cid = kIllegalCid;
+  for (uword i = 0; i <= set_mask_; i++) {
+    for (intptr_t j = 0; j < kAssociativity; j++) {
+      sets_[i].ways[j].receiver_cid = kIllegalCid;
+    }
   }
 }
 
 bool LookupCache::Lookup(intptr_t receiver_cid,
                          RawString* function_name,
-                         RawFunction** target) const {
+                         RawFunction** target) {
   ASSERT(receiver_cid != kIllegalCid);  // Sentinel value.
 
-  const intptr_t hash =
-      receiver_cid ^ reinterpret_cast<intptr_t>(function_name);
-  const intptr_t probe1 = hash & kTableMask;
-  if (entries_[probe1].receiver_cid == receiver_cid &&
-      entries_[probe1].function_name == function_name) {
-    *target = entries_[probe1].target;
-    return true;
-  }
-
-  intptr_t probe2 = (hash >> 3) & kTableMask;
-  if (entries_[probe2].receiver_cid == receiver_cid &&
-      entries_[probe2].function_name == function_name) {
-    *target = entries_[probe2].target;
-    return true;
+  Entry* ways = SetFor(receiver_cid, function_name)->ways;
+  for (intptr_t i = 0; i < kAssociativity; i++) {
+    if (ways[i].receiver_cid == receiver_cid &&
+        ways[i].function_name == function_name) {
+      *target = ways[i].target;
+      // Keep the ways ordered from the most to the least recently used.
+      if (i != 0) {
+        const Entry hit = ways[i];
+        for (intptr_t j = i; j > 0; j--) {
+          ways[j] = ways[j - 1];
+        }
+        ways[0] = hit;
+      }
+      num_hits_++;
+      return true;
+    }
   }
-
+  num_misses_++;
   return false;
 }
 
@@ -293,31 +333,18 @@ void LookupCache::Insert(intptr_t receiver_cid,
   ASSERT(function_name->IsOldObject());
   ASSERT(target->IsOldObject());
 
-  const intptr_t hash =
-      receiver_cid ^ reinterpret_cast<intptr_t>(function_name);
-  const intptr_t probe1 = hash & kTableMask;
-  if (entries_[probe1].receiver_cid == kIllegalCid) {
-    entries_[probe1].receiver_cid = receiver_cid;
-    entries_[probe1].function_name = function_name;
-    entries_[probe1].target = target;
-    return;
+  // Evict the least recently used entry, which is the last one.
+  Entry* ways = SetFor(receiver_cid, function_name)->ways;
+  for (intptr_t j = kAssociativity - 1; j > 0; j--) {
+    ways[j] = ways[j - 1];
   }
-
-  const intptr_t probe2 = (hash >> 3) & kTableMask;
-  if (entries_[probe2].receiver_cid == kIllegalCid) {
-    entries_[probe2].receiver_cid = receiver_cid;
-    entries_[probe2].function_name = function_name;
-    entries_[probe2].target = target;
-    return;
-  }
-
-  entries_[probe1].receiver_cid = receiver_cid;
-  entries_[probe1].function_name = function_name;
-  entries_[probe1].target = target;
+  ways[0].receiver_cid = receiver_cid;
+  ways[0].function_name = function_name;
+  ways[0].target = target;
 }
 
 Interpreter::Interpreter()
-    : stack_(NULL), fp_(NULL), pp_(NULL), argdesc_(NULL), lookup_cache_() {
+    : stack_(NULL), fp_(NULL), pp_(NULL), argdesc_(NULL) {
 #if defined(TARGET_ARCH_DBC)
   FATAL("Interpreter is not supported when targeting DBC\n");
 #endif  // defined(USING_SIMULATOR) || defined(TARGET_ARCH_DBC)
@@ -355,6 +382,13 @@ Interpreter::Interpreter()
       trace_buffer_idx_ = 0;
     }
   }
+  bytecode_counts_ = NULL;
+  bytecode_pair_counts_ = NULL;
+  last_counted_pc_ = NULL;
+  if (FLAG_interpreter_bytecode_profile) {
+    bytecode_counts_ = new uint64_t[kNumOpcodes]();
+    bytecode_pair_counts_ = new uint64_t[kNumOpcodes * kNumOpcodes]();
+  }
 #endif
 }
 
@@ -374,6 +408,13 @@ Interpreter::~Interpreter() {
       trace_buffer_ = NULL;
     }
   }
+  if (bytecode_counts_ != NULL) {
+    PrintBytecodeProfile();
+    delete[] bytecode_counts_;
+    bytecode_counts_ = NULL;
+    delete[] bytecode_pair_counts_;
+    bytecode_pair_counts_ = NULL;
+  }
 #endif
 }
 
@@ -385,6 +426,11 @@ Interpreter* Interpreter::Current() {
     TransitionGeneratedToVM transition(thread);
     interpreter = new Interpreter();
     Thread::Current()->set_interpreter(interpreter);
+    Isolate* isolate = thread->isolate();
+    if (isolate->interpreter_lookup_cache() == nullptr) {
+      isolate->set_interpreter_lookup_cache(
+          new LookupCache(FLAG_interpreter_lookup_cache_size));
+    }
   }
   return interpreter;
 }
@@ -447,6 +493,92 @@ DART_NOINLINE void Interpreter::WriteInstructionToTrace(const KBCInstr* pc) {
   }
 }
 
+DART_NOINLINE void Interpreter::CountInstruction(const KBCInstr* pc) {
+  const KBCInstr op = *pc;
+  bytecode_counts_[op]++;
+  // Only instructions falling through to the next one can be fused into a
+  // superinstruction, so jumps, calls and returns do not form pairs.
+  if ((last_counted_pc_ != NULL) &&
+      (KernelBytecode::Next(last_counted_pc_) == pc)) {
+    bytecode_pair_counts_[*last_counted_pc_ * kNumOpcodes + op]++;
+  }
+  last_counted_pc_ = pc;
+}
+
+struct BytecodeProfileEntry {
+  intptr_t index;
+  uint64_t count;
+};
+
+static int CompareBytecodeProfileEntries(const void* a, const void* b) {
+  const uint64_t count_a =
+      reinterpret_cast<const BytecodeProfileEntry*>(a)->count;
+  const uint64_t count_b =
+      reinterpret_cast<const BytecodeProfileEntry*>(b)->count;
+  if (count_a != count_b) {
+    return (count_a > count_b) ? -1 : 1;
+  }
+  return 0;
+}
+
+// Sorts the non-zero counts in decreasing order. Returns the number of
+// entries written to [entries], which must have room for [length] entries.
+static intptr_t SortBytecodeCounts(const uint64_t* counts,
+                                   intptr_t length,
+                                   BytecodeProfileEntry* entries) {
+  intptr_t num_entries = 0;
+  for (intptr_t i = 0; i < length; i++) {
+    if (counts[i] != 0) {
+      entries[num_entries].index = i;
+      entries[num_entries].count = counts[i];
+      num_entries++;
+    }
+  }
+  qsort(entries, num_entries, sizeof(BytecodeProfileEntry),
+        CompareBytecodeProfileEntries);
+  return num_entries;
+}
+
+void Interpreter::PrintBytecodeProfile() const {
+  const intptr_t kMaxPrintedEntries = 40;
+  BytecodeProfileEntry* entries =
+      new BytecodeProfileEntry[kNumOpcodes * kNumOpcodes];
+
+  uint64_t total = 0;
+  for (intptr_t i = 0; i < kNumOpcodes; i++) {
+    total += bytecode_counts_[i];
+  }
+  if (total == 0) {
+    delete[] entries;
+    return;
+  }
+  OS::PrintErr("Bytecode profile: %" Pu64 " instructions executed\n", total);
+
+  intptr_t num_entries =
+      SortBytecodeCounts(bytecode_counts_, kNumOpcodes, entries);
+  for (intptr_t i = 0; i < Utils::Minimum(num_entries, kMaxPrintedEntries);
+       i++) {
+    const auto op = static_cast<KernelBytecode::Opcode>(entries[i].index);
+    OS::PrintErr("  %12" Pu64 " %5.2f%%  %s\n", entries[i].count,
+                 100.0 * entries[i].count / total, KernelBytecode::NameOf(op));
+  }
+
+  OS::PrintErr("Most frequent pairs of adjacent bytecodes:\n");
+  num_entries = SortBytecodeCounts(bytecode_pair_counts_,
+                                   kNumOpcodes * kNumOpcodes, entries);
+  for (intptr_t i = 0; i < Utils::Minimum(num_entries, kMaxPrintedEntries);
+       i++) {
+    const auto first =
+        static_cast<KernelBytecode::Opcode>(entries[i].index / kNumOpcodes);
+    const auto second =
+        static_cast<KernelBytecode::Opcode>(entries[i].index % kNumOpcodes);
+    OS::PrintErr("  %12" Pu64 " %5.2f%%  %s + %s\n", entries[i].count,
+                 100.0 * entries[i].count / total,
+                 KernelBytecode::NameOf(first), KernelBytecode::NameOf(second));
+  }
+  delete[] entries;
+}
+
 #endif  // defined(DEBUG)
 
 // Calls into the Dart runtime are based on this interface.
@@ -625,6 +757,116 @@ DART_NOINLINE bool Interpreter::InvokeCompiled(Thread* thread,
   return true;
 }
 
+#if defined(TARGET_ARCH_X64)
+// Number of extra slots reserved for compiled locals which do not exist in
+// the interpreted frame (exception, stack trace, scratch and arguments
+// descriptor variables). Unused slots are harmless, since they only push the
+// stack pointer of the OSR frame further down.
+static const intptr_t kOsrExtraLocals = 4;
+
+// Replaces the interpreted frame [*FP], which is at a loop back edge with an
+// empty expression stack, with a frame of [code], optimized code compiled for
+// on-stack replacement, and runs the function to completion. The interpreted
+// frame is popped, so that exceptions from the OSR code are handled as if
+// they were thrown by the call in the caller of the frame. On success, the
+// frame is relinked to its caller and the result is left at [**SP], so that
+// it can be returned like with ReturnTOS.
+DART_NOINLINE bool Interpreter::InvokeOsrCode(Thread* thread,
+                                              RawCode* code,
+                                              RawObject*** FP,
+                                              RawObject*** SP) {
+  RawObject** const fp = *FP;
+  RawObject** const caller_fp = SavedCallerFP(fp);
+  const KBCInstr* const caller_pc = SavedCallerPC(fp);
+  const intptr_t argc = RawFunction::PackedNumFixedParameters::decode(
+      FrameFunction(fp)->ptr()->packed_fields_);
+  const intptr_t num_locals = *SP - fp + 1;
+#if defined(DEBUG)
+  if (IsTracingExecution()) {
+    THR_Print("%" Pu64 " ", icount_);
+    THR_Print("invoking OSR code for %s\n",
+              Function::Handle(FrameFunction(fp)).ToFullyQualifiedCString());
+  }
+#endif
+
+  // Move the state of the frame into the layout expected by the
+  // InvokeDartCodeFromBytecode stub, overwriting the frame itself:
+  //   | Smi argc | arguments | Smi number of slots | locals | extra locals |
+  // The buffer only holds Smis and objects, and the exit frame follows it
+  // directly, so the GC sees it as part of the caller's frame during the call.
+  // The buffer ends at most kOsrExtraLocals + 2 slots above the expression
+  // stack, which is well within the slack above overflow_stack_limit().
+  RawObject** args = FrameArguments(fp, argc);
+  for (intptr_t i = argc - 1; i >= 0; i--) {
+    args[i + 1] = args[i];
+  }
+  args[0] = Smi::New(argc);
+  RawObject** slots = args + argc + 1;
+  ASSERT(slots < fp);
+  for (intptr_t i = 0; i < num_locals; i++) {
+    slots[i + 1] = fp[i];
+  }
+  for (intptr_t i = 0; i < kOsrExtraLocals; i++) {
+    slots[num_locals + i + 1] = Object::null();
+  }
+  slots[0] = Smi::New(num_locals + kOsrExtraLocals);
+  RawObject** exit_frame = slots + num_locals + kOsrExtraLocals + 1;
+
+  typedef RawObject* (*invokestub)(RawCode * code, RawArray * argdesc,
+                                   RawObject * *arg0, Thread * thread);
+  invokestub volatile entrypoint = reinterpret_cast<invokestub>(
+      StubCode::InvokeDartCodeFromBytecode().EntryPoint());
+  RawObject* volatile result;
+  Exit(thread, caller_fp, exit_frame, caller_pc);
+  {
+    InterpreterSetjmpBuffer buffer(this);
+    if (!setjmp(buffer.buffer_)) {
+      // A null arguments descriptor selects the OSR entry of the stub.
+      result = entrypoint(code, Array::null(), args, thread);
+      ASSERT(thread->vm_tag() == VMTag::kDartInterpretedTagId);
+      ASSERT(thread->execution_state() == Thread::kThreadInGenerated);
+      Unexit(thread);
+    } else {
+      return false;
+    }
+  }
+
+  if (result->IsHeapObject()) {
+    const intptr_t result_cid = result->GetClassId();
+    if (result_cid == kUnhandledExceptionCid) {
+      args[0] = UnhandledException::RawCast(result)->ptr()->exception_;
+      args[1] = UnhandledException::RawCast(result)->ptr()->stacktrace_;
+      args[2] = 0;  // Space for result.
+      Exit(thread, caller_fp, args + 3, caller_pc);
+      NativeArguments native_args(thread, 2, args, args + 2);
+      if (!InvokeRuntime(thread, this, DRT_ReThrow, native_args)) {
+        return false;
+      }
+      UNREACHABLE();
+    }
+    if (RawObject::IsErrorClassId(result_cid)) {
+      // Unwind to entry frame.
+      fp_ = caller_fp;
+      pc_ = caller_pc;
+      while (!IsEntryFrameMarker(pc_)) {
+        pc_ = SavedCallerPC(fp_);
+        fp_ = SavedCallerFP(fp_);
+      }
+      special_[KernelBytecode::kExceptionSpecialIndex] = result;
+      return false;
+    }
+  }
+
+  // Relink the frame to its caller to return the result from it.
+  fp[kKBCSavedCallerFpSlotFromFp] = reinterpret_cast<RawObject*>(caller_fp);
+  fp[kKBCSavedCallerPcSlotFromFp] =
+      reinterpret_cast<RawObject*>(reinterpret_cast<uword>(caller_pc));
+  *SP = fp;
+  **SP = result;
+  return true;
+}
+#endif  // defined(TARGET_ARCH_X64)
+
 DART_FORCE_INLINE bool Interpreter::InvokeBytecode(Thread* thread,
                                                    RawFunction* function,
                                                    RawObject** call_base,
@@ -746,8 +988,9 @@ DART_FORCE_INLINE bool Interpreter::InterfaceCall(Thread* thread,
   intptr_t receiver_cid =
       InterpreterHelpers::GetClassId(call_base[receiver_idx]);
 
+  LookupCache* lookup_cache = thread->isolate()->interpreter_lookup_cache();
   RawFunction* target;
-  if (UNLIKELY(!lookup_cache_.Lookup(receiver_cid, target_name, &target))) {
+  if (UNLIKELY(!lookup_cache->Lookup(receiver_cid, target_name, &target))) {
     // Table lookup miss.
     top[0] = 0;  // Clean up slot as it may be visited by GC.
     top[1] = call_base[receiver_idx];
@@ -767,7 +1010,7 @@ DART_FORCE_INLINE bool Interpreter::InterfaceCall(Thread* thread,
     target_name = static_cast<RawString*>(top[2]);
     argdesc_ = static_cast<RawArray*>(top[3]);
     ASSERT(target->IsFunction());
-    lookup_cache_.Insert(receiver_cid, target_name, target);
+    lookup_cache->Insert(receiver_cid, target_name, target);
   }
 
   top[0] = target;
@@ -870,7 +1113,7 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall2(Thread* thread,
 // Note:
 // All macro helpers are intended to be used only inside Interpreter::Call.
 
-// Counts and prints executed bytecode instructions (in DEBUG mode).
+// Counts, profiles and prints executed bytecode instructions (in DEBUG mode).
 #if defined(DEBUG)
 #define TRACE_INSTRUCTION                                                      \
   if (IsTracingExecution()) {                                                  \
@@ -879,6 +1122,9 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall2(Thread* thread,
   if (IsWritingTraceFile()) {                                                  \
     WriteInstructionToTrace(pc);                                               \
   }                                                                            \
+  if (bytecode_counts_ != NULL) {                                              \
+    CountInstruction(pc);                                                      \
+  }                                                                            \
   icount_++;
 #else
 #define TRACE_INSTRUCTION
@@ -908,6 +1154,52 @@ DART_FORCE_INLINE bool Interpreter::InstanceCall2(Thread* thread,
 // Load target of a jump instruction into PC.
 #define LOAD_JUMP_TARGET() pc = rT
 
+// Superinstructions.
+//
+// Bytecode is executed directly from the kernel binary, which may be mapped
+// read-only, and is also read by the bytecode flow graph builder, the
+// disassembler and the debugger. So frequent sequences of instructions are
+// not rewritten into new opcodes. Instead, the handler of the first
+// instruction of a sequence checks the opcode of the next instruction and,
+// if it matches, executes it inline: intermediate values stay in registers
+// instead of going through the expression stack, and the indirect dispatch
+// of the second instruction is saved. The fused instruction is still counted
+// and traced. Sequences were picked with --interpreter_bytecode_profile.
+//
+// Executes the next instruction inline if it is a JumpIfTrue or JumpIfFalse,
+// consuming the boolean value of [condition] without materializing it on the
+// expression stack. Falls through otherwise.
+#define FUSED_JUMP_IF(condition)                                               \
+  switch (*pc) {                                                               \
+    case KernelBytecode::kJumpIfTrue:                                          \
+    case KernelBytecode::kJumpIfTrue_Wide:                                     \
+      op = *pc;                                                                \
+      TRACE_INSTRUCTION                                                        \
+      SP -= 1;                                                                 \
+      pc = (condition) ? pc + KernelBytecode::DecodeT(pc)                      \
+                       : KernelBytecode::Next(pc);                             \
+      DISPATCH();                                                              \
+    case KernelBytecode::kJumpIfFalse:                                         \
+    case KernelBytecode::kJumpIfFalse_Wide:                                    \
+      op = *pc;                                                                \
+      TRACE_INSTRUCTION                                                        \
+      SP -= 1;                                                                 \
+      pc = (condition) ? KernelBytecode::Next(pc)                              \
+                       : pc + KernelBytecode::DecodeT(pc);                     \
+      DISPATCH();                                                              \
+    default:                                                                   \
+      break;                                                                   \
+  }
+
+// Jumps directly to the handler of the next instruction if it is [Name],
+// replacing the indirect dispatch with a well predicted conditional branch.
+#define DISPATCH_IF_NEXT(Name)                                                 \
+  if (*pc == KernelBytecode::k##Name) {                                        \
+    op = *pc;                                                                  \
+    TRACE_INSTRUCTION                                                          \
+    goto bc##Name;                                                             \
+  }
+
 #define BYTECODE_ENTRY_LABEL(Name) bc##Name:
 #define BYTECODE_WIDE_ENTRY_LABEL(Name) bc##Name##_Wide:
 #define BYTECODE_IMPL_LABEL(Name) bc##Name##Impl:
@@ -1779,7 +2071,33 @@ SwitchDispatch:
       Exit(thread, FP, SP + 3, pc);
       NativeArguments native_args(thread, 1, SP + 2, SP + 1);
       INVOKE_RUNTIME(DRT_OptimizeInvokedFunction, native_args);
+      function = FrameFunction(FP);
     }
+#if defined(TARGET_ARCH_X64)
+    // Once the function is compiled and hot enough to be optimized, replace
+    // the interpreted frame with optimized code at loop back edges.
+    if (UNLIKELY((rA > 0) &&
+                 (counter >= FLAG_optimization_counter_threshold) &&
+                 Function::HasCode(function) && thread->isolate()->use_osr())) {
+      RawBytecode* bytecode = InterpreterHelpers::FrameBytecode(FP);
+      const intptr_t pc_offset =
+          reinterpret_cast<uword>(pc) - bytecode->ptr()->instructions_ -
+          KernelBytecode::kInstructionSize[KernelBytecode::kCheckStack];
+      SP[1] = null_value;  // OSR code result.
+      SP[2] = function;
+      SP[3] = Smi::New(pc_offset);
+      SP[4] = Smi::New(SP - FP + 1);
+      Exit(thread, FP, SP + 5, pc);
+      NativeArguments native_args(thread, 3, SP + 2, SP + 1);
+      INVOKE_RUNTIME(DRT_CompileInterpreterOsrCode, native_args);
+      if (SP[1] != null_value) {
+        if (!InvokeOsrCode(thread, Code::RawCast(SP[1]), &FP, &SP)) {
+          HANDLE_EXCEPTION;
+        }
+        goto ReturnFromOsrCode;
+      }
+    }
+#endif  // defined(TARGET_ARCH_X64)
     DISPATCH();
   }
 
@@ -1894,6 +2212,7 @@ SwitchDispatch:
   {
     BYTECODE(PushConstant, D);
     *++SP = LOAD_CONSTANT(rD);
+    DISPATCH_IF_NEXT(DirectCall);
     DISPATCH();
   }
 
@@ -1923,6 +2242,18 @@ SwitchDispatch:
 
   {
     BYTECODE(Push, X);
+    if (*pc == KernelBytecode::kLoadFieldTOS) {
+      // Push + LoadFieldTOS, e.g. loading the context of a closure in its
+      // prologue: the instance is not reloaded from the expression stack.
+      RawInstance* instance = static_cast<RawInstance*>(FP[rX]);
+      op = *pc;
+      TRACE_INSTRUCTION
+      const uword offset_in_words = static_cast<uword>(Smi::Value(
+          RAW_CAST(Smi, LOAD_CONSTANT(KernelBytecode::DecodeD(pc)))));
+      pc = KernelBytecode::Next(pc);
+      *++SP = reinterpret_cast<RawObject**>(instance->ptr())[offset_in_words];
+      DISPATCH();
+    }
     *++SP = FP[rX];
     DISPATCH();
   }
@@ -2238,6 +2569,9 @@ SwitchDispatch:
 
     BYTECODE(ReturnTOS, 0);
     DEBUG_CHECK;
+#if defined(TARGET_ARCH_X64)
+  ReturnFromOsrCode:
+#endif
     result = *SP;
     // Restore caller PC.
     pc = SavedCallerPC(FP);
@@ -2728,7 +3062,9 @@ SwitchDispatch:
 
   {
     BYTECODE(EqualsNull, 0);
-    SP[0] = (SP[0] == null_value) ? true_value : false_value;
+    const bool is_null = (SP[0] == null_value);
+    FUSED_JUMP_IF(is_null);
+    SP[0] = is_null ? true_value : false_value;
     DISPATCH();
   }
 
@@ -2874,16 +3210,19 @@ SwitchDispatch:
   {
     BYTECODE(CompareIntEq, 0);
     SP -= 1;
+    bool result;
     if (SP[0] == SP[1]) {
-      SP[0] = true_value;
+      result = true;
     } else if (!SP[0]->IsHeapObject() || !SP[1]->IsHeapObject() ||
                (SP[0] == null_value) || (SP[1] == null_value)) {
-      SP[0] = false_value;
+      result = false;
     } else {
       int64_t a = Integer::GetInt64Value(RAW_CAST(Integer, SP[0]));
       int64_t b = Integer::GetInt64Value(RAW_CAST(Integer, SP[1]));
-      SP[0] = (a == b) ? true_value : false_value;
+      result = (a == b);
     }
+    FUSED_JUMP_IF(result);
+    SP[0] = result ? true_value : false_value;
     DISPATCH();
   }
 
@@ -2892,6 +3231,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_INT64(a, SP[0], Symbols::RAngleBracket());
     UNBOX_INT64(b, SP[1], Symbols::RAngleBracket());
+    FUSED_JUMP_IF(a > b);
     SP[0] = (a > b) ? true_value : false_value;
     DISPATCH();
   }
@@ -2901,6 +3241,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_INT64(a, SP[0], Symbols::LAngleBracket());
     UNBOX_INT64(b, SP[1], Symbols::LAngleBracket());
+    FUSED_JUMP_IF(a < b);
     SP[0] = (a < b) ? true_value : false_value;
     DISPATCH();
   }
@@ -2910,6 +3251,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_INT64(a, SP[0], Symbols::GreaterEqualOperator());
     UNBOX_INT64(b, SP[1], Symbols::GreaterEqualOperator());
+    FUSED_JUMP_IF(a >= b);
     SP[0] = (a >= b) ? true_value : false_value;
     DISPATCH();
   }
@@ -2919,6 +3261,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_INT64(a, SP[0], Symbols::LessEqualOperator());
     UNBOX_INT64(b, SP[1], Symbols::LessEqualOperator());
+    FUSED_JUMP_IF(a <= b);
     SP[0] = (a <= b) ? true_value : false_value;
     DISPATCH();
   }
@@ -2974,13 +3317,16 @@ SwitchDispatch:
   {
     BYTECODE(CompareDoubleEq, 0);
     SP -= 1;
+    bool result;
     if ((SP[0] == null_value) || (SP[1] == null_value)) {
-      SP[0] = (SP[0] == SP[1]) ? true_value : false_value;
+      result = (SP[0] == SP[1]);
     } else {
       double a = Double::RawCast(SP[0])->ptr()->value_;
       double b = Double::RawCast(SP[1])->ptr()->value_;
-      SP[0] = (a == b) ? true_value : false_value;
+      result = (a == b);
     }
+    FUSED_JUMP_IF(result);
+    SP[0] = result ? true_value : false_value;
     DISPATCH();
   }
 
@@ -2989,6 +3335,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_DOUBLE(a, SP[0], Symbols::RAngleBracket());
     UNBOX_DOUBLE(b, SP[1], Symbols::RAngleBracket());
+    FUSED_JUMP_IF(a > b);
     SP[0] = (a > b) ? true_value : false_value;
     DISPATCH();
   }
@@ -2998,6 +3345,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_DOUBLE(a, SP[0], Symbols::LAngleBracket());
     UNBOX_DOUBLE(b, SP[1], Symbols::LAngleBracket());
+    FUSED_JUMP_IF(a < b);
     SP[0] = (a < b) ? true_value : false_value;
     DISPATCH();
   }
@@ -3007,6 +3355,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_DOUBLE(a, SP[0], Symbols::GreaterEqualOperator());
     UNBOX_DOUBLE(b, SP[1], Symbols::GreaterEqualOperator());
+    FUSED_JUMP_IF(a >= b);
     SP[0] = (a >= b) ? true_value : false_value;
     DISPATCH();
   }
@@ -3016,6 +3365,7 @@ SwitchDispatch:
     SP -= 1;
     UNBOX_DOUBLE(a, SP[0], Symbols::LessEqualOperator());
     UNBOX_DOUBLE(b, SP[1], Symbols::LessEqualOperator());
+    FUSED_JUMP_IF(a <= b);
     SP[0] = (a <= b) ? true_value : false_value;
     DISPATCH();
   }
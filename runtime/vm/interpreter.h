@@ -22,6 +22,7 @@ class Array;
 class RawICData;
 class RawImmutableArray;
 class RawArray;
+class RawCode;
 class RawObjectPool;
 class RawFunction;
 class RawString;
@@ -29,22 +30,35 @@ class RawSubtypeTestCache;
 class RawTypeArguments;
 class ObjectPointerVisitor;
 
-class LookupCache : public ValueObject {
+// Cache of the targets of interface calls in interpreted code, keyed on the
+// receiver class id and the target name. There is one cache per isolate.
+//
+// The cache is set-associative with kAssociativity ways per set and least
+// recently used replacement, so that megamorphic call sites on a few hot
+// names do not keep evicting each other as in a direct-mapped table.
+class LookupCache {
  public:
-  LookupCache() {
-    ASSERT(Utils::IsPowerOfTwo(sizeof(Entry)));
-    ASSERT(Utils::IsPowerOfTwo(sizeof(kNumEntries)));
-    Clear();
-  }
+  // [num_entries] is rounded up to a power of two, and to at least one set.
+  explicit LookupCache(intptr_t num_entries);
+  ~LookupCache();
 
   void Clear();
   bool Lookup(intptr_t receiver_cid,
               RawString* function_name,
-              RawFunction** target) const;
+              RawFunction** target);
   void Insert(intptr_t receiver_cid,
               RawString* function_name,
               RawFunction* target);
 
+  intptr_t num_entries() const { return (set_mask_ + 1) * kAssociativity; }
+
+  // Number of lookups which found or did not find their target. These are
+  // not reset when the cache is cleared, and reported as isolate metrics.
+  int64_t num_hits() const { return num_hits_; }
+  int64_t num_misses() const { return num_misses_; }
+
+  static const intptr_t kAssociativity = 4;
+
  private:
   struct Entry {
     intptr_t receiver_cid;
@@ -53,10 +67,18 @@ class LookupCache : public ValueObject {
     intptr_t padding;
   };
 
-  static const intptr_t kNumEntries = 1024;
-  static const intptr_t kTableMask = kNumEntries - 1;
+  struct Set {
+    Entry ways[kAssociativity];
+  };
+
+  Set* SetFor(intptr_t receiver_cid, RawString* function_name) const;
+
+  Set* sets_;
+  uword set_mask_;
+  int64_t num_hits_;
+  int64_t num_misses_;
 
-  Entry entries_[kNumEntries];
+  DISALLOW_COPY_AND_ASSIGN(LookupCache);
 };
 
 // Interpreter intrinsic handler. It is invoked on entry to the intrinsified
@@ -120,7 +142,6 @@ class Interpreter {
   void Unexit(Thread* thread);
 
   void VisitObjectPointers(ObjectPointerVisitor* visitor);
-  void MajorGC() { lookup_cache_.Clear(); }
 
 #ifndef PRODUCT
   void set_is_debugging(bool value) { is_debugging_ = value; }
@@ -144,8 +165,6 @@ class Interpreter {
                        // call instruction and the function entry.
   RawObject* special_[KernelBytecode::kSpecialIndexCount];
 
-  LookupCache lookup_cache_;
-
   void Exit(Thread* thread,
             RawObject** base,
             RawObject** exit_frame,
@@ -174,6 +193,13 @@ class Interpreter {
                       RawObject*** FP,
                       RawObject*** SP);
 
+#if defined(TARGET_ARCH_X64)
+  bool InvokeOsrCode(Thread* thread,
+                     RawCode* code,
+                     RawObject*** FP,
+                     RawObject*** SP);
+#endif
+
   void InlineCacheMiss(int checked_args,
                        Thread* thread,
                        RawICData* icdata,
@@ -279,6 +305,16 @@ class Interpreter {
       kTraceBufferSizeInBytes / sizeof(KBCInstr);
   KBCInstr* trace_buffer_;
   intptr_t trace_buffer_idx_;
+
+  // Counts executed instructions and pairs of adjacent instructions
+  // executed one after the other (--interpreter_bytecode_profile).
+  void CountInstruction(const KBCInstr* pc);
+  void PrintBytecodeProfile() const;
+
+  static const intptr_t kNumOpcodes = 1 << (kBitsPerByte * sizeof(KBCInstr));
+  uint64_t* bytecode_counts_;
+  uint64_t* bytecode_pair_counts_;
+  const KBCInstr* last_counted_pc_;
 #endif  // defined(DEBUG)
 
   // Longjmp support for exceptions.
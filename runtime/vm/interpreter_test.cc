@@ -0,0 +1,87 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/assert.h"
+
+#include "vm/globals.h"
+#if !defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/interpreter.h"
+#include "vm/object.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static RawFunction* NewFunction(Thread* thread, const char* name) {
+  const String& function_name = String::Handle(Symbols::New(thread, name));
+  const Class& owner_class = Class::Handle(
+      Class::New(Library::Handle(), Symbols::TopLevel(), Script::Handle(),
+                 TokenPosition::kNoSource));
+  return Function::New(function_name, RawFunction::kRegularFunction, false,
+                       false, false, false, false, owner_class,
+                       TokenPosition::kNoSource);
+}
+
+ISOLATE_UNIT_TEST_CASE(Interpreter_LookupCache) {
+  const Function& foo = Function::Handle(NewFunction(thread, "foo"));
+  const Function& bar = Function::Handle(NewFunction(thread, "bar"));
+  const String& name = String::Handle(foo.name());
+
+  LookupCache cache(100);
+  EXPECT_EQ(128, cache.num_entries());
+
+  RawFunction* target = NULL;
+  EXPECT(!cache.Lookup(kSmiCid, name.raw(), &target));
+  cache.Insert(kSmiCid, name.raw(), foo.raw());
+  cache.Insert(kMintCid, name.raw(), bar.raw());
+  EXPECT(cache.Lookup(kSmiCid, name.raw(), &target));
+  EXPECT(target == foo.raw());
+  EXPECT(cache.Lookup(kMintCid, name.raw(), &target));
+  EXPECT(target == bar.raw());
+  EXPECT(!cache.Lookup(kDoubleCid, name.raw(), &target));
+  EXPECT_EQ(2, cache.num_hits());
+  EXPECT_EQ(2, cache.num_misses());
+
+  // Clearing the cache on major GC keeps the statistics.
+  cache.Clear();
+  EXPECT(!cache.Lookup(kSmiCid, name.raw(), &target));
+  EXPECT_EQ(2, cache.num_hits());
+  EXPECT_EQ(3, cache.num_misses());
+}
+
+ISOLATE_UNIT_TEST_CASE(Interpreter_LookupCacheAssociativity) {
+  const Function& foo = Function::Handle(NewFunction(thread, "foo"));
+  const String& name = String::Handle(foo.name());
+
+  // With a single set, all entries compete for the same ways.
+  LookupCache cache(1);
+  EXPECT_EQ(LookupCache::kAssociativity, cache.num_entries());
+  const intptr_t kFirstCid = kNumPredefinedCids;
+  for (intptr_t i = 0; i < LookupCache::kAssociativity; i++) {
+    cache.Insert(kFirstCid + i, name.raw(), foo.raw());
+  }
+  RawFunction* target = NULL;
+  for (intptr_t i = 0; i < LookupCache::kAssociativity; i++) {
+    EXPECT(cache.Lookup(kFirstCid + i, name.raw(), &target));
+  }
+
+  // The first entry is now the least recently used one and is evicted.
+  cache.Insert(kFirstCid - 1, name.raw(), foo.raw());
+  EXPECT(!cache.Lookup(kFirstCid, name.raw(), &target));
+  for (intptr_t i = 1; i < LookupCache::kAssociativity; i++) {
+    EXPECT(cache.Lookup(kFirstCid + i, name.raw(), &target));
+  }
+  EXPECT(cache.Lookup(kFirstCid - 1, name.raw(), &target));
+
+  // A hit makes an entry the most recently used one.
+  EXPECT(cache.Lookup(kFirstCid + 1, name.raw(), &target));
+  cache.Insert(kFirstCid, name.raw(), foo.raw());
+  EXPECT(!cache.Lookup(kFirstCid + 2, name.raw(), &target));
+  EXPECT(cache.Lookup(kFirstCid + 1, name.raw(), &target));
+}
+
+}  // namespace dart
+
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
@@ -943,6 +943,11 @@ Isolate::~Isolate() {
   delete reverse_pc_lookup_cache_;
   reverse_pc_lookup_cache_ = nullptr;
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  delete interpreter_lookup_cache_;
+  interpreter_lookup_cache_ = nullptr;
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
   if (FLAG_enable_interpreter) {
     delete background_compiler_;
     background_compiler_ = nullptr;
@@ -74,6 +74,7 @@ class RawFloat32x4;
 class RawInt32x4;
 class RawUserTag;
 class ReversePcLookupCache;
+class LookupCache;
 class SafepointHandler;
 class SampleBuffer;
 class SendPort;
@@ -734,6 +735,19 @@ class Isolate : public BaseIsolate {
     reverse_pc_lookup_cache_ = table;
   }
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  // Returns the interface call target cache of the interpreter, which is
+  // shared by all interpreters running code of this isolate.
+  LookupCache* interpreter_lookup_cache() const {
+    return interpreter_lookup_cache_;
+  }
+
+  void set_interpreter_lookup_cache(LookupCache* cache) {
+    ASSERT(interpreter_lookup_cache_ == nullptr);
+    interpreter_lookup_cache_ = cache;
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
   // Isolate-specific flag handling.
   static void FlagsInitialize(Dart_IsolateFlags* api_flags);
   void FlagsCopyTo(Dart_IsolateFlags* api_flags) const;
@@ -1056,6 +1070,10 @@ class Isolate : public BaseIsolate {
 
   ReversePcLookupCache* reverse_pc_lookup_cache_ = nullptr;
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  LookupCache* interpreter_lookup_cache_ = nullptr;
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
   static Dart_IsolateCreateCallback create_callback_;
   static Dart_IsolateShutdownCallback shutdown_callback_;
   static Dart_IsolateCleanupCallback cleanup_callback_;
@@ -1083,6 +1101,7 @@ class Isolate : public BaseIsolate {
   friend class GCMarker;  // VisitObjectPointers
   friend class SafepointHandler;
   friend class ObjectGraph;  // VisitObjectPointers
+  friend class PageSpace;    // threads_lock
   friend class Scavenger;    // VisitObjectPointers
   friend class HeapIterationScope;  // VisitObjectPointers
   friend class ServiceIsolate;
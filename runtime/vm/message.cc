@@ -89,59 +89,101 @@ const char* Message::PriorityAsString(Priority priority) {
 MessageQueue::MessageQueue() {
   head_ = NULL;
   tail_ = NULL;
+  incoming_ = NULL;
 }
 
 MessageQueue::~MessageQueue() {
   // Ensure that all pending messages have been released.
   Clear();
   ASSERT(head_ == NULL);
+  ASSERT(incoming_ == NULL);
 }
 
-void MessageQueue::Enqueue(std::unique_ptr<Message> msg0, bool before_events) {
+bool MessageQueue::Enqueue(std::unique_ptr<Message> msg0, bool before_events) {
   // TODO(mdempsky): Use unique_ptr internally?
   Message* msg = msg0.release();
 
   // Make sure messages are not reused.
   ASSERT(msg->next_ == NULL);
+  if (!before_events) {
+    Message* old_incoming = AtomicOperations::LoadRelaxed(&incoming_);
+    while (true) {
+      msg->next_ = old_incoming;
+      Message* result = AtomicOperations::CompareAndSwapPointer(
+          &incoming_, old_incoming, msg);
+      if (result == old_incoming) {
+        return old_incoming == NULL;
+      }
+      old_incoming = result;
+    }
+  }
+
+  // Messages posted earlier must stay ahead of the ones we skip over.
+  MoveIncoming();
+  ASSERT(msg->dest_port() == Message::kIllegalPort);
   if (head_ == NULL) {
     // Only element in the queue.
     ASSERT(tail_ == NULL);
     head_ = msg;
     tail_ = msg;
+  } else if (head_->dest_port() != Message::kIllegalPort) {
+    msg->next_ = head_;
+    head_ = msg;
   } else {
-    ASSERT(tail_ != NULL);
-    if (!before_events) {
-      // Append at the tail.
-      tail_->next_ = msg;
-      tail_ = msg;
-    } else {
-      ASSERT(msg->dest_port() == Message::kIllegalPort);
-      if (head_->dest_port() != Message::kIllegalPort) {
-        msg->next_ = head_;
-        head_ = msg;
-      } else {
-        Message* cur = head_;
-        while (cur->next_ != NULL) {
-          if (cur->next_->dest_port() != Message::kIllegalPort) {
-            // Splice in the new message at the break.
-            msg->next_ = cur->next_;
-            cur->next_ = msg;
-            return;
-          }
-          cur = cur->next_;
-        }
-        // All pending messages are isolate library control messages. Append at
-        // the tail.
-        ASSERT(tail_ == cur);
-        ASSERT(tail_->dest_port() == Message::kIllegalPort);
-        tail_->next_ = msg;
-        tail_ = msg;
+    Message* cur = head_;
+    while (cur->next_ != NULL) {
+      if (cur->next_->dest_port() != Message::kIllegalPort) {
+        // Splice in the new message at the break.
+        msg->next_ = cur->next_;
+        cur->next_ = msg;
+        return true;
       }
+      cur = cur->next_;
     }
+    // All pending messages are isolate library control messages. Append at
+    // the tail.
+    ASSERT(tail_ == cur);
+    ASSERT(tail_->dest_port() == Message::kIllegalPort);
+    tail_->next_ = msg;
+    tail_ = msg;
+  }
+  return true;
+}
+
+void MessageQueue::MoveIncoming() const {
+  Message* incoming = AtomicOperations::LoadRelaxed(&incoming_);
+  if (incoming == NULL) {
+    return;
+  }
+  // Only the consumer clears incoming_, so it stays non-NULL until we do.
+  Message* result;
+  while ((result = AtomicOperations::CompareAndSwapPointer(
+              &incoming_, incoming, static_cast<Message*>(NULL))) !=
+         incoming) {
+    incoming = result;
+  }
+
+  // Reverse the list into posting order.
+  Message* first = NULL;
+  Message* last = incoming;
+  while (incoming != NULL) {
+    Message* next = incoming->next_;
+    incoming->next_ = first;
+    first = incoming;
+    incoming = next;
   }
+  if (head_ == NULL) {
+    head_ = first;
+  } else {
+    tail_->next_ = first;
+  }
+  tail_ = last;
 }
 
 std::unique_ptr<Message> MessageQueue::Dequeue() {
+  if (head_ == nullptr) {
+    MoveIncoming();
+  }
   Message* result = head_;
   if (result != nullptr) {
     head_ = result->next_;
@@ -158,6 +200,7 @@ std::unique_ptr<Message> MessageQueue::Dequeue() {
 }
 
 void MessageQueue::Clear() {
+  MoveIncoming();
   std::unique_ptr<Message> cur(head_);
   head_ = nullptr;
   tail_ = nullptr;
@@ -178,6 +221,7 @@ MessageQueue::Iterator::~Iterator() {}
 
 void MessageQueue::Iterator::Reset(const MessageQueue* queue) {
   ASSERT(queue != NULL);
+  queue->MoveIncoming();
   next_ = queue->head_;
 }
 
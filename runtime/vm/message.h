@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "platform/assert.h"
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 #include "vm/finalizable_data.h"
 #include "vm/globals.h"
@@ -117,18 +118,36 @@ class Message {
 };
 
 // There is a message queue per isolate.
+// A queue with many producers and a single consumer.
+//
+// Enqueue without before_events may be called by any thread at any time. All
+// other operations must be serialized by the consumer, e.g. by holding the
+// MessageHandler's monitor. Producers push onto a lock-free list, which the
+// consumer moves to its own list in one step when it runs out of messages.
 class MessageQueue {
  public:
   MessageQueue();
   ~MessageQueue();
 
-  void Enqueue(std::unique_ptr<Message> msg, bool before_events);
+  // Returns true if no other message was waiting to be taken by the consumer.
+  // The caller is then responsible for making sure the consumer notices the
+  // new message. Messages enqueued with before_events are inserted directly
+  // into the consumer's list, so this requires the consumer's lock.
+  bool Enqueue(std::unique_ptr<Message> msg, bool before_events);
 
   // Gets the next message from the message queue or NULL if no
   // message is available.  This function will not block.
   std::unique_ptr<Message> Dequeue();
 
-  bool IsEmpty() { return head_ == NULL; }
+  bool IsEmpty() const {
+    return (head_ == NULL) &&
+           (AtomicOperations::LoadRelaxed(&incoming_) == NULL);
+  }
+
+  // Returns true if the consumer holds no messages it has already taken from
+  // the producers. Messages still on the producers' list are not counted: the
+  // producer of the first of them makes sure the consumer notices them.
+  bool IsDrained() const { return head_ == NULL; }
 
   // Clear all messages from the message queue.
   void Clear();
@@ -159,8 +178,14 @@ class MessageQueue {
   void PrintJSON(JSONStream* stream);
 
  private:
-  Message* head_;
-  Message* tail_;
+  // Moves the messages posted by producers to the end of the consumer's list.
+  void MoveIncoming() const;
+
+  // The consumer's list, in posting order.
+  mutable Message* head_;
+  mutable Message* tail_;
+  // Messages posted since the consumer last looked, in reverse order.
+  mutable Message* incoming_;
 
   DISALLOW_COPY_AND_ASSIGN(MessageQueue);
 };
@@ -120,36 +120,43 @@ void MessageHandler::Run(ThreadPool* pool,
 
 void MessageHandler::PostMessage(std::unique_ptr<Message> message,
                                  bool before_events) {
-  Message::Priority saved_priority;
+  if (FLAG_trace_isolates) {
+    Isolate* source_isolate = Isolate::Current();
+    if (source_isolate) {
+      OS::PrintErr(
+          "[>] Posting message:\n"
+          "\tlen:        %" Pd "\n\tsource:     (%" Pd64
+          ") %s\n\tdest:       %s\n"
+          "\tdest_port:  %" Pd64 "\n",
+          message->Size(), static_cast<int64_t>(source_isolate->main_port()),
+          source_isolate->name(), name(), message->dest_port());
+    } else {
+      OS::PrintErr(
+          "[>] Posting message:\n"
+          "\tlen:        %" Pd
+          "\n\tsource:     <native code>\n"
+          "\tdest:       %s\n"
+          "\tdest_port:  %" Pd64 "\n",
+          message->Size(), name(), message->dest_port());
+    }
+  }
 
-  {
-    MonitorLocker ml(&monitor_);
-    if (FLAG_trace_isolates) {
-      Isolate* source_isolate = Isolate::Current();
-      if (source_isolate) {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd "\n\tsource:     (%" Pd64
-            ") %s\n\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), static_cast<int64_t>(source_isolate->main_port()),
-            source_isolate->name(), name(), message->dest_port());
-      } else {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd
-            "\n\tsource:     <native code>\n"
-            "\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), name(), message->dest_port());
-      }
+  Message::Priority saved_priority = message->priority();
+  MessageQueue* queue = message->IsOOB() ? oob_queue_ : queue_;
+  if (!before_events) {
+    if (!queue->Enqueue(std::move(message), false)) {
+      // The handler has not yet taken an earlier message, and whoever posted
+      // that one has made sure it will be woken or scheduled. It will see
+      // this message too, so we can skip the monitor.
+      MessageNotify(saved_priority);
+      return;
     }
+  }
 
-    saved_priority = message->priority();
-    if (message->IsOOB()) {
-      oob_queue_->Enqueue(std::move(message), before_events);
-    } else {
-      queue_->Enqueue(std::move(message), before_events);
+  {
+    MonitorLocker ml(&monitor_);
+    if (before_events) {
+      queue->Enqueue(std::move(message), true);
     }
     if (paused_for_messages_) {
       ml.Notify();
@@ -370,7 +377,7 @@ void MessageHandler::TaskCallback() {
       status = HandleMessages(&ml, false, false);
       if (ShouldPauseOnStart(status)) {
         // Still paused.
-        ASSERT(oob_queue_->IsEmpty());
+        ASSERT(oob_queue_->IsDrained());
         task_running_ = false;  // No task in queue.
         return;
       } else {
@@ -381,7 +388,7 @@ void MessageHandler::TaskCallback() {
       status = HandleMessages(&ml, false, false);
       if (ShouldPauseOnExit(status)) {
         // Still paused.
-        ASSERT(oob_queue_->IsEmpty());
+        ASSERT(oob_queue_->IsDrained());
         task_running_ = false;  // No task in queue.
         return;
       } else {
@@ -435,7 +442,7 @@ void MessageHandler::TaskCallback() {
         status = HandleMessages(&ml, false, false);
         if (ShouldPauseOnExit(status)) {
           // Still paused.
-          ASSERT(oob_queue_->IsEmpty());
+          ASSERT(oob_queue_->IsDrained());
           task_running_ = false;  // No task in queue.
           return;
         } else {
@@ -468,7 +475,11 @@ void MessageHandler::TaskCallback() {
 
     // Clear task_running_ last.  This allows other tasks to potentially start
     // for this message handler.
-    ASSERT(oob_queue_->IsEmpty());
+    //
+    // OOB messages may have been posted since they were last handled, but
+    // none is left unscheduled: the sender of the first of them is waiting
+    // for the monitor and will start a new task once task_running_ is clear.
+    ASSERT(oob_queue_->IsDrained());
     task_running_ = false;
   }
 
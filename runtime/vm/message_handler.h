@@ -170,6 +170,9 @@ class MessageHandler {
   // Posts a message on this handler's message queue.
   // If before_events is true, then the message is enqueued before any pending
   // events, but after any pending isolate library events.
+  //
+  // Only takes the monitor when the handler may need to be woken or scheduled,
+  // i.e. when no other posted message is still waiting to be handled.
   void PostMessage(std::unique_ptr<Message> message,
                    bool before_events = false);
 
@@ -241,7 +244,9 @@ class MessageHandler {
                                bool allow_normal_messages,
                                bool allow_multiple_normal_messages);
 
-  Monitor monitor_;  // Protects all fields in MessageHandler.
+  // Protects all fields in MessageHandler. The queues are only protected on the
+  // consumer side, see MessageQueue.
+  Monitor monitor_;
   MessageQueue* queue_;
   MessageQueue* oob_queue_;
   // This flag is not thread safe and can only reliably be accessed on a single
@@ -4,6 +4,7 @@
 
 #include "vm/message.h"
 #include "platform/assert.h"
+#include "vm/thread_pool.h"
 #include "vm/unit_test.h"
 
 namespace dart {
@@ -140,4 +141,73 @@ TEST_CASE(MessageQueue_Clear) {
   EXPECT(queue.IsEmpty());
 }
 
+class EnqueueTask : public ThreadPool::Task {
+ public:
+  EnqueueTask(MessageQueue* queue, Dart_Port port, intptr_t count)
+      : queue_(queue), port_(port), count_(count) {}
+
+  virtual void Run() {
+    for (intptr_t i = 0; i < count_; i++) {
+      queue_->Enqueue(Message::New(port_, Smi::New(i),
+                                   Message::kNormalPriority),
+                      false);
+    }
+  }
+
+ private:
+  MessageQueue* queue_;
+  Dart_Port port_;
+  intptr_t count_;
+};
+
+TEST_CASE(MessageQueue_ConcurrentEnqueue) {
+  const intptr_t kProducers = 4;
+  const intptr_t kMessagesPerProducer = 10000;
+  MessageQueue queue;
+  intptr_t next[kProducers + 1] = {0};
+  intptr_t received = 0;
+  {
+    ThreadPool pool;
+    for (intptr_t i = 1; i <= kProducers; i++) {
+      pool.Run<EnqueueTask>(&queue, i, kMessagesPerProducer);
+    }
+    // Take messages while they are being posted. Each producer's messages
+    // must arrive in the order it posted them.
+    while (received < kProducers * kMessagesPerProducer) {
+      std::unique_ptr<Message> msg = queue.Dequeue();
+      if (msg == nullptr) {
+        continue;
+      }
+      Dart_Port port = msg->dest_port();
+      EXPECT(port >= 1 && port <= kProducers);
+      EXPECT_EQ(next[port], Smi::Value(static_cast<RawSmi*>(msg->raw_obj())));
+      next[port]++;
+      received++;
+    }
+  }
+  EXPECT(queue.IsEmpty());
+  for (intptr_t i = 1; i <= kProducers; i++) {
+    EXPECT_EQ(kMessagesPerProducer, next[i]);
+  }
+}
+
+TEST_CASE(MessageQueue_IsDrained) {
+  MessageQueue queue;
+  EXPECT(queue.IsDrained());
+  Dart_Port port = 1;
+  queue.Enqueue(Message::New(port, Smi::New(1), Message::kOOBPriority), false);
+  queue.Enqueue(Message::New(port, Smi::New(2), Message::kOOBPriority), false);
+  // Messages not yet taken by the consumer are not counted.
+  EXPECT(queue.IsDrained());
+  EXPECT(!queue.IsEmpty());
+
+  std::unique_ptr<Message> msg = queue.Dequeue();
+  EXPECT(msg != nullptr);
+  EXPECT(!queue.IsDrained());
+  msg = queue.Dequeue();
+  EXPECT(msg != nullptr);
+  EXPECT(queue.IsDrained());
+  EXPECT(queue.IsEmpty());
+}
+
 }  // namespace dart
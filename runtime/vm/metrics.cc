@@ -6,6 +6,7 @@
 
 #include "vm/metrics.h"
 
+#include "vm/interpreter.h"
 #include "vm/isolate.h"
 #include "vm/json_stream.h"
 #include "vm/log.h"
@@ -291,6 +292,24 @@ int64_t MetricHeapUsed::Value() const {
          isolate()->heap()->UsedInWords(Heap::kOld) * kWordSize;
 }
 
+int64_t MetricInterpreterLookupCacheHits::Value() const {
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  LookupCache* cache = isolate()->interpreter_lookup_cache();
+  return (cache == NULL) ? 0 : cache->num_hits();
+#else
+  return 0;
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+}
+
+int64_t MetricInterpreterLookupCacheMisses::Value() const {
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  LookupCache* cache = isolate()->interpreter_lookup_cache();
+  return (cache == NULL) ? 0 : cache->num_misses();
+#else
+  return 0;
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+}
+
 int64_t MetricIsolateCount::Value() const {
   return Isolate::IsolateListLength();
 }
@@ -27,7 +27,11 @@ class JSONStream;
   V(MetricHeapUsed, HeapGlobalUsed, "heap.global.used", kByte)                 \
   V(MaxMetric, HeapGlobalUsedMax, "heap.global.used.max", kByte)               \
   V(Metric, RunnableLatency, "isolate.runnable.latency", kMicrosecond)         \
-  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)
+  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)                  \
+  V(MetricInterpreterLookupCacheHits, InterpreterLookupCacheHits,              \
+    "interpreter.lookup_cache.hits", kCounter)                                 \
+  V(MetricInterpreterLookupCacheMisses, InterpreterLookupCacheMisses,          \
+    "interpreter.lookup_cache.misses", kCounter)
 
 #define VM_METRIC_LIST(V)                                                      \
   V(MetricIsolateCount, IsolateCount, "vm.isolate.count", kCounter)            \
@@ -160,6 +164,16 @@ class MetricHeapNewExternal : public Metric {
   virtual int64_t Value() const;
 };
 
+class MetricInterpreterLookupCacheHits : public Metric {
+ protected:
+  virtual int64_t Value() const;
+};
+
+class MetricInterpreterLookupCacheMisses : public Metric {
+ protected:
+  virtual int64_t Value() const;
+};
+
 class MetricIsolateCount : public Metric {
  protected:
   virtual int64_t Value() const;
@@ -2184,7 +2184,7 @@ RawObject* Object::Allocate(intptr_t cls_id, intptr_t size, Heap::Space space) {
     // this object before the stores that initialize its slots), and helps the
     // collection to finish sooner.
     raw_obj->SetMarkBitUnsynchronized();
-    heap->old_space()->AllocateBlack(size);
+    heap->old_space()->AllocateBlack(address, size);
   }
   return raw_obj;
 }
@@ -230,6 +230,10 @@ class OSThread : public BaseThread {
   static ThreadId ThreadIdFromIntPtr(intptr_t id);
   static bool Compare(ThreadId a, ThreadId b);
 
+  // Binds the calling thread to the given processor. Returns false if this is
+  // not supported.
+  static bool SetCurrentThreadAffinity(intptr_t cpu);
+
   // This function can be called only once per OSThread, and should only be
   // called when the retunred id will eventually be passed to OSThread::Join().
   static ThreadJoinId GetCurrentThreadJoinId(OSThread* thread);
@@ -9,6 +9,7 @@
 #include "vm/os_thread.h"
 
 #include <errno.h>     // NOLINT
+#include <sched.h>     // NOLINT
 #include <sys/time.h>  // NOLINT
 
 #include "platform/address_sanitizer.h"
@@ -214,6 +215,13 @@ void OSThread::Join(ThreadJoinId id) {
   ASSERT(result == 0);
 }
 
+bool OSThread::SetCurrentThreadAffinity(intptr_t cpu) {
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+}
+
 intptr_t OSThread::ThreadIdToIntPtr(ThreadId id) {
   ASSERT(sizeof(id) == sizeof(intptr_t));
   return static_cast<intptr_t>(id);
@@ -197,6 +197,11 @@ void OSThread::Join(ThreadJoinId id) {
   ASSERT(result == 0);
 }
 
+bool OSThread::SetCurrentThreadAffinity(intptr_t cpu) {
+  // Not supported.
+  return false;
+}
+
 intptr_t OSThread::ThreadIdToIntPtr(ThreadId id) {
   ASSERT(sizeof(id) == sizeof(intptr_t));
   return static_cast<intptr_t>(id);
@@ -193,6 +193,11 @@ void OSThread::Join(ThreadJoinId id) {
   ASSERT(result == 0);
 }
 
+bool OSThread::SetCurrentThreadAffinity(intptr_t cpu) {
+  // Mac OS only supports affinity hints, which do not name processors.
+  return false;
+}
+
 intptr_t OSThread::ThreadIdToIntPtr(ThreadId id) {
   ASSERT(sizeof(id) == sizeof(intptr_t));
   return reinterpret_cast<intptr_t>(id);
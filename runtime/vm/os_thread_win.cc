@@ -143,6 +143,14 @@ void OSThread::Join(ThreadJoinId id) {
   ASSERT(res == WAIT_OBJECT_0);
 }
 
+bool OSThread::SetCurrentThreadAffinity(intptr_t cpu) {
+  if (cpu >= static_cast<intptr_t>(sizeof(DWORD_PTR) * kBitsPerByte)) {
+    return false;
+  }
+  DWORD_PTR mask = static_cast<DWORD_PTR>(1) << cpu;
+  return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+}
+
 intptr_t OSThread::ThreadIdToIntPtr(ThreadId id) {
   ASSERT(sizeof(id) <= sizeof(intptr_t));
   return static_cast<intptr_t>(id);
@@ -365,6 +365,14 @@ class RawObject {
   intptr_t HeapSize() const {
     ASSERT(IsHeapObject());
     uint32_t tags = ptr()->tags_;
+    return HeapSize(tags);
+  }
+
+  // As above, but uses the given tags instead of reading the header. Used by
+  // the parallel scavenger, where another worker may overwrite the header with
+  // a forwarding pointer at any time.
+  intptr_t HeapSize(uint32_t tags) const {
+    ASSERT(IsHeapObject());
     intptr_t result = SizeTag::decode(tags);
     if (result != 0) {
 #if defined(DEBUG)
@@ -373,7 +381,7 @@ class RawObject {
       // leading to inconsistency between HeapSizeFromClass() and
       // SizeTag::decode(tags). We are working around it by reloading tags_ and
       // recomputing size from tags.
-      const intptr_t size_from_class = HeapSizeFromClass();
+      const intptr_t size_from_class = HeapSizeFromClass(tags);
       if ((result > size_from_class) && (GetClassId() == kArrayCid) &&
           (ptr()->tags_ != tags)) {
         result = SizeTag::decode(ptr()->tags_);
@@ -382,7 +390,7 @@ class RawObject {
 #endif
       return result;
     }
-    result = HeapSizeFromClass();
+    result = HeapSizeFromClass(tags);
     ASSERT(result > SizeTag::kMaxSizeTag);
     return result;
   }
@@ -502,7 +510,8 @@ class RawObject {
   intptr_t VisitPointersPredefined(ObjectPointerVisitor* visitor,
                                    intptr_t class_id);
 
-  intptr_t HeapSizeFromClass() const;
+  intptr_t HeapSizeFromClass() const { return HeapSizeFromClass(ptr()->tags_); }
+  intptr_t HeapSizeFromClass(uint32_t tags) const;
 
   intptr_t GetClassId() const {
     uint32_t tags = ptr()->tags_;
@@ -666,6 +675,7 @@ class RawObject {
   friend class Array;
   friend class Become;  // GetClassId
   friend class CompactorTask;  // GetClassId
+  friend class GCCompactor;  // GetClassId
   friend class ByteBuffer;
   friend class CidRewriteVisitor;
   friend class Closure;
@@ -696,7 +706,8 @@ class RawObject {
   friend class RawTypedData;
   friend class RawTypedDataView;
   friend class Scavenger;
-  friend class ScavengerVisitor;
+  template <bool>
+  friend class ScavengerVisitorBase;
   friend class SizeExcludingClassVisitor;  // GetClassId
   friend class InstanceAccumulator;        // GetClassId
   friend class RetainingPathVisitor;       // GetClassId
@@ -2244,7 +2255,8 @@ class RawTypedDataView : public RawTypedDataBase {
   friend class ObjectPoolSerializationCluster;
   friend class RawObjectPool;
   friend class GCCompactor;
-  friend class ScavengerVisitor;
+  template <bool>
+  friend class ScavengerVisitorBase;
   friend class SnapshotReader;
 };
 
@@ -2530,7 +2542,8 @@ class RawWeakProperty : public RawInstance {
   template <bool>
   friend class MarkingVisitorBase;
   friend class Scavenger;
-  friend class ScavengerVisitor;
+  template <bool>
+  friend class ScavengerVisitorBase;
 };
 
 // MirrorReferences are used by mirrors to hold reflectees that are VM
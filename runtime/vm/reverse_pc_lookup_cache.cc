@@ -5,6 +5,7 @@
 #include "vm/reverse_pc_lookup_cache.h"
 
 #include "vm/isolate.h"
+#include "vm/lockers.h"
 
 namespace dart {
 
@@ -20,6 +21,63 @@ static uword EndPcFromCode(const RawCode* code) {
   return Instructions::PayloadStart(instr) + Instructions::Size(instr);
 }
 
+// A pc_array together with the isolates using it.
+class ReversePcLookupCache::SharedPcArray {
+ public:
+  SharedPcArray(uint32_t* pc_array,
+                intptr_t length,
+                uword first_absolute_pc,
+                SharedPcArray* next)
+      : pc_array_(pc_array),
+        length_(length),
+        first_absolute_pc_(first_absolute_pc),
+        ref_count_(1),
+        next_(next) {}
+  ~SharedPcArray() { delete[] pc_array_; }
+
+  // Protects the list of shared arrays.
+  static Mutex* mutex_;
+  static SharedPcArray* list_;
+
+  uint32_t* pc_array_;
+  intptr_t length_;
+  uword first_absolute_pc_;
+  intptr_t ref_count_;
+  SharedPcArray* next_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(SharedPcArray);
+};
+
+Mutex* ReversePcLookupCache::SharedPcArray::mutex_ = nullptr;
+ReversePcLookupCache::SharedPcArray*
+    ReversePcLookupCache::SharedPcArray::list_ = nullptr;
+
+void ReversePcLookupCache::Init() {
+  ASSERT(SharedPcArray::mutex_ == nullptr);
+  SharedPcArray::mutex_ = new Mutex();
+}
+
+void ReversePcLookupCache::Cleanup() {
+  // All isolates are gone, so all arrays have been released.
+  ASSERT(SharedPcArray::list_ == nullptr);
+  delete SharedPcArray::mutex_;
+  SharedPcArray::mutex_ = nullptr;
+}
+
+void ReversePcLookupCache::ReleasePcArray(const uint32_t* pc_array) {
+  MutexLocker ml(SharedPcArray::mutex_);
+  SharedPcArray** link = &SharedPcArray::list_;
+  while ((*link)->pc_array_ != pc_array) {
+    link = &(*link)->next_;
+  }
+  SharedPcArray* shared = *link;
+  if (--shared->ref_count_ == 0) {
+    *link = shared->next_;
+    delete shared;
+  }
+}
+
 void ReversePcLookupCache::BuildAndAttachToIsolate(Isolate* isolate) {
   auto object_store = isolate->object_store();
   auto& array = Array::Handle(object_store->code_order_table());
@@ -33,19 +91,35 @@ void ReversePcLookupCache::BuildAndAttachToIsolate(Isolate* isolate) {
       const uword end =
           EndPcFromCode(reinterpret_cast<RawCode*>(array.At(length - 1)));
 
-      auto pc_array = new uint32_t[length];
-      for (intptr_t i = 0; i < length; i++) {
-        const auto end_pc =
-            EndPcFromCode(reinterpret_cast<RawCode*>(array.At(i)));
-        pc_array[i] = end_pc - begin;
+      MutexLocker ml(SharedPcArray::mutex_);
+      // Isolates loaded from the same snapshot see the same instructions at
+      // the same addresses.
+      SharedPcArray* shared = SharedPcArray::list_;
+      while ((shared != nullptr) && ((shared->first_absolute_pc_ != begin) ||
+                                     (shared->length_ != length))) {
+        shared = shared->next_;
       }
+      if (shared != nullptr) {
+        shared->ref_count_++;
+      } else {
+        auto pc_array = new uint32_t[length];
+        for (intptr_t i = 0; i < length; i++) {
+          const auto end_pc =
+              EndPcFromCode(reinterpret_cast<RawCode*>(array.At(i)));
+          pc_array[i] = end_pc - begin;
+        }
 #if defined(DEBUG)
-      for (intptr_t i = 1; i < length; i++) {
-        ASSERT(pc_array[i - 1] <= pc_array[i]);
-      }
+        for (intptr_t i = 1; i < length; i++) {
+          ASSERT(pc_array[i - 1] <= pc_array[i]);
+        }
 #endif  // defined(DEBUG)
-      auto cache =
-          new ReversePcLookupCache(isolate, pc_array, length, begin, end);
+        shared =
+            new SharedPcArray(pc_array, length, begin, SharedPcArray::list_);
+        SharedPcArray::list_ = shared;
+      }
+      ASSERT(shared->pc_array_[length - 1] == end - begin);
+      auto cache = new ReversePcLookupCache(isolate, shared->pc_array_, length,
+                                            begin, end);
       isolate->set_reverse_pc_lookup_cache(cache);
     }
   }
@@ -40,11 +40,14 @@ class Isolate;
 // The lookup will then do a binary search in pc_array. The index can then be
 // used in the `code_order_table` of the object store.
 //
+// The pc_array only depends on the instructions image, so all isolates loaded
+// from the same snapshot share one copy of it.
+//
 // WARNING: This class cannot do memory allocation or handle allocation!
 class ReversePcLookupCache {
  public:
   ReversePcLookupCache(Isolate* isolate,
-                       uint32_t* pc_array,
+                       const uint32_t* pc_array,
                        intptr_t length,
                        uword first_absolute_pc,
                        uword last_absolute_pc)
@@ -53,7 +56,10 @@ class ReversePcLookupCache {
         length_(length),
         first_absolute_pc_(first_absolute_pc),
         last_absolute_pc_(last_absolute_pc) {}
-  ~ReversePcLookupCache() { delete[] pc_array_; }
+  ~ReversePcLookupCache() { ReleasePcArray(pc_array_); }
+
+  static void Init();
+  static void Cleanup();
 
   // Builds a [ReversePcLookupCache] and attaches it to the isolate (if
   // `code_order_table` is non-`null`).
@@ -98,8 +104,12 @@ class ReversePcLookupCache {
   }
 
  private:
+  class SharedPcArray;
+
+  static void ReleasePcArray(const uint32_t* pc_array);
+
   Isolate* isolate_;
-  uint32_t* pc_array_;
+  const uint32_t* pc_array_;
   intptr_t length_;
   uword first_absolute_pc_;
   uword last_absolute_pc_;
@@ -112,6 +122,9 @@ class ReversePcLookupCache {
   ReversePcLookupCache() {}
   ~ReversePcLookupCache() {}
 
+  static void Init() {}
+  static void Cleanup() {}
+
   static void BuildAndAttachToIsolate(Isolate* isolate) {}
 
   inline bool Contains(uword pc) { return false; }
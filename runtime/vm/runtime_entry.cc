@@ -229,6 +229,16 @@ DEFINE_RUNTIME_ENTRY(IntegerDivisionByZeroException, 0) {
   Exceptions::ThrowByType(Exceptions::kIntegerDivisionByZeroException, args);
 }
 
+// Space for objects allocated by the slow paths of the allocation stubs.
+static Heap::Space SpaceForAllocation(Thread* thread, intptr_t cid) {
+#if !defined(PRODUCT)
+  if (thread->isolate()->class_table()->ShouldPretenure(cid)) {
+    return Heap::kOld;
+  }
+#endif  // !defined(PRODUCT)
+  return Heap::kNew;
+}
+
 // Allocation of a fixed length array of given element type.
 // This runtime entry is never called for allocating a List of a generic type,
 // because a prior run time call instantiates the element type if necessary.
@@ -248,7 +258,8 @@ DEFINE_RUNTIME_ENTRY(AllocateArray, 2) {
   if (length.IsSmi()) {
     const intptr_t len = Smi::Cast(length).Value();
     if (Array::IsValidLength(len)) {
-      const Array& array = Array::Handle(zone, Array::New(len, Heap::kNew));
+      const Array& array = Array::Handle(
+          zone, Array::New(len, SpaceForAllocation(thread, kArrayCid)));
       arguments.SetReturn(array);
       TypeArguments& element_type =
           TypeArguments::CheckedHandle(zone, arguments.ArgAt(1));
@@ -285,8 +296,8 @@ static TokenPosition GetCallerLocation() {
 // Return value: newly allocated object.
 DEFINE_RUNTIME_ENTRY(AllocateObject, 2) {
   const Class& cls = Class::CheckedHandle(zone, arguments.ArgAt(0));
-  const Instance& instance =
-      Instance::Handle(zone, Instance::New(cls, Heap::kNew));
+  const Instance& instance = Instance::Handle(
+      zone, Instance::New(cls, SpaceForAllocation(thread, cls.id())));
 
   arguments.SetReturn(instance);
   if (cls.NumTypeArguments() == 0) {
@@ -452,8 +463,9 @@ DEFINE_RUNTIME_ENTRY(AllocateSubtypeTestCache, 0) {
 // Return value: newly allocated context.
 DEFINE_RUNTIME_ENTRY(AllocateContext, 1) {
   const Smi& num_variables = Smi::CheckedHandle(zone, arguments.ArgAt(0));
-  const Context& context =
-      Context::Handle(zone, Context::New(num_variables.Value()));
+  const Context& context = Context::Handle(
+      zone, Context::New(num_variables.Value(),
+                         SpaceForAllocation(thread, kContextCid)));
   arguments.SetReturn(context);
 }
 
@@ -2372,6 +2384,118 @@ DEFINE_RUNTIME_ENTRY(OptimizeInvokedFunction, 1) {
 #endif  // !DART_PRECOMPILED_RUNTIME
 }
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+// Returns the deopt id of the loop stack check in the unoptimized code of
+// [function] which corresponds to the CheckStack bytecode at [pc_offset], or
+// DeoptId::kNone if it cannot be identified unambiguously. Both are matched
+// by the source position of the loop.
+static intptr_t GetDeoptIdForInterpreterOsr(Zone* zone,
+                                            const Function& function,
+                                            intptr_t pc_offset) {
+  const Bytecode& bytecode = Bytecode::Handle(zone, function.bytecode());
+  const TokenPosition token_pos =
+      bytecode.GetTokenIndexOfPC(bytecode.PayloadStart() + pc_offset);
+  if (!token_pos.IsReal()) {
+    return DeoptId::kNone;
+  }
+  const Code& code = Code::Handle(zone, function.unoptimized_code());
+  const PcDescriptors& descriptors =
+      PcDescriptors::Handle(zone, code.pc_descriptors());
+  intptr_t osr_id = DeoptId::kNone;
+  PcDescriptors::Iterator osr_entries(descriptors, RawPcDescriptors::kOsrEntry);
+  while (osr_entries.MoveNext()) {
+    // The OSR entry itself has no source position, but the runtime call of
+    // the stack check recorded under the same deopt id does.
+    PcDescriptors::Iterator calls(descriptors, RawPcDescriptors::kOther);
+    while (calls.MoveNext()) {
+      if ((calls.DeoptId() == osr_entries.DeoptId()) &&
+          (calls.TokenPos() == token_pos)) {
+        if ((osr_id != DeoptId::kNone) && (osr_id != calls.DeoptId())) {
+          return DeoptId::kNone;
+        }
+        osr_id = calls.DeoptId();
+        break;
+      }
+    }
+  }
+  return osr_id;
+}
+
+// Returns the number of locals of the frame of an interpreted [function],
+// or -1 if the function has optional parameters.
+static intptr_t GetInterpreterFrameSize(Zone* zone, const Function& function) {
+  const Bytecode& bytecode = Bytecode::Handle(zone, function.bytecode());
+  const KBCInstr* entry =
+      reinterpret_cast<const KBCInstr*>(bytecode.PayloadStart());
+  switch (KernelBytecode::DecodeOpcode(entry)) {
+    case KernelBytecode::kEntry:
+    case KernelBytecode::kEntry_Wide:
+      return KernelBytecode::DecodeD(entry);
+    case KernelBytecode::kEntryFixed:
+    case KernelBytecode::kEntryFixed_Wide:
+      return KernelBytecode::DecodeE(entry);
+    default:
+      return -1;
+  }
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+// Compiles optimized code to replace an interpreted frame at a loop back edge.
+// Arg0: function of the interpreted frame.
+// Arg1: bytecode offset of the CheckStack instruction of the loop.
+// Arg2: number of locals and expression stack values in the frame.
+// Return value: OSR code, or null if the frame cannot be replaced.
+DEFINE_RUNTIME_ENTRY(CompileInterpreterOsrCode, 3) {
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  const Function& function = Function::CheckedHandle(zone, arguments.ArgAt(0));
+  const intptr_t pc_offset =
+      Smi::CheckedHandle(zone, arguments.ArgAt(1)).Value();
+  const intptr_t num_frame_values =
+      Smi::CheckedHandle(zone, arguments.ArgAt(2)).Value();
+  ASSERT(isolate->use_osr());
+  arguments.SetReturn(Object::null_object());
+
+  // Don't try again before another round of loop iterations, whether or not
+  // the frame can be replaced.
+  function.SetUsageCounter(0);
+
+  // The compiled frame is set up from the locals of the interpreted frame,
+  // so its expression stack must be empty. The arguments descriptor is not
+  // available to the OSR code, so functions which need it are excluded.
+  if (!function.HasBytecode() || !function.HasCode() ||
+      function.is_intrinsic() || function.HasOptionalParameters() ||
+      function.IsGeneric() || function.IsClosureFunction() ||
+      (GetInterpreterFrameSize(zone, function) != num_frame_values) ||
+      !Compiler::CanOptimizeFunction(thread, function)) {
+    return;
+  }
+  const Error& error =
+      Error::Handle(zone, Compiler::EnsureUnoptimizedCode(thread, function));
+  ThrowIfError(error);
+  if (!function.ShouldCompilerOptimize()) {
+    return;
+  }
+
+  const intptr_t osr_id =
+      GetDeoptIdForInterpreterOsr(zone, function, pc_offset);
+  if (osr_id == DeoptId::kNone) {
+    return;
+  }
+  if (FLAG_trace_osr) {
+    OS::PrintErr("Attempting OSR from interpreter for %s at id=%" Pd "\n",
+                 function.ToFullyQualifiedCString(), osr_id);
+  }
+  const Object& result = Object::Handle(
+      zone, Compiler::CompileOptimizedFunction(thread, function, osr_id));
+  ThrowIfError(result);
+  if (!result.IsNull()) {
+    arguments.SetReturn(result);
+  }
+#else
+  UNREACHABLE();
+#endif  // !DART_PRECOMPILED_RUNTIME
+}
+
 // The caller must be a static call in a Dart frame, or an entry frame.
 // Patch static call to point to valid code's entry point.
 DEFINE_RUNTIME_ENTRY(FixCallersTarget, 0) {
@@ -37,6 +37,7 @@ namespace dart {
   V(InvokeNoSuchMethod)                                                        \
   V(MegamorphicCacheMissHandler)                                               \
   V(OptimizeInvokedFunction)                                                   \
+  V(CompileInterpreterOsrCode)                                                 \
   V(TraceICCall)                                                               \
   V(PatchStaticCall)                                                           \
   V(RangeError)                                                                \
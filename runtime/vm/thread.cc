@@ -80,6 +80,8 @@ Thread::Thread(Isolate* isolate)
       ffi_callback_code_(GrowableObjectArray::null()),
       task_kind_(kUnknownTask),
       dart_stream_(NULL),
+      old_top_(0),
+      old_end_(0),
       thread_lock_(),
       api_reusable_scope_(NULL),
       api_top_scope_(NULL),
@@ -282,6 +284,10 @@ const char* Thread::TaskKindToCString(TaskKind kind) {
       return "kSweeperTask";
     case kMarkerTask:
       return "kMarkerTask";
+    case kCompactorTask:
+      return "kCompactorTask";
+    case kScavengerTask:
+      return "kScavengerTask";
     default:
       UNREACHABLE();
       return "";
@@ -386,6 +392,7 @@ void Thread::ExitIsolateAsHelper(bool bypass_safepoint) {
   }
   thread->StoreBufferRelease();
   thread->heap()->AbandonRemainingTLAB(thread);
+  thread->heap()->old_space()->AbandonTLAB(thread);
   Isolate* isolate = thread->isolate();
   ASSERT(isolate != NULL);
   const bool kIsNotMutatorThread = false;
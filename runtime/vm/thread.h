@@ -218,6 +218,7 @@ class Thread : public ThreadState {
     kMarkerTask = 0x4,
     kSweeperTask = 0x8,
     kCompactorTask = 0x10,
+    kScavengerTask = 0x20,
   };
   // Converts a TaskKind to its corresponding C-String name.
   static const char* TaskKindToCString(TaskKind kind);
@@ -462,6 +463,15 @@ class Thread : public ThreadState {
 
   bool HasActiveTLAB() { return end_ > 0; }
 
+  // The old-space allocation buffer of this thread, carved in bulk from the
+  // data freelist so that small old-space allocations do not contend on the
+  // freelist lock. Not accessed from generated code.
+  uword old_top() const { return old_top_; }
+  uword old_end() const { return old_end_; }
+  void set_old_top(uword value) { old_top_ = value; }
+  void set_old_end(uword value) { old_end_ = value; }
+  bool HasActiveOldTLAB() const { return old_end_ > 0; }
+
   static intptr_t top_offset() { return OFFSET_OF(Thread, top_); }
   static intptr_t end_offset() { return OFFSET_OF(Thread, end_); }
 
@@ -883,6 +893,8 @@ class Thread : public ThreadState {
 
   TaskKind task_kind_;
   TimelineStream* dart_stream_;
+  uword old_top_;
+  uword old_end_;
   mutable Monitor thread_lock_;
   ApiLocalScope* api_reusable_scope_;
   ApiLocalScope* api_top_scope_;
@@ -4,9 +4,11 @@
 
 #include "vm/thread_pool.h"
 
+#include "platform/atomic.h"
 #include "vm/dart.h"
 #include "vm/flags.h"
 #include "vm/lockers.h"
+#include "vm/os.h"
 
 namespace dart {
 
@@ -14,6 +16,26 @@ DEFINE_FLAG(int,
             worker_timeout_millis,
             5000,
             "Free workers when they have been idle for this amount of time.");
+DEFINE_FLAG(bool,
+            work_stealing_thread_pool,
+            false,
+            "Run VM tasks on a fixed set of workers with work-stealing "
+            "deques.");
+DEFINE_FLAG(int,
+            thread_pool_workers,
+            0,
+            "Number of workers in the work-stealing thread pool. 0 means one "
+            "per available processor.");
+DEFINE_FLAG(bool,
+            thread_pool_pin_workers,
+            false,
+            "Bind each worker of the work-stealing thread pool to a "
+            "processor.");
+DEFINE_FLAG(int,
+            thread_pool_max_tasks_per_thread,
+            0,
+            "Replace a work-stealing thread pool worker's thread after it has "
+            "run this many tasks. 0 means never.");
 
 ThreadPool::ThreadPool()
     : shutting_down_(false),
@@ -30,6 +52,15 @@ ThreadPool::~ThreadPool() {
   Shutdown();
 }
 
+ThreadPool* ThreadPool::New() {
+  if (FLAG_work_stealing_thread_pool) {
+    return new WorkStealingThreadPool(FLAG_thread_pool_workers,
+                                      FLAG_thread_pool_pin_workers,
+                                      FLAG_thread_pool_max_tasks_per_thread);
+  }
+  return new ThreadPool();
+}
+
 bool ThreadPool::RunImpl(std::unique_ptr<Task> task) {
   Worker* worker = NULL;
   bool new_worker = false;
@@ -482,4 +513,313 @@ void ThreadPool::Worker::Main(uword args) {
   }
 }
 
+// A double-ended queue of tasks. The owning worker pushes and pops at the
+// bottom, all other threads take from the top.
+class WorkStealingThreadPool::TaskDeque {
+ public:
+  TaskDeque()
+      : tasks_(new Task*[kInitialCapacity]),
+        capacity_(kInitialCapacity),
+        top_(0),
+        bottom_(0) {}
+
+  ~TaskDeque() {
+    ASSERT(top_ == bottom_);
+    delete[] tasks_;
+  }
+
+  // May be stale, only used to skip empty deques when stealing.
+  bool IsEmpty() {
+    return AtomicOperations::LoadRelaxed(&bottom_) ==
+           AtomicOperations::LoadRelaxed(&top_);
+  }
+
+  void PushBottom(Task* task) {
+    MutexLocker ml(&mutex_);
+    if (bottom_ - top_ == capacity_) {
+      Grow();
+    }
+    tasks_[bottom_ & (capacity_ - 1)] = task;
+    AtomicOperations::StoreRelease(&bottom_, bottom_ + 1);
+  }
+
+  Task* PopBottom() {
+    MutexLocker ml(&mutex_);
+    if (bottom_ == top_) {
+      return NULL;
+    }
+    AtomicOperations::StoreRelease(&bottom_, bottom_ - 1);
+    return tasks_[bottom_ & (capacity_ - 1)];
+  }
+
+  Task* PopTop() {
+    MutexLocker ml(&mutex_);
+    if (bottom_ == top_) {
+      return NULL;
+    }
+    Task* task = tasks_[top_ & (capacity_ - 1)];
+    AtomicOperations::StoreRelease(&top_, top_ + 1);
+    return task;
+  }
+
+ private:
+  static const intptr_t kInitialCapacity = 64;
+
+  void Grow() {
+    Task** tasks = new Task*[capacity_ * 2];
+    for (intptr_t i = top_; i < bottom_; i++) {
+      tasks[i & (2 * capacity_ - 1)] = tasks_[i & (capacity_ - 1)];
+    }
+    delete[] tasks_;
+    tasks_ = tasks;
+    capacity_ *= 2;
+  }
+
+  Mutex mutex_;
+  Task** tasks_;
+  intptr_t capacity_;
+  // Monotonically increasing, the deque holds tasks_[top_, bottom_).
+  intptr_t top_;
+  intptr_t bottom_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskDeque);
+};
+
+WorkStealingThreadPool::WorkStealingThreadPool(intptr_t num_workers,
+                                               bool pin_workers,
+                                               intptr_t max_tasks_per_thread)
+    : num_workers_(num_workers > 0 ? num_workers
+                                   : OS::NumberOfAvailableProcessors()),
+      pin_workers_(pin_workers),
+      max_tasks_per_thread_(max_tasks_per_thread),
+      deques_(new TaskDeque[num_workers_]),
+      shared_queue_(new TaskDeque()),
+      worker_key_(OSThread::CreateThreadLocal()),
+      pending_(0),
+      threads_(0),
+      busy_(0),
+      sleeping_(0),
+      threads_started_(0),
+      threads_stopped_(0),
+      tasks_stolen_(0),
+      shutting_down_(false) {
+  MonitorLocker ml(&monitor_);
+  for (intptr_t i = 0; i < num_workers_; i++) {
+    StartThreadLocked(i);
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  ASSERT(CurrentWorker() == kNoWorker);
+  {
+    MonitorLocker ml(&monitor_);
+    shutting_down_ = true;
+    ml.NotifyAll();
+    while (threads_ > 0) {
+      ml.Wait();
+    }
+  }
+  for (intptr_t i = 0; i < exited_.length(); i++) {
+    OSThread::Join(exited_[i]);
+  }
+  exited_.Clear();
+
+  // Tasks submitted while the last threads were exiting are never run.
+  Task* task;
+  while ((task = shared_queue_->PopTop()) != NULL) {
+    delete task;
+  }
+  for (intptr_t i = 0; i < num_workers_; i++) {
+    while ((task = deques_[i].PopTop()) != NULL) {
+      delete task;
+    }
+  }
+  delete shared_queue_;
+  delete[] deques_;
+  OSThread::DeleteThreadLocal(worker_key_);
+}
+
+bool WorkStealingThreadPool::RunImpl(std::unique_ptr<Task> task) {
+  if (AtomicOperations::LoadRelaxed(&shutting_down_)) {
+    return false;
+  }
+  const intptr_t worker = CurrentWorker();
+  if (worker != kNoWorker) {
+    deques_[worker].PushBottom(task.release());
+  } else {
+    shared_queue_->PushBottom(task.release());
+  }
+
+  // Pairs with the increment of sleeping_ in Loop: either the sleeping thread
+  // sees the new task or we see the sleeping thread.
+  AtomicOperations::FetchAndIncrement(&pending_);
+  if (AtomicOperations::LoadRelaxed(&sleeping_) > 0) {
+    MonitorLocker ml(&monitor_);
+    ml.Notify();
+  } else if (AtomicOperations::LoadRelaxed(&busy_) >=
+             AtomicOperations::LoadRelaxed(&threads_)) {
+    // Every thread is running a task, and those tasks may be waiting for this
+    // one.
+    MonitorLocker ml(&monitor_);
+    if (!shutting_down_ && (busy_ >= threads_)) {
+      StartThreadLocked(kNoWorker);
+    }
+  }
+  return true;
+}
+
+void WorkStealingThreadPool::StartThreadLocked(intptr_t worker) {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  StartArguments* args = new StartArguments();
+  args->pool = this;
+  args->worker = worker;
+  threads_++;
+  threads_started_++;
+  int result = OSThread::Start("Dart ThreadPool Worker", &Main,
+                               reinterpret_cast<uword>(args));
+  if (result != 0) {
+    FATAL1("Could not start worker thread: result = %d.", result);
+  }
+}
+
+intptr_t WorkStealingThreadPool::CurrentWorker() const {
+  return static_cast<intptr_t>(OSThread::GetThreadLocal(worker_key_)) - 1;
+}
+
+WorkStealingThreadPool::Task* WorkStealingThreadPool::FindTask(
+    intptr_t worker) {
+  Task* task = NULL;
+  if (worker != kNoWorker) {
+    task = deques_[worker].PopBottom();
+  }
+  if (task == NULL) {
+    task = shared_queue_->PopTop();
+  }
+  if (task == NULL) {
+    const intptr_t start = (worker == kNoWorker) ? 0 : worker + 1;
+    for (intptr_t i = 0; i < num_workers_; i++) {
+      TaskDeque* victim = &deques_[(start + i) % num_workers_];
+      if (victim->IsEmpty()) {
+        continue;
+      }
+      task = victim->PopTop();
+      if (task != NULL) {
+        AtomicOperations::IncrementBy(&tasks_stolen_, 1);
+        break;
+      }
+    }
+  }
+  if (task != NULL) {
+    // Count the thread as busy before the task stops being pending, so that
+    // RunImpl never sees neither and skips starting a thread it needs.
+    AtomicOperations::FetchAndIncrement(&busy_);
+    AtomicOperations::FetchAndDecrement(&pending_);
+  }
+  return task;
+}
+
+void WorkStealingThreadPool::ReapExitedThreads() {
+  MallocGrowableArray<ThreadJoinId> exited;
+  {
+    MonitorLocker ml(&monitor_);
+    for (intptr_t i = 0; i < exited_.length(); i++) {
+      exited.Add(exited_[i]);
+    }
+    exited_.Clear();
+  }
+  for (intptr_t i = 0; i < exited.length(); i++) {
+    OSThread::Join(exited[i]);
+  }
+}
+
+void WorkStealingThreadPool::Loop(intptr_t worker) {
+  intptr_t tasks_run = 0;
+  while (true) {
+    Task* task = FindTask(worker);
+    if (task != NULL) {
+      task->Run();
+      ASSERT(Isolate::Current() == NULL);
+      delete task;
+      AtomicOperations::FetchAndDecrement(&busy_);
+
+      tasks_run++;
+      if ((max_tasks_per_thread_ > 0) && (tasks_run >= max_tasks_per_thread_)) {
+        MonitorLocker ml(&monitor_);
+        if (!shutting_down_) {
+          if (worker != kNoWorker) {
+            // Hand the deque over to a fresh thread.
+            StartThreadLocked(worker);
+          }
+          return;
+        }
+      }
+      continue;
+    }
+
+    ReapExitedThreads();
+
+    MonitorLocker ml(&monitor_);
+    AtomicOperations::FetchAndIncrement(&sleeping_);
+    if (AtomicOperations::LoadRelaxed(&pending_) > 0) {
+      AtomicOperations::FetchAndDecrement(&sleeping_);
+      continue;
+    }
+    if (shutting_down_) {
+      AtomicOperations::FetchAndDecrement(&sleeping_);
+      return;
+    }
+    Monitor::WaitResult result;
+    if (worker == kNoWorker) {
+      result = ml.WaitMicros(ComputeTimeout(OS::GetCurrentMonotonicMicros()));
+    } else {
+      result = ml.Wait();
+    }
+    AtomicOperations::FetchAndDecrement(&sleeping_);
+    if ((result == Monitor::kTimedOut) &&
+        (AtomicOperations::LoadRelaxed(&pending_) == 0)) {
+      return;
+    }
+  }
+}
+
+// static
+void WorkStealingThreadPool::Main(uword args) {
+  StartArguments* start = reinterpret_cast<StartArguments*>(args);
+  WorkStealingThreadPool* pool = start->pool;
+  const intptr_t worker = start->worker;
+  delete start;
+
+  OSThread* os_thread = OSThread::Current();
+  ASSERT(os_thread != NULL);
+
+  // Set the thread's stack_base based on the current stack pointer.
+  os_thread->RefineStackBoundsFromSP(OSThread::GetCurrentStackPointer());
+
+  if (worker != kNoWorker) {
+    OSThread::SetThreadLocal(pool->worker_key_, worker + 1);
+    if (pool->pin_workers_) {
+      OSThread::SetCurrentThreadAffinity(worker %
+                                         OS::NumberOfAvailableProcessors());
+    }
+  }
+
+  pool->Loop(worker);
+
+  {
+    MonitorLocker ml(&pool->monitor_);
+    pool->exited_.Add(OSThread::GetCurrentThreadJoinId(os_thread));
+    pool->threads_--;
+    pool->threads_stopped_++;
+    if (pool->shutting_down_) {
+      ml.NotifyAll();
+    }
+  }
+
+  // Call the thread exit hook here to notify the embedder that the
+  // thread pool thread is exiting.
+  if (Dart::thread_exit_callback() != NULL) {
+    (*Dart::thread_exit_callback())();
+  }
+}
+
 }  // namespace dart
@@ -10,6 +10,7 @@
 
 #include "vm/allocation.h"
 #include "vm/globals.h"
+#include "vm/growable_array.h"
 #include "vm/os_thread.h"
 
 namespace dart {
@@ -35,7 +36,10 @@ class ThreadPool {
 
   // Shuts down this thread pool. Causes workers to terminate
   // themselves when they are active again.
-  ~ThreadPool();
+  virtual ~ThreadPool();
+
+  // Creates the kind of pool selected by --work_stealing_thread_pool.
+  static ThreadPool* New();
 
   // Runs a task on the thread pool.
   template <typename T, typename... Args>
@@ -44,10 +48,13 @@ class ThreadPool {
   }
 
   // Some simple stats.
-  uint64_t workers_running() const { return count_running_; }
-  uint64_t workers_idle() const { return count_idle_; }
-  uint64_t workers_started() const { return count_started_; }
-  uint64_t workers_stopped() const { return count_stopped_; }
+  virtual uint64_t workers_running() const { return count_running_; }
+  virtual uint64_t workers_idle() const { return count_idle_; }
+  virtual uint64_t workers_started() const { return count_started_; }
+  virtual uint64_t workers_stopped() const { return count_stopped_; }
+
+ protected:
+  virtual bool RunImpl(std::unique_ptr<Task> task);
 
  private:
   class Worker {
@@ -116,7 +123,6 @@ class ThreadPool {
     DISALLOW_COPY_AND_ASSIGN(JoinList);
   };
 
-  bool RunImpl(std::unique_ptr<Task> task);
   void Shutdown();
 
   // Expensive.  Use only in assertions.
@@ -151,6 +157,95 @@ class ThreadPool {
   DISALLOW_COPY_AND_ASSIGN(ThreadPool);
 };
 
+// A thread pool with a fixed set of workers, each owning a deque of tasks.
+// Tasks submitted by a worker go to the bottom of its own deque, from where it
+// takes them back LIFO. Tasks submitted by other threads go to a shared queue.
+// Workers that run out of tasks steal from the top of other workers' deques
+// before going to sleep.
+//
+// Tasks may block on each other, e.g. GC helpers meeting at a barrier, or run
+// for as long as the VM does, e.g. background compilers. So when a task is
+// submitted while every thread of the pool is busy, an extra thread is started
+// for it. Extra threads exit after being idle for --worker_timeout_millis.
+class WorkStealingThreadPool : public ThreadPool {
+ public:
+  // A num_workers of 0 means one worker per available processor. If
+  // pin_workers is true, each worker is bound to one processor. If
+  // max_tasks_per_thread is positive, a worker's thread is replaced by a fresh
+  // one after running that many tasks.
+  WorkStealingThreadPool(intptr_t num_workers,
+                         bool pin_workers,
+                         intptr_t max_tasks_per_thread);
+
+  // Waits for all threads to exit after they have run the tasks already
+  // queued. Tasks that are queued while the threads exit are deleted without
+  // being run.
+  virtual ~WorkStealingThreadPool();
+
+  intptr_t num_workers() const { return num_workers_; }
+  intptr_t tasks_stolen() const { return tasks_stolen_; }
+
+  virtual uint64_t workers_running() const { return busy_; }
+  virtual uint64_t workers_idle() const { return sleeping_; }
+  virtual uint64_t workers_started() const { return threads_started_; }
+  virtual uint64_t workers_stopped() const { return threads_stopped_; }
+
+ protected:
+  virtual bool RunImpl(std::unique_ptr<Task> task);
+
+ private:
+  class TaskDeque;
+
+  // Index of an extra thread, which has no deque of its own.
+  static const intptr_t kNoWorker = -1;
+
+  struct StartArguments {
+    WorkStealingThreadPool* pool;
+    intptr_t worker;
+  };
+
+  // Starts a thread for the given worker, or an extra thread.
+  void StartThreadLocked(intptr_t worker);
+
+  // The main entry point for the pool's threads.
+  static void Main(uword args);
+  void Loop(intptr_t worker);
+
+  // Returns the worker the current thread runs, or kNoWorker.
+  intptr_t CurrentWorker() const;
+
+  // Takes a task from the worker's own deque, the shared queue or another
+  // worker's deque, and counts the current thread as busy if one is found.
+  Task* FindTask(intptr_t worker);
+
+  // Joins threads that have exited. Must not be called with monitor_ held.
+  void ReapExitedThreads();
+
+  const intptr_t num_workers_;
+  const bool pin_workers_;
+  const intptr_t max_tasks_per_thread_;
+  TaskDeque* deques_;
+  TaskDeque* shared_queue_;
+  ThreadLocalKey worker_key_;
+
+  // Queued tasks not yet taken by a thread.
+  intptr_t pending_;
+  // Live threads, and how many of them are running a task or sleeping.
+  intptr_t threads_;
+  intptr_t busy_;
+  intptr_t sleeping_;
+
+  uint64_t threads_started_;
+  uint64_t threads_stopped_;
+  intptr_t tasks_stolen_;
+
+  Monitor monitor_;
+  bool shutting_down_;                      // Protected by monitor_.
+  MallocGrowableArray<ThreadJoinId> exited_;  // Protected by monitor_.
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingThreadPool);
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_THREAD_POOL_H_
@@ -236,4 +236,137 @@ VM_UNIT_TEST_CASE(ThreadPool_RecursiveSpawn) {
   EXPECT_EQ(kTotalTasks, done);
 }
 
+VM_UNIT_TEST_CASE(WorkStealingThreadPool_RunMany) {
+  // Every task blocks until the main thread releases it, so the pool has to
+  // grow past its two workers for all of them to start.
+  const int kTaskCount = 100;
+  WorkStealingThreadPool thread_pool(2, false, 0);
+  Monitor sync[kTaskCount];
+  bool done[kTaskCount];
+
+  for (int i = 0; i < kTaskCount; i++) {
+    done[i] = true;
+    thread_pool.Run<TestTask>(&sync[i], &done[i]);
+  }
+  for (int i = kTaskCount - 1; i >= 0; i--) {
+    MonitorLocker ml(&sync[i]);
+    done[i] = false;
+    ml.Notify();
+    while (!done[i]) {
+      ml.Wait();
+    }
+    EXPECT(done[i]);
+  }
+}
+
+VM_UNIT_TEST_CASE(WorkStealingThreadPool_WorkerShutdown) {
+  const int kTaskCount = 10;
+  Monitor sync;
+  int slept_count = 0;
+  int started_count = 0;
+
+  ThreadPool* thread_pool = new WorkStealingThreadPool(4, false, 0);
+  for (int i = 0; i < kTaskCount; i++) {
+    thread_pool->Run<SleepTask>(&sync, &started_count, &slept_count, 2);
+  }
+
+  // Kill the thread pool before all the tasks have run. Queued tasks are still
+  // run by the exiting workers.
+  delete thread_pool;
+  thread_pool = NULL;
+
+  MonitorLocker ml(&sync);
+  EXPECT_EQ(kTaskCount, started_count);
+  EXPECT_EQ(kTaskCount, slept_count);
+}
+
+VM_UNIT_TEST_CASE(WorkStealingThreadPool_RecursiveSpawn) {
+  WorkStealingThreadPool thread_pool(4, true, 0);
+  Monitor sync;
+  const int kTotalTasks = 500;
+  int done = 0;
+  thread_pool.Run<SpawnTask>(&thread_pool, &sync, kTotalTasks, kTotalTasks,
+                             &done);
+  {
+    MonitorLocker ml(&sync);
+    while (done < kTotalTasks) {
+      ml.Wait();
+    }
+  }
+  EXPECT_EQ(kTotalTasks, done);
+}
+
+VM_UNIT_TEST_CASE(WorkStealingThreadPool_MaxTasksPerThread) {
+  const int kTotalTasks = 100;
+  Monitor sync;
+  int done = 0;
+  {
+    WorkStealingThreadPool thread_pool(1, false, 10);
+    EXPECT_EQ(1U, thread_pool.workers_started());
+    thread_pool.Run<SpawnTask>(&thread_pool, &sync, kTotalTasks, kTotalTasks,
+                               &done);
+    {
+      MonitorLocker ml(&sync);
+      while (done < kTotalTasks) {
+        ml.Wait();
+      }
+    }
+    // The worker's thread is replaced after every ten tasks.
+    EXPECT_LE(kTotalTasks / 10U, thread_pool.workers_started());
+  }
+  EXPECT_EQ(kTotalTasks, done);
+}
+
+class CountTask : public ThreadPool::Task {
+ public:
+  CountTask(Monitor* sync, intptr_t* count, intptr_t total)
+      : sync_(sync), count_(count), total_(total) {}
+
+  virtual void Run() {
+    if (AtomicOperations::FetchAndIncrement(count_) + 1 == total_) {
+      MonitorLocker ml(sync_);
+      ml.Notify();
+    }
+  }
+
+ private:
+  Monitor* sync_;
+  intptr_t* count_;
+  intptr_t total_;
+};
+
+static int64_t RunCountTasks(ThreadPool* thread_pool, intptr_t total) {
+  Monitor sync;
+  intptr_t count = 0;
+  int64_t start = OS::GetCurrentMonotonicMicros();
+  for (intptr_t i = 0; i < total; i++) {
+    thread_pool->Run<CountTask>(&sync, &count, total);
+  }
+  {
+    MonitorLocker ml(&sync);
+    while (AtomicOperations::LoadRelaxed(&count) < total) {
+      ml.Wait(1);
+    }
+  }
+  return OS::GetCurrentMonotonicMicros() - start;
+}
+
+// Compares how long both pools take to run many tiny tasks.
+VM_UNIT_TEST_CASE(ThreadPool_Throughput) {
+  const intptr_t kTaskCount = 10000;
+  int64_t elapsed;
+  {
+    ThreadPool thread_pool;
+    elapsed = RunCountTasks(&thread_pool, kTaskCount);
+  }
+  OS::PrintErr("ThreadPool: %" Pd " tasks in %" Pd64 " us\n", kTaskCount,
+               elapsed);
+  {
+    WorkStealingThreadPool thread_pool(0, false, 0);
+    elapsed = RunCountTasks(&thread_pool, kTaskCount);
+  }
+  OS::PrintErr("WorkStealingThreadPool: %" Pd " tasks in %" Pd64 " us\n",
+               kTaskCount, elapsed);
+}
+
 }  // namespace dart
@@ -82,6 +82,7 @@ class ThreadRegistry {
   Thread* mutator_thread_;
 
   friend class Isolate;
+  friend class PageSpace;
   friend class SafepointHandler;
   friend class Scavenger;
   DISALLOW_COPY_AND_ASSIGN(ThreadRegistry);
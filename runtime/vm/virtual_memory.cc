@@ -42,4 +42,16 @@ VirtualMemory* VirtualMemory::ForImagePage(void* pointer, uword size) {
   return memory;
 }
 
+VirtualMemory* VirtualMemory::Slice(intptr_t offset, intptr_t size) const {
+  ASSERT(Utils::IsAligned(offset, PageSize()));
+  ASSERT(Utils::IsAligned(size, PageSize()));
+  ASSERT((offset >= 0) && (offset + size <= this->size()));
+  ASSERT(AliasOffset() == 0);
+  MemoryRegion region(reinterpret_cast<void*>(start() + offset), size);
+  MemoryRegion reserved(0, 0);  // Owned by this segment.
+  VirtualMemory* memory = new VirtualMemory(region, region, reserved);
+  ASSERT(!memory->vm_owns_region());
+  return memory;
+}
+
 }  // namespace dart
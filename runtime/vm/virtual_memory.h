@@ -53,6 +53,26 @@ class VirtualMemory {
                                         bool is_executable,
                                         const char* name);
 
+  // Size and alignment of the regions the heap reserves when it is backed by
+  // transparent huge pages.
+  static const intptr_t kHugePageSize = 2 * MB;
+
+  // Asks the OS to back this segment with transparent huge pages. Only a hint;
+  // does nothing where unsupported.
+  void AdviseHugePages();
+
+  // Returns the NUMA node of the CPU the calling thread runs on, or -1 if
+  // unknown.
+  static intptr_t CurrentNumaNode();
+
+  // Asks the OS to place the pages of this segment on the given NUMA node when
+  // they are first touched. Only a hint; does nothing where unsupported.
+  void BindToNumaNode(intptr_t node);
+
+  // Returns a view of part of this segment. The view does not own its memory,
+  // which stays reserved until this segment is deleted.
+  VirtualMemory* Slice(intptr_t offset, intptr_t size) const;
+
   static intptr_t PageSize() {
     ASSERT(page_size_ != 0);
     ASSERT(Utils::IsPowerOfTwo(page_size_));
@@ -237,6 +237,49 @@ void VirtualMemory::FreeSubSegment(void* address,
   unmap(start, start + size);
 }
 
+void VirtualMemory::AdviseHugePages() {
+#if defined(HOST_OS_LINUX) && defined(MADV_HUGEPAGE)
+  if (madvise(address(), size(), MADV_HUGEPAGE) != 0) {
+    LOG_INFO("madvise(0x%" Px ", 0x%" Px ", MADV_HUGEPAGE) failed: %d\n",
+             start(), size(), errno);
+    return;
+  }
+  LOG_INFO("madvise(0x%" Px ", 0x%" Px ", MADV_HUGEPAGE) ok\n", start(),
+           size());
+#endif  // defined(HOST_OS_LINUX) && defined(MADV_HUGEPAGE)
+}
+
+intptr_t VirtualMemory::CurrentNumaNode() {
+#if defined(HOST_OS_LINUX) && defined(__NR_getcpu)
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(__NR_getcpu, &cpu, &node, NULL) == 0) {
+    return node;
+  }
+#endif  // defined(HOST_OS_LINUX) && defined(__NR_getcpu)
+  return -1;
+}
+
+void VirtualMemory::BindToNumaNode(intptr_t node) {
+#if defined(HOST_OS_LINUX) && defined(__NR_mbind)
+  // Avoid depending on libnuma for <numaif.h>.
+  const int kMpolPreferred = 1;
+  uword node_mask = 0;
+  if ((node < 0) || (node >= kBitsPerWord)) {
+    return;
+  }
+  node_mask = static_cast<uword>(1) << node;
+  // The kernel reads maxnode - 1 bits of the mask.
+  if (syscall(__NR_mbind, address(), size(), kMpolPreferred, &node_mask,
+              kBitsPerWord + 1, 0) != 0) {
+    LOG_INFO("mbind(0x%" Px ", 0x%" Px ", %" Pd ") failed: %d\n", start(),
+             size(), node, errno);
+    return;
+  }
+  LOG_INFO("mbind(0x%" Px ", 0x%" Px ", %" Pd ") ok\n", start(), size(), node);
+#endif  // defined(HOST_OS_LINUX) && defined(__NR_mbind)
+}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 #if defined(TARGET_ARCH_DBC)
   RELEASE_ASSERT((mode != kReadExecute) && (mode != kReadWriteExecute));
@@ -76,6 +76,18 @@ void VirtualMemory::FreeSubSegment(void* address,
   }
 }
 
+void VirtualMemory::AdviseHugePages() {
+  // Not supported.
+}
+
+intptr_t VirtualMemory::CurrentNumaNode() {
+  return -1;
+}
+
+void VirtualMemory::BindToNumaNode(intptr_t node) {
+  // Not supported.
+}
+
 void VirtualMemory::Protect(void* address, intptr_t size, Protection mode) {
 #if defined(DEBUG)
   Thread* thread = Thread::Current();
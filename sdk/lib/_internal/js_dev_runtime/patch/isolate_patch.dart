@@ -117,6 +117,9 @@ abstract class TransferableTypedData {
   @patch
   factory TransferableTypedData.fromList(List<TypedData> list) =>
       _unsupported();
+
+  @patch
+  factory TransferableTypedData.detach(TypedData data) => _unsupported();
 }
 
 @NoReifyGeneric()
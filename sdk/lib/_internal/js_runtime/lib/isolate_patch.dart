@@ -149,4 +149,9 @@ abstract class TransferableTypedData {
   factory TransferableTypedData.fromList(List<TypedData> list) {
     throw new UnsupportedError('TransferableTypedData.fromList');
   }
+
+  @patch
+  factory TransferableTypedData.detach(TypedData data) {
+    throw new UnsupportedError('TransferableTypedData.detach');
+  }
 }
@@ -778,6 +778,15 @@ abstract class TransferableTypedData {
    */
   external factory TransferableTypedData.fromList(List<TypedData> list);
 
+  /**
+   * Creates a new [TransferableTypedData] holding a copy of the bytes of
+   * [data].
+   *
+   * [data] is left unchanged and can still be used afterwards.
+   */
+  @Since("2.5")
+  external factory TransferableTypedData.detach(TypedData data);
+
   /**
    * Creates a new [ByteBuffer] containing the bytes stored in this [TransferableTypedData].
    *
@@ -8,6 +8,8 @@
 // VMOptions=--short_socket_read
 // VMOptions=--short_socket_write
 // VMOptions=--short_socket_read --short_socket_write
+// VMOptions=--event_handler_threads=3
+// VMOptions=--use_io_uring
 
 library ServerTest;
 
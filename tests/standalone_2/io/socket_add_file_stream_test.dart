@@ -0,0 +1,66 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--short_socket_write
+// VMOptions=--short_socket_read --short_socket_write
+
+// Test that ranges of files added to a socket with addStream(openRead()),
+// which are sent without reading them into Dart, arrive in order with the
+// data added before and after them.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int fileLength = 1024 * 1024 + 17;
+
+Future sendRanges(Socket socket, File file) async {
+  socket.add([1, 2, 3]);
+  await socket.addStream(file.openRead());
+  await socket.addStream(file.openRead(100, 200));
+  socket.add([4, 5]);
+  // Empty ranges and ranges beyond the end of the file.
+  await socket.addStream(file.openRead(7, 7));
+  await socket.addStream(file.openRead(fileLength - 10, fileLength + 10));
+  await socket.addStream(file.openRead(fileLength + 10));
+  await socket.addStream(file.openRead(fileLength ~/ 2));
+  await socket.close();
+}
+
+List<int> expectedBytes(Uint8List content) {
+  var builder = new BytesBuilder();
+  builder.add([1, 2, 3]);
+  builder.add(content);
+  builder.add(content.sublist(100, 200));
+  builder.add([4, 5]);
+  builder.add(content.sublist(fileLength - 10));
+  builder.add(content.sublist(fileLength ~/ 2));
+  return builder.takeBytes();
+}
+
+main() async {
+  asyncStart();
+  var directory = Directory.systemTemp.createTempSync('dart_socket_file');
+  var file = new File("${directory.path}/file");
+  var content = new Uint8List(fileLength);
+  for (int i = 0; i < fileLength; i++) {
+    content[i] = (i * 31) & 0xff;
+  }
+  file.writeAsBytesSync(content);
+
+  var server = await ServerSocket.bind("127.0.0.1", 0);
+  server.listen((socket) => sendRanges(socket, file));
+  var socket = await Socket.connect("127.0.0.1", server.port);
+  var received = new BytesBuilder();
+  await socket.listen(received.add).asFuture();
+  Expect.listEquals(expectedBytes(content), received.takeBytes());
+  socket.destroy();
+  await server.close();
+  directory.deleteSync(recursive: true);
+  asyncEnd();
+}
@@ -3,6 +3,11 @@
 // BSD-style license that can be found in the LICENSE file.
 //
 // Test creating a large number of socket connections.
+//
+// VMOptions=
+// VMOptions=--event_handler_threads=4
+// VMOptions=--use_io_uring
+// VMOptions=--use_io_uring --event_handler_threads=2
 library ServerTest;
 
 import "package:expect/expect.dart";
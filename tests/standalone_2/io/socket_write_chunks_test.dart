@@ -0,0 +1,73 @@
+// Copyright (c) 2019, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// VMOptions=
+// VMOptions=--short_socket_write
+// VMOptions=--short_socket_read --short_socket_write
+
+// Test that many chunks of different kinds of lists added to a socket while
+// it is not writable arrive in order. The chunks are queued and written
+// together with vectored writes.
+
+import "dart:async";
+import "dart:io";
+import "dart:typed_data";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const int chunkCount = 2000;
+
+List<List<int>> makeChunks() {
+  var chunks = <List<int>>[];
+  var shared = new Uint8List.fromList(new List<int>.generate(100, (i) => i));
+  for (int i = 0; i < chunkCount; i++) {
+    switch (i % 5) {
+      case 0:
+        chunks.add(new Uint8List(i % 4096)..fillRange(0, i % 4096, i & 0xff));
+        break;
+      case 1:
+        chunks.add(new List<int>.filled(i % 17, i & 0x7f));
+        break;
+      case 2:
+        chunks.add(new Int8List.fromList([i & 0x7f, -(i & 0x7f)]));
+        break;
+      case 3:
+        // The same list is queued several times.
+        chunks.add(shared);
+        break;
+      case 4:
+        chunks.add(const <int>[]);
+        break;
+    }
+  }
+  return chunks;
+}
+
+void main() {
+  asyncStart();
+  var chunks = makeChunks();
+  var expected = new BytesBuilder();
+  for (var chunk in chunks) {
+    expected.add(chunk.map((b) => b & 0xff).toList());
+  }
+  ServerSocket.bind("127.0.0.1", 0).then((server) {
+    server.listen((socket) {
+      chunks.forEach(socket.add);
+      socket.close();
+    });
+    Socket.connect("127.0.0.1", server.port).then((socket) {
+      var received = new BytesBuilder();
+      var subscription = socket.listen(received.add, onDone: () {
+        Expect.listEquals(expected.takeBytes(), received.takeBytes());
+        socket.destroy();
+        server.close();
+        asyncEnd();
+      });
+      // Let the data queue up on the server side before reading it.
+      subscription.pause();
+      new Timer(const Duration(milliseconds: 100), subscription.resume);
+    });
+  });
+}